@@ -2390,6 +2390,19 @@ size_t Catalog::getTotalMemorySizeForDictionariesForDatabase() const {
   return ret;
 }
 
+std::map<int32_t, DictionaryQueryCache::Stats> Catalog::getDictionaryQueryCacheStats()
+    const {
+  cat_read_lock read_lock(this);
+  std::map<int32_t, DictionaryQueryCache::Stats> stats_by_dict_id;
+  for (auto const& [dict_ref, dict_descriptor] : dictDescriptorMapByRef_) {
+    if (dict_ref.dbId == currentDB_.dbId && dict_descriptor->stringDict) {
+      stats_by_dict_id.emplace(dict_ref.dictId,
+                               dict_descriptor->stringDict->getQueryCacheStats());
+    }
+  }
+  return stats_by_dict_id;
+}
+
 void Catalog::alterColumnTypeTransactional(const ColumnDescriptor& cd) {
   cat_write_lock write_lock(this);
   cat_sqlite_lock sqlite_lock(this);
@@ -6507,6 +6520,7 @@ void Catalog::initializeSystemTables() {
   initializeMemorySummarySystemTable();
   initializeMemoryDetailsSystemTable();
   initializeStorageDetailsSystemTable();
+  initializeStringDictionaryCachesSystemTable();
   initializeExecutorResourcePoolSummarySystemTable();
   initializeMLModelMetadataSystemTable();
 
@@ -6688,7 +6702,26 @@ void Catalog::initializeStorageDetailsSystemTable() {
                             {"total_metadata_file_size", {kBIGINT}},
                             {"total_metadata_page_count", {kBIGINT}},
                             {"total_free_metadata_page_count", {kBIGINT}},
-                            {"total_dictionary_data_file_size", {kBIGINT}}},
+                            {"total_dictionary_data_file_size", {kBIGINT}},
+                            {"dictionary_compression_ratio", {kDOUBLE}}},
+                           true);
+  recreateSystemTableIfUpdated(foreign_table, columns);
+}
+
+void Catalog::initializeStringDictionaryCachesSystemTable() {
+  auto [foreign_table, columns] =
+      getSystemTableSchema(STRING_DICTIONARY_CACHES_SYS_TABLE_NAME,
+                           MEMORY_STATS_SERVER_NAME,
+                           {{"node", get_encoded_text_type()},
+                            {"database_id", {kINT}},
+                            {"database_name", get_encoded_text_type()},
+                            {"dictionary_id", {kINT}},
+                            {"entry_count", {kBIGINT}},
+                            {"cache_size", {kBIGINT}},
+                            {"max_cache_size", {kBIGINT}},
+                            {"hit_count", {kBIGINT}},
+                            {"miss_count", {kBIGINT}},
+                            {"eviction_count", {kBIGINT}}},
                            true);
   recreateSystemTableIfUpdated(foreign_table, columns);
 }
@@ -119,6 +119,8 @@ static constexpr const char* ROLE_ASSIGNMENTS_SYS_TABLE_NAME{"role_assignments"}
 static constexpr const char* MEMORY_SUMMARY_SYS_TABLE_NAME{"memory_summary"};
 static constexpr const char* MEMORY_DETAILS_SYS_TABLE_NAME{"memory_details"};
 static constexpr const char* STORAGE_DETAILS_SYS_TABLE_NAME{"storage_details"};
+static constexpr const char* STRING_DICTIONARY_CACHES_SYS_TABLE_NAME{
+    "string_dictionary_caches"};
 static constexpr const char* EXECUTOR_RESOURCE_POOL_SUMMARY_SYS_TABLE_NAME{
     "executor_pool_summary"};
 static constexpr const char* ML_MODEL_METADATA_SYS_TABLE_NAME{"ml_models"};
@@ -329,6 +331,9 @@ class Catalog final {
   void getDictionary(const ColumnDescriptor& cd,
                      std::map<int, StringDictionary*>& stringDicts);
   size_t getTotalMemorySizeForDictionariesForDatabase() const;
+  // Query cache stats of the dictionaries of this database that are loaded in memory,
+  // keyed by dictionary id
+  std::map<int32_t, DictionaryQueryCache::Stats> getDictionaryQueryCacheStats() const;
 
   DictRef addDictionaryTransactional(ColumnDescriptor& cd);
   void delDictionaryTransactional(const ColumnDescriptor& cd);
@@ -841,6 +846,7 @@ class Catalog final {
   void initializeMemorySummarySystemTable();
   void initializeMemoryDetailsSystemTable();
   void initializeStorageDetailsSystemTable();
+  void initializeStringDictionaryCachesSystemTable();
   void initializeExecutorResourcePoolSummarySystemTable();
   void initializeMLModelMetadataSystemTable();
   void initializeServerLogsSystemTables();
@@ -192,12 +192,62 @@ void populate_import_buffers_for_memory_details(
     }
   }
 }
+
+void populate_import_buffers_for_string_dictionary_caches(
+    const std::vector<DictionaryCacheDetails>& dictionary_cache_details,
+    std::map<std::string, import_export::TypedImportBuffer*>& import_buffers) {
+  for (const auto& cache_detail : dictionary_cache_details) {
+    const auto& cache_stats = cache_detail.cache_stats;
+    set_node_name(import_buffers);
+    if (import_buffers.find("database_id") != import_buffers.end()) {
+      import_buffers["database_id"]->addInt(cache_detail.database_id);
+    }
+    if (import_buffers.find("database_name") != import_buffers.end()) {
+      import_buffers["database_name"]->addDictStringWithTruncation(
+          get_db_name(cache_detail.database_id));
+    }
+    if (import_buffers.find("dictionary_id") != import_buffers.end()) {
+      import_buffers["dictionary_id"]->addInt(cache_detail.dictionary_id);
+    }
+    if (import_buffers.find("entry_count") != import_buffers.end()) {
+      import_buffers["entry_count"]->addBigint(cache_stats.entry_count);
+    }
+    if (import_buffers.find("cache_size") != import_buffers.end()) {
+      import_buffers["cache_size"]->addBigint(cache_stats.size_in_bytes);
+    }
+    if (import_buffers.find("max_cache_size") != import_buffers.end()) {
+      import_buffers["max_cache_size"]->addBigint(cache_stats.max_size_in_bytes);
+    }
+    if (import_buffers.find("hit_count") != import_buffers.end()) {
+      import_buffers["hit_count"]->addBigint(cache_stats.hit_count);
+    }
+    if (import_buffers.find("miss_count") != import_buffers.end()) {
+      import_buffers["miss_count"]->addBigint(cache_stats.miss_count);
+    }
+    if (import_buffers.find("eviction_count") != import_buffers.end()) {
+      import_buffers["eviction_count"]->addBigint(cache_stats.eviction_count);
+    }
+  }
+}
 }  // namespace
 
 void InternalMemoryStatsDataWrapper::initializeObjectsForTable(
     const std::string& table_name) {
   memory_info_by_device_type_.clear();
+  dictionary_cache_details_.clear();
   row_count_ = 0;
+  if (foreign_table_->tableName ==
+      Catalog_Namespace::STRING_DICTIONARY_CACHES_SYS_TABLE_NAME) {
+    for (const auto catalog :
+         Catalog_Namespace::SysCatalog::instance().getCatalogsForAllDbs()) {
+      const auto db_id = catalog->getDatabaseId();
+      for (const auto& [dict_id, stats] : catalog->getDictionaryQueryCacheStats()) {
+        dictionary_cache_details_.emplace_back(db_id, dict_id, stats);
+      }
+    }
+    row_count_ = dictionary_cache_details_.size();
+    return;
+  }
   const auto& data_mgr = Catalog_Namespace::SysCatalog::instance().getDataMgr();
   // DataMgr::getMemoryInfoUnlocked() is used here because a lock on buffer_access_mutex_
   // is already acquired in DataMgr::getChunkMetadataVecForKeyPrefix()
@@ -240,6 +290,10 @@ void InternalMemoryStatsDataWrapper::populateChunkBuffersForTable(
              Catalog_Namespace::MEMORY_DETAILS_SYS_TABLE_NAME) {
     populate_import_buffers_for_memory_details(memory_info_by_device_type_,
                                                import_buffers);
+  } else if (foreign_table_->tableName ==
+             Catalog_Namespace::STRING_DICTIONARY_CACHES_SYS_TABLE_NAME) {
+    populate_import_buffers_for_string_dictionary_caches(dictionary_cache_details_,
+                                                         import_buffers);
   } else {
     UNREACHABLE() << "Unexpected table name: " << foreign_table_->tableName;
   }
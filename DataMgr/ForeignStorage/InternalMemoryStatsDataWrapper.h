@@ -23,8 +23,21 @@
 #include "DataMgr/Chunk/Chunk.h"
 #include "ForeignDataWrapper.h"
 #include "InternalSystemDataWrapper.h"
+#include "StringDictionary/DictionaryQueryCache.h"
 
 namespace foreign_storage {
+struct DictionaryCacheDetails {
+  int32_t database_id;
+  int32_t dictionary_id;
+  DictionaryQueryCache::Stats cache_stats;
+
+  DictionaryCacheDetails(int32_t database_id,
+                         int32_t dictionary_id,
+                         const DictionaryQueryCache::Stats& cache_stats)
+      : database_id(database_id)
+      , dictionary_id(dictionary_id)
+      , cache_stats(cache_stats) {}
+};
 
 class InternalMemoryStatsDataWrapper : public InternalSystemDataWrapper {
  public:
@@ -40,5 +53,6 @@ class InternalMemoryStatsDataWrapper : public InternalSystemDataWrapper {
       std::map<std::string, import_export::TypedImportBuffer*>& import_buffers) override;
 
   std::map<std::string, std::vector<MemoryInfo>> memory_info_by_device_type_;
+  std::vector<DictionaryCacheDetails> dictionary_cache_details_;
 };
 }  // namespace foreign_storage
@@ -20,6 +20,7 @@
 
 #include "Catalog/SysCatalog.h"
 #include "ImportExport/Importer.h"
+#include "StringDictionary/StringPayloadCompressor.h"
 
 namespace foreign_storage {
 InternalStorageStatsDataWrapper::InternalStorageStatsDataWrapper()
@@ -117,6 +118,14 @@ void populate_import_buffers_for_storage_details(
       import_buffers["total_dictionary_data_file_size"]->addBigint(
           storage_detail.total_dictionary_data_file_size);
     }
+    if (import_buffers.find("dictionary_compression_ratio") != import_buffers.end()) {
+      auto import_buffer = import_buffers["dictionary_compression_ratio"];
+      if (storage_detail.dictionary_compression_ratio.has_value()) {
+        import_buffer->addDouble(storage_detail.dictionary_compression_ratio.value());
+      } else {
+        set_null(import_buffer);
+      }
+    }
   }
 }
 }  // namespace
@@ -135,6 +144,8 @@ void InternalStorageStatsDataWrapper::initializeObjectsForTable(
       for (const auto& [table_id, shard_id] :
            catalog->getAllPersistedTableAndShardIds()) {
         uint64_t total_dictionary_file_size{0};
+        StringPayloadCompressor::Stats payload_compression_stats;
+        bool has_compressed_dictionary{false};
         auto logical_table_id = catalog->getLogicalTableId(table_id);
         for (const auto& dict_path :
              catalog->getTableDictDirectoryPaths(logical_table_id)) {
@@ -149,12 +160,26 @@ void InternalStorageStatsDataWrapper::initializeObjectsForTable(
             CHECK(file_entry.is_regular_file());
             total_dictionary_file_size += static_cast<uint64_t>(file_entry.file_size());
           }
+          const auto symbols_path =
+              std::filesystem::path(dict_path) / StringPayloadCompressor::kSymbolsFileName;
+          if (const auto stats =
+                  StringPayloadCompressor::readStatsFromFile(symbols_path.string())) {
+            has_compressed_dictionary = true;
+            payload_compression_stats.raw_payload_bytes += stats->raw_payload_bytes;
+            payload_compression_stats.encoded_payload_bytes +=
+                stats->encoded_payload_bytes;
+          }
+        }
+        std::optional<double> dictionary_compression_ratio;
+        if (has_compressed_dictionary) {
+          dictionary_compression_ratio = payload_compression_stats.compressionRatio();
         }
         auto db_id = catalog->getDatabaseId();
         storage_details_.emplace_back(db_id,
                                       logical_table_id,
                                       shard_id,
                                       total_dictionary_file_size,
+                                      dictionary_compression_ratio,
                                       global_file_mgr->getStorageStats(db_id, table_id));
       }
     }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "DataMgr/FileMgr/FileMgr.h"
@@ -28,17 +29,21 @@ struct StorageDetails {
   int32_t table_id;
   int32_t shard_id;
   uint64_t total_dictionary_data_file_size;
+  // Only set for tables with at least one compressed dictionary payload
+  std::optional<double> dictionary_compression_ratio;
   File_Namespace::StorageStats storage_stats;
 
   StorageDetails(int32_t database_id,
                  int32_t table_id,
                  int32_t shard_id,
                  int64_t total_dictionary_data_file_size,
+                 std::optional<double> dictionary_compression_ratio,
                  File_Namespace::StorageStats storage_stats)
       : database_id(database_id)
       , table_id(table_id)
       , shard_id(shard_id)
       , total_dictionary_data_file_size(total_dictionary_data_file_size)
+      , dictionary_compression_ratio(dictionary_compression_ratio)
       , storage_stats(storage_stats) {}
 };
 
@@ -4687,7 +4687,10 @@ void InsertIntoTableAsSelectStmt::execute(const Catalog_Namespace::SessionInfo&
       catalog.name(), select_query_, query_state->createQueryStateProxy(), table_name_);
   const TableDescriptor* td = catalog.getMetadataForTable(table_name_);
 
-  Executor::clearExternalCaches(true, td, catalog.getCurrentDB().dbId);
+  Executor::clearExternalCachesForAppend(td, catalog.getCurrentDB().dbId);
+  ScopeGuard clear_caches_after_append = [td] {
+    Executor::clearExternalCachesAfterAppend(td);
+  };
 
   try {
     populateData(query_state->createQueryStateProxy(), td, true, false);
@@ -5807,8 +5810,11 @@ void CopyTableStmt::execute(
     }
 
     // invalidate cached item
-    Executor::clearExternalCaches(true, td, catalog.getCurrentDB().dbId);
+    Executor::clearExternalCachesForAppend(td, catalog.getCurrentDB().dbId);
   }
+  ScopeGuard clear_caches_after_append = [td] {
+    Executor::clearExternalCachesAfterAppend(td);
+  };
 
   import_export::CopyParams copy_params;
   std::vector<std::string> warnings;
@@ -55,6 +55,21 @@ bool CodeCacheAccessor<CompilationContext>::put(const CodeCacheKey& key,
   return true;
 }
 
+template <typename CompilationContext>
+bool CodeCacheAccessor<CompilationContext>::replace(
+    const CodeCacheKey& key,
+    CodeCacheVal<CompilationContext>& value) {
+  std::lock_guard<std::mutex> lock(code_cache_mutex_);
+  auto cached_code = code_cache_.get(key);
+  if (!cached_code || !cached_code->get()) {
+    return false;
+  }
+  VLOG(1) << name_ << ": Replace cached compiled kernel";
+  overwrite_count_++;
+  *cached_code = value;
+  return true;
+}
+
 template <typename CompilationContext>
 CodeCacheVal<CompilationContext>* CodeCacheAccessor<CompilationContext>::get_or_wait(
     const CodeCacheKey& key) {
@@ -62,6 +62,9 @@ class CodeCacheAccessor {
   // TODO: replace get_value/put with get_or_wait/reset workflow.
   CodeCacheVal<CompilationContext> get_value(const CodeCacheKey& key);
   bool put(const CodeCacheKey& key, CodeCacheVal<CompilationContext>& value);
+  // Swaps in a new code for a key which is still cached, e.g. an optimized kernel
+  // replacing a quickly compiled one. Returns false if the key has been evicted.
+  bool replace(const CodeCacheKey& key, CodeCacheVal<CompilationContext>& value);
 
   // get_or_wait and reset/erase should be used in pair.
   CodeCacheVal<CompilationContext>* get_or_wait(const CodeCacheKey& key);
@@ -87,6 +87,10 @@ class CodeGenerator {
       const std::unordered_set<llvm::Function*>& live_funcs,
       const CompilationOptions& co);
 
+  // Blocks until all the optimized kernels queued by tiered CPU compilation so far have
+  // been compiled and swapped into the code cache.
+  static void waitForTieredCPUCompilation();
+
   static std::string generatePTX(const std::string& cuda_llir,
                                  llvm::TargetMachine* nvptx_target_machine,
                                  llvm::LLVMContext& context);
@@ -127,6 +131,10 @@ class CodeGenerator {
                               std::vector<Analyzer::Expr*>& deferred_quals,
                               const PlanState::HoistedFiltersSet& hoisted_quals);
 
+  // Fraction of the rows expected to pass the filters of the execution unit, derived
+  // from the likelihood of the quals; the default likelihood if none is known
+  static float getExpectedSelectivity(const RelAlgExecutionUnit& ra_exe_unit);
+
   struct ExecutorRequired : public std::runtime_error {
     ExecutorRequired()
         : std::runtime_error("Executor required to generate this expression") {}
@@ -18,6 +18,7 @@
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
 #include <memory>
@@ -65,6 +66,13 @@ class CpuCompilationContext : public CompilationContext {
   CpuCompilationContext(ExecutionEngineWrapper&& execution_engine)
       : execution_engine_(std::move(execution_engine)) {}
 
+  // Takes ownership of the context the compiled module lives in, for kernels compiled
+  // outside of the executor context (e.g. the optimized tier of tiered compilation).
+  CpuCompilationContext(ExecutionEngineWrapper&& execution_engine,
+                        std::unique_ptr<llvm::LLVMContext> llvm_context)
+      : llvm_context_(std::move(llvm_context))
+      , execution_engine_(std::move(execution_engine)) {}
+
   template <typename... Ts>
   void call(Ts... args) const {
     reinterpret_cast<void (*)(Ts...)>(func_)(args...);
@@ -97,5 +105,7 @@ class CpuCompilationContext : public CompilationContext {
  private:
   void* func_{nullptr};
   std::string name_;
+  // must outlive the execution engine
+  std::unique_ptr<llvm::LLVMContext> llvm_context_;
   ExecutionEngineWrapper execution_engine_;
 };
@@ -22,7 +22,9 @@
 
 extern bool g_from_table_reordering;
 
-enum class ExecutorOptLevel { Default, ReductionJIT };
+// QuickJIT is the first tier of tiered CPU compilation: minimal IR passes and no
+// backend optimization, used until the optimized kernel is ready
+enum class ExecutorOptLevel { Default, ReductionJIT, QuickJIT };
 
 enum class ExecutorExplainType { Default, Optimized };
 
@@ -88,6 +90,7 @@ struct ExecutionOptions {
   size_t max_join_hash_table_size = std::numeric_limits<size_t>::max();
   ExecutorType executor_type = ExecutorType::Native;
   std::vector<size_t> outer_fragment_indices{};
+  bool is_intermediate_step{false};  // result feeds a later step of the same query
 
   static ExecutionOptions defaults() {
     return ExecutionOptions{/*output_columnar_hint=*/false,
@@ -93,6 +93,9 @@ inline int64_t count_distinct_set_size(
     }
     return bitmap_set_size(set_vals, count_distinct_desc.bitmapSizeBytes());
   }
+  if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll) {
+    return reinterpret_cast<SparseHll*>(set_handle)->cardinality();
+  }
   CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::UnorderedSet);
   return reinterpret_cast<CountDistinctSet*>(set_handle)->size();
 }
@@ -141,6 +144,12 @@ inline void count_distinct_set_union(
                                       : old_count_distinct_desc.bitmapPaddedSizeBytes();
       bitmap_set_union(new_set, old_set, bitmap_byte_sz);
     }
+  } else if (new_count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll) {
+    CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll);
+    auto old_set = reinterpret_cast<SparseHll*>(old_set_handle);
+    auto new_set = reinterpret_cast<SparseHll*>(new_set_handle);
+    new_set->merge(*old_set);
+    *old_set = *new_set;
   } else {
     CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::UnorderedSet);
     auto old_set = reinterpret_cast<CountDistinctSet*>(old_set_handle);
@@ -44,6 +44,7 @@ enum CacheItemType {
   BBOX_INTERSECT_AUTO_TUNER_PARAM,  // Bounding box intersect auto tuner's params
   QUERY_RESULTSET,                  // query resultset
   CHUNK_METADATA,                   // query resultset's chunk metadata
+  STRING_DICT_TRANSLATION_MAP,      // id translation between two string dictionaries
   // TODO (yoonmin): support the following items for recycling
   // COUNTALL_CARD_EST,  Cardinality of query result
   // NDV_CARD_EST,       # Non-distinct value
@@ -60,7 +61,8 @@ inline std::ostream& operator<<(std::ostream& os, CacheItemType const item_type)
       "Baseline Join Hashtable's Approximated Cardinality",
       "Bounding Box Intersect Join Hashtable's Auto Tuner's Parameters",
       "Query ResultSet",
-      "Chunk Metadata"};
+      "Chunk Metadata",
+      "String Dictionary Translation Map"};
   static_assert(sizeof(cache_item_type_str) / sizeof(*cache_item_type_str) ==
                 NUM_CACHE_ITEM_TYPE);
   return os << cache_item_type_str[item_type];
@@ -513,6 +515,18 @@ class DataRecycler {
     }
   }
 
+  // marks a single cached item as dirty, i.e., when it turns out to be stale, so that
+  // the next lookup drops it and a recomputed item can take its place
+  void markCachedItemAsDirtyByKey(QueryPlanHash key,
+                                  CacheItemType item_type,
+                                  DeviceIdentifier device_identifier) {
+    std::lock_guard<std::mutex> lock(cache_lock_);
+    auto container = getCachedItemContainer(item_type, device_identifier);
+    if (container) {
+      markCachedItemAsDirtyImpl(key, *container);
+    }
+  }
+
   bool isCachedItemDirty(QueryPlanHash key, CachedItemContainer& m) const {
     auto candidate_it = std::find_if(
         m.begin(),
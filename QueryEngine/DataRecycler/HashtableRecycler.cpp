@@ -289,6 +289,37 @@ void HashtableRecycler::markCachedItemAsDirty(size_t table_key,
   removeCachedHashtableBuiltFromSyntheticTable(item_type, device_identifier, lock);
 }
 
+std::unordered_set<QueryPlanHash> HashtableRecycler::markCachedItemAsDirtyOnAppend(
+    size_t table_key,
+    size_t num_fragments,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier) {
+  std::unordered_set<QueryPlanHash> dirty_keys;
+  if (!g_enable_data_recycler || !g_use_hashtable_cache) {
+    return dirty_keys;
+  }
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto key_set_it = table_key_to_query_plan_dag_map_.find(table_key);
+  if (key_set_it == table_key_to_query_plan_dag_map_.end()) {
+    return dirty_keys;
+  }
+  auto hashtable_cache = getCachedItemContainer(item_type, device_identifier);
+  for (auto& cached_item : *hashtable_cache) {
+    // an extendable item built from fewer fragments than the table now has is never
+    // looked up again, since its cache key hashes the fragments it was built from
+    if (key_set_it->second.count(cached_item.key) &&
+        !(cached_item.meta_info && cached_item.meta_info->extendable_on_append &&
+          cached_item.meta_info->num_fragments == num_fragments)) {
+      cached_item.setDirty();
+      dirty_keys.insert(cached_item.key);
+    }
+  }
+  // unlike `markCachedItemAsDirty`, we keep the mapping between the table_key and its
+  // hashed query plan dags since the extendable items still have to be invalidated when
+  // the table gets updated or rows get deleted from it
+  return dirty_keys;
+}
+
 void HashtableRecycler::removeCachedHashtableBuiltFromSyntheticTable(
     CacheItemType item_type,
     DeviceIdentifier device_identifier,
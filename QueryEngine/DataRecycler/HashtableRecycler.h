@@ -29,9 +29,17 @@ struct BoundingBoxIntersectMetaInfo {
 struct HashtableCacheMetaInfo {
   std::optional<BoundingBoxIntersectMetaInfo> bbox_intersect_meta_info;
   std::optional<RegisteredQueryHint> registered_query_hint;
+  // whether the cached hash table is extended with rows appended to its input table
+  // instead of being invalidated by the append, and the number of fragments it was built
+  // from (an append opening a new fragment changes its cache key)
+  bool extendable_on_append;
+  size_t num_fragments;
 
   HashtableCacheMetaInfo()
-      : bbox_intersect_meta_info(std::nullopt), registered_query_hint(std::nullopt){};
+      : bbox_intersect_meta_info(std::nullopt)
+      , registered_query_hint(std::nullopt)
+      , extendable_on_append(false)
+      , num_fragments(0){};
 };
 
 struct HashtableAccessPathInfo {
@@ -84,6 +92,15 @@ class HashtableRecycler
                              CacheItemType item_type,
                              DeviceIdentifier device_identifier) override;
 
+  // marks cached items built from the given table as dirty unless they are extendable
+  // on append and were built from its current `num_fragments` fragments, and returns
+  // their keys
+  std::unordered_set<QueryPlanHash> markCachedItemAsDirtyOnAppend(
+      size_t table_key,
+      size_t num_fragments,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier);
+
   std::string toString() const override;
 
   bool checkHashtableForBoundingBoxIntersectBucketCompatability(
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringDictTranslationMapRecycler.h"
+
+extern bool g_is_test_env;
+
+std::shared_ptr<DictionaryTranslationMap>
+StringDictTranslationMapRecycler::getItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::optional<EMPTY_META_INFO> meta_info) {
+  if (!g_enable_data_recycler || !g_use_string_dict_translation_map_cache ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return nullptr;
+  }
+  CHECK_EQ(item_type, CacheItemType::STRING_DICT_TRANSLATION_MAP);
+  CHECK_EQ(device_identifier, STRING_DICT_TRANSLATION_MAP_CACHE_DEVICE_IDENTIFIER);
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto translation_map_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(translation_map_cache);
+  auto candidate_map = getCachedItemWithoutConsideringMetaInfo(
+      key, item_type, device_identifier, *translation_map_cache, lock);
+  if (candidate_map) {
+    CHECK(candidate_map->item_metric);
+    candidate_map->item_metric->incRefCount();
+    VLOG(1) << "[" << item_type << ", "
+            << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+            << "] Get cached item from cache (key: " << key << ")";
+    return candidate_map->cached_item;
+  }
+  return nullptr;
+}
+
+void StringDictTranslationMapRecycler::putItemToCache(
+    QueryPlanHash key,
+    std::shared_ptr<DictionaryTranslationMap> item_ptr,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    size_t item_size,
+    size_t compute_time,
+    std::optional<EMPTY_META_INFO> meta_info) {
+  if (!g_enable_data_recycler || !g_use_string_dict_translation_map_cache ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return;
+  }
+  CHECK_EQ(item_type, CacheItemType::STRING_DICT_TRANSLATION_MAP);
+  CHECK_EQ(device_identifier, STRING_DICT_TRANSLATION_MAP_CACHE_DEVICE_IDENTIFIER);
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  if (hasItemInCache(key, item_type, device_identifier, lock, meta_info)) {
+    // the cached map was either extended in place or replaced, so drop its stale
+    // metric before accounting for the new size
+    removeItemFromCache(key, item_type, device_identifier, lock, meta_info);
+  }
+  auto& metric_tracker = getMetricTracker(item_type);
+  auto cache_status = metric_tracker.canAddItem(device_identifier, item_size);
+  if (cache_status == CacheAvailability::UNAVAILABLE) {
+    LOG(INFO) << "Caching string dictionary translation map fails: map is too large";
+    return;
+  } else if (cache_status == CacheAvailability::AVAILABLE_AFTER_CLEANUP) {
+    auto required_size = metric_tracker.calculateRequiredSpaceForItemAddition(
+        device_identifier, item_size);
+    cleanupCacheForInsertion(item_type, device_identifier, required_size, lock);
+  }
+  auto new_cache_metric_ptr = metric_tracker.putNewCacheItemMetric(
+      key, device_identifier, item_size, compute_time);
+  CHECK_EQ(item_size, new_cache_metric_ptr->getMemSize());
+  VLOG(1) << "[" << item_type << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+          << "] Put item to cache (key: " << key << ")";
+  auto translation_map_cache = getCachedItemContainer(item_type, device_identifier);
+  translation_map_cache->emplace_back(key, item_ptr, new_cache_metric_ptr, meta_info);
+}
+
+std::shared_ptr<const DictionaryTranslationMap>
+StringDictTranslationMapRecycler::getOrAddTranslationMap(
+    const std::shared_ptr<StringDictionary>& source_dict,
+    const std::shared_ptr<StringDictionary>& dest_dict,
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) {
+  if (!g_enable_data_recycler || !g_use_string_dict_translation_map_cache) {
+    return nullptr;
+  }
+  CHECK(source_dict);
+  CHECK(dest_dict);
+  const auto key = getTranslationMapKey(
+      source_dict->getDictKey(), dest_dict->getDictKey(), string_op_infos);
+  constexpr auto item_type = CacheItemType::STRING_DICT_TRANSLATION_MAP;
+  auto translation_map = getItemFromCache(
+      key, item_type, STRING_DICT_TRANSLATION_MAP_CACHE_DEVICE_IDENTIFIER);
+  size_t cached_map_size = 0;
+  if (translation_map && translation_map->isTranslationBetween(
+                             source_dict.get(), dest_dict.get(), string_op_infos)) {
+    cached_map_size = translation_map->getSizeInBytes();
+  } else {
+    // either nothing is cached yet or the cached map outlived one of its dictionaries
+    translation_map = std::make_shared<DictionaryTranslationMap>(
+        source_dict, dest_dict, string_op_infos);
+  }
+  auto ts1 = std::chrono::steady_clock::now();
+  source_dict->updateDictionaryTranslationMap(dest_dict.get(), *translation_map);
+  auto ts2 = std::chrono::steady_clock::now();
+  const auto translation_map_size = translation_map->getSizeInBytes();
+  if (translation_map_size != cached_map_size) {
+    putItemToCache(
+        key,
+        translation_map,
+        item_type,
+        STRING_DICT_TRANSLATION_MAP_CACHE_DEVICE_IDENTIFIER,
+        translation_map_size,
+        std::chrono::duration_cast<std::chrono::milliseconds>(ts2 - ts1).count());
+  }
+  return translation_map;
+}
+
+QueryPlanHash StringDictTranslationMapRecycler::getTranslationMapKey(
+    const shared::StringDictKey& source_dict_key,
+    const shared::StringDictKey& dest_dict_key,
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) {
+  auto key = source_dict_key.hash();
+  boost::hash_combine(key, dest_dict_key.hash());
+  if (!string_op_infos.empty()) {
+    boost::hash_combine(key, DictionaryTranslationMap::getStringOpsKey(string_op_infos));
+  }
+  return key;
+}
+
+bool StringDictTranslationMapRecycler::hasItemInCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<EMPTY_META_INFO> meta_info) const {
+  if (!g_enable_data_recycler || !g_use_string_dict_translation_map_cache ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return false;
+  }
+  auto translation_map_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(translation_map_cache);
+  return std::any_of(
+      translation_map_cache->begin(),
+      translation_map_cache->end(),
+      [&key](const auto& cached_item) { return cached_item.key == key; });
+}
+
+void StringDictTranslationMapRecycler::removeItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<EMPTY_META_INFO> meta_info) {
+  auto& metric_tracker = getMetricTracker(item_type);
+  auto cache_metric = metric_tracker.getCacheItemMetric(key, device_identifier);
+  CHECK(cache_metric);
+  auto translation_map_size = cache_metric->getMemSize();
+  auto translation_map_cache = getCachedItemContainer(item_type, device_identifier);
+  auto filter = [key](auto const& item) { return item.key == key; };
+  auto itr = std::find_if(
+      translation_map_cache->cbegin(), translation_map_cache->cend(), filter);
+  if (itr == translation_map_cache->cend()) {
+    return;
+  }
+  VLOG(1) << "[" << item_type << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+          << "] remove cached item from cache (key: " << key << ")";
+  translation_map_cache->erase(itr);
+  metric_tracker.removeCacheItemMetric(key, device_identifier);
+  metric_tracker.updateCurrentCacheSize(
+      device_identifier, CacheUpdateAction::REMOVE, translation_map_size);
+}
+
+void StringDictTranslationMapRecycler::cleanupCacheForInsertion(
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    size_t required_size,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<EMPTY_META_INFO> meta_info) {
+  // same policy as the hashtable recycler: evict the least important maps (by #
+  // referenced, size and compute time) until the new one fits
+  int elimination_target_offset = 0;
+  size_t removed_size = 0;
+  auto& metric_tracker = getMetricTracker(item_type);
+  auto actual_space_to_free = metric_tracker.getTotalCacheSize() / 2;
+  if (!g_is_test_env && required_size < actual_space_to_free) {
+    required_size = actual_space_to_free;
+  }
+  metric_tracker.sortCacheInfoByQueryMetric(device_identifier);
+  auto cached_item_metrics = metric_tracker.getCacheItemMetrics(device_identifier);
+  sortCacheContainerByQueryMetric(item_type, device_identifier);
+  for (auto& metric : cached_item_metrics) {
+    auto target_size = metric->getMemSize();
+    ++elimination_target_offset;
+    removed_size += target_size;
+    if (removed_size > required_size) {
+      break;
+    }
+  }
+  removeCachedItemFromBeginning(item_type, device_identifier, elimination_target_offset);
+  metric_tracker.removeMetricFromBeginning(device_identifier, elimination_target_offset);
+  metric_tracker.updateCurrentCacheSize(
+      device_identifier, CacheUpdateAction::REMOVE, removed_size);
+}
+
+void StringDictTranslationMapRecycler::clearCache() {
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  constexpr auto item_type = CacheItemType::STRING_DICT_TRANSLATION_MAP;
+  getMetricTracker(item_type).clearCacheMetricTracker();
+  auto translation_map_cache = getCachedItemContainer(
+      item_type, STRING_DICT_TRANSLATION_MAP_CACHE_DEVICE_IDENTIFIER);
+  if (!translation_map_cache->empty()) {
+    VLOG(1) << "[" << item_type << ", "
+            << DataRecyclerUtil::getDeviceIdentifierString(
+                   STRING_DICT_TRANSLATION_MAP_CACHE_DEVICE_IDENTIFIER)
+            << "] clear cache (# items: " << translation_map_cache->size() << ")";
+    translation_map_cache->clear();
+  }
+}
+
+std::string StringDictTranslationMapRecycler::toString() const {
+  constexpr auto item_type = CacheItemType::STRING_DICT_TRANSLATION_MAP;
+  std::ostringstream oss;
+  oss << "A current status of the String Dictionary Translation Map Recycler:\n";
+  auto translation_map_cache = getCachedItemContainer(
+      item_type, STRING_DICT_TRANSLATION_MAP_CACHE_DEVICE_IDENTIFIER);
+  oss << "\t# cached translation maps: " << translation_map_cache->size() << "\n";
+  for (auto& translation_map : *translation_map_cache) {
+    oss << "\t\tMap] " << translation_map.item_metric->toString() << "\n";
+  }
+  oss << "\t" << getMetricTracker(item_type).toString() << "\n";
+  return oss.str();
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "DataRecycler.h"
+#include "StringDictionary/StringDictionary.h"
+
+constexpr DeviceIdentifier STRING_DICT_TRANSLATION_MAP_CACHE_DEVICE_IDENTIFIER =
+    DataRecyclerUtil::CPU_DEVICE_IDENTIFIER;
+
+// keeps id translation maps between pairs of persisted string dictionaries across
+// queries, including the transformed source strings of translations with string ops;
+// a cached map is extended in place as its dictionaries grow, so it is keyed by the
+// dictionary pair and string ops alone and re-accounted whenever its size changes
+class StringDictTranslationMapRecycler
+    : public DataRecycler<std::shared_ptr<DictionaryTranslationMap>, EMPTY_META_INFO> {
+ public:
+  StringDictTranslationMapRecycler()
+      : DataRecycler({CacheItemType::STRING_DICT_TRANSLATION_MAP},
+                     g_string_dict_translation_map_cache_total_bytes,
+                     g_string_dict_translation_map_cache_total_bytes,
+                     0) {}
+
+  std::shared_ptr<DictionaryTranslationMap> getItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) override;
+
+  void putItemToCache(QueryPlanHash key,
+                      std::shared_ptr<DictionaryTranslationMap> item_ptr,
+                      CacheItemType item_type,
+                      DeviceIdentifier device_identifier,
+                      size_t item_size,
+                      size_t compute_time,
+                      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) override;
+
+  // nothing to do with string dictionary translation map recycler
+  void initCache() override {}
+
+  void clearCache() override;
+
+  // cached maps validate their dictionaries on lookup, so there is nothing to mark
+  void markCachedItemAsDirty(size_t table_key,
+                             std::unordered_set<QueryPlanHash>& key_set,
+                             CacheItemType item_type,
+                             DeviceIdentifier device_identifier) override {}
+
+  std::string toString() const override;
+
+  // returns the translation map from source_dict to dest_dict, brought up to date with
+  // the current contents of both, or nullptr if the cache is disabled; a map too large
+  // to be cached is still returned for the current query
+  std::shared_ptr<const DictionaryTranslationMap> getOrAddTranslationMap(
+      const std::shared_ptr<StringDictionary>& source_dict,
+      const std::shared_ptr<StringDictionary>& dest_dict,
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos);
+
+  static QueryPlanHash getTranslationMapKey(
+      const shared::StringDictKey& source_dict_key,
+      const shared::StringDictKey& dest_dict_key,
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos);
+
+ private:
+  bool hasItemInCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) const override;
+
+  void removeItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) override;
+
+  void cleanupCacheForInsertion(
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      size_t required_size,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) override;
+};
@@ -36,7 +36,7 @@ inline size_t bitmap_bits_to_bytes(const size_t bitmap_sz) {
   return bitmap_byte_sz;
 }
 
-enum class CountDistinctImplType { Invalid, Bitmap, UnorderedSet };
+enum class CountDistinctImplType { Invalid, Bitmap, UnorderedSet, SparseHll };
 
 struct CountDistinctDescriptor {
   CountDistinctImplType impl_type_;
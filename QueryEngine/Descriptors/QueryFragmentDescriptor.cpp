@@ -22,6 +22,23 @@
 #include "QueryEngine/Execute.h"
 #include "Shared/misc.h"
 
+namespace {
+
+// An outer fragment can't produce any row if it isn't paired with any fragment of a
+// table it is inner joined with.
+bool has_unpaired_inner_join(const RelAlgExecutionUnit& ra_exe_unit,
+                             const std::vector<std::vector<size_t>>& frag_ids_per_table) {
+  for (size_t j = 1; j < frag_ids_per_table.size(); ++j) {
+    if (frag_ids_per_table[j].empty() && j <= ra_exe_unit.join_quals.size() &&
+        ra_exe_unit.join_quals[j - 1].type == JoinType::INNER) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 QueryFragmentDescriptor::QueryFragmentDescriptor(
     const RelAlgExecutionUnit& ra_exe_unit,
     const std::vector<InputTableInfo>& query_infos,
@@ -186,20 +203,26 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
           FragmentsPerTable{table_key, frag_ids});
 
     } else {
+      std::vector<std::vector<size_t>> frag_ids_per_table;
       for (size_t j = 0; j < ra_exe_unit.input_descs.size(); ++j) {
-        const auto frag_ids =
+        frag_ids_per_table.push_back(
             executor->getTableFragmentIndices(ra_exe_unit,
                                               device_type,
                                               j,
                                               i,
                                               selected_tables_fragments_,
-                                              executor->getInnerTabIdToJoinCond());
+                                              executor->getInnerTabIdToJoinCond()));
+      }
+      if (has_unpaired_inner_join(ra_exe_unit, frag_ids_per_table)) {
+        continue;
+      }
+      for (size_t j = 0; j < ra_exe_unit.input_descs.size(); ++j) {
         const auto& table_key = ra_exe_unit.input_descs[j].getTableKey();
         auto table_frags_it = selected_tables_fragments_.find(table_key);
         CHECK(table_frags_it != selected_tables_fragments_.end());
 
         execution_kernel_desc.fragments.emplace_back(
-            FragmentsPerTable{table_key, frag_ids});
+            FragmentsPerTable{table_key, std::move(frag_ids_per_table[j])});
       }
     }
 
@@ -398,17 +421,24 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
     if (device_type == ExecutorDeviceType::GPU) {
       checkDeviceMemoryUsage(fragment, device_id, num_bytes_for_row);
     }
+    std::vector<std::vector<size_t>> frag_ids_per_table;
     for (size_t j = 0; j < ra_exe_unit.input_descs.size(); ++j) {
-      const auto& table_key = ra_exe_unit.input_descs[j].getTableKey();
-      auto table_frags_it = selected_tables_fragments_.find(table_key);
-      CHECK(table_frags_it != selected_tables_fragments_.end());
-      const auto frag_ids =
+      frag_ids_per_table.push_back(
           executor->getTableFragmentIndices(ra_exe_unit,
                                             device_type,
                                             j,
                                             outer_frag_id,
                                             selected_tables_fragments_,
-                                            inner_table_id_to_join_condition);
+                                            inner_table_id_to_join_condition));
+    }
+    if (has_unpaired_inner_join(ra_exe_unit, frag_ids_per_table)) {
+      continue;
+    }
+    for (size_t j = 0; j < ra_exe_unit.input_descs.size(); ++j) {
+      const auto& table_key = ra_exe_unit.input_descs[j].getTableKey();
+      auto table_frags_it = selected_tables_fragments_.find(table_key);
+      CHECK(table_frags_it != selected_tables_fragments_.end());
+      const auto& frag_ids = frag_ids_per_table[j];
 
       if (execution_kernels_per_device_.find(device_id) ==
           execution_kernels_per_device_.end()) {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <boost/noncopyable.hpp>
 #include <deque>
 #include <list>
@@ -243,7 +244,8 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   const StringDictionaryProxy::IdMap* addStringProxyIntersectionTranslationMap(
       const StringDictionaryProxy* source_proxy,
       const StringDictionaryProxy* dest_proxy,
-      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) {
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+      const DictionaryTranslationMap* persisted_translation_map = nullptr) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     const auto map_key =
         generate_translation_map_key(source_proxy->getDictionary()->getDictKey(),
@@ -254,7 +256,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
       it = str_proxy_intersection_translation_maps_owned_
                .emplace(map_key,
                         source_proxy->buildIntersectionTranslationMapToOtherProxy(
-                            dest_proxy, string_op_infos))
+                            dest_proxy, string_op_infos, persisted_translation_map))
                .first;
     }
     return &it->second;
@@ -276,7 +278,8 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   const StringDictionaryProxy::IdMap* addStringProxyUnionTranslationMap(
       const StringDictionaryProxy* source_proxy,
       StringDictionaryProxy* dest_proxy,
-      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) {
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+      const DictionaryTranslationMap* persisted_translation_map = nullptr) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     const auto map_key =
         generate_translation_map_key(source_proxy->getDictionary()->getDictKey(),
@@ -287,7 +290,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
       it = str_proxy_union_translation_maps_owned_
                .emplace(map_key,
                         source_proxy->buildUnionTranslationMapToOtherProxy(
-                            dest_proxy, string_op_infos))
+                            dest_proxy, string_op_infos, persisted_translation_map))
                .first;
     }
     return &it->second;
@@ -333,7 +336,8 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
       const shared::StringDictKey& dest_dict_id_in,
       const bool with_generation,
       const StringTranslationType translation_map_type,
-      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos);
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+      const DictionaryTranslationMap* persisted_translation_map = nullptr);
 
   const StringDictionaryProxy::TranslationMap<Datum>*
   getOrAddStringProxyNumericTranslationMap(
@@ -428,6 +432,21 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     return &mode_maps_.emplace_back();
   }
 
+  // Allocates the sparse HLL records of all the entries of a group by buffer at once.
+  SparseHll* allocateSparseHlls(const size_t count, const uint32_t bitmap_sz_bits) {
+    std::vector<SparseHll> sparse_hlls;
+    sparse_hlls.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      sparse_hlls.emplace_back(bitmap_sz_bits, &sparse_hll_bytes_);
+    }
+    sparse_hll_bytes_ += count * sizeof(SparseHll);
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return sparse_hll_blocks_.emplace_back(std::move(sparse_hlls)).data();
+  }
+
+  // Bytes taken by the sparse HLL records and their sparse or dense registers.
+  int64_t getSparseHllBytes() const { return sparse_hll_bytes_.load(); }
+
  private:
   int8_t* allocateUnlocked(const size_t num_bytes, const size_t thread_idx) {
     if (g_allow_memory_status_log) {
@@ -470,6 +489,8 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   std::map<std::string, std::shared_ptr<StringOps_Namespace::StringOps>>
       string_ops_owned_;
   std::list<AggMode> mode_maps_;
+  std::list<std::vector<SparseHll>> sparse_hll_blocks_;
+  std::atomic<int64_t> sparse_hll_bytes_{0};
 
   size_t arena_block_size_;  // for cloning
   std::vector<std::unique_ptr<Arena>> allocators_;
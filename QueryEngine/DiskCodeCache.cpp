@@ -0,0 +1,267 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/DiskCodeCache.h"
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SHA1.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+#include "Logger/Logger.h"
+#include "OSDependent/heavyai_path.h"
+
+std::string g_disk_code_cache_dir{""};  // empty disables the disk code cache
+size_t g_disk_code_cache_max_size_in_bytes{size_t(1) << 30};  // 1GB
+
+namespace {
+
+const std::string kModuleIdPrefix{"disk_code_cache:"};
+constexpr size_t kHashLength{40};
+
+std::string sha1_hex(const std::string& str) {
+  const auto digest = llvm::SHA1::hash(llvm::ArrayRef<uint8_t>(
+      reinterpret_cast<const uint8_t*>(str.data()), str.size()));
+  static const char* hex_digits = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(2 * digest.size());
+  for (const auto byte : digest) {
+    hex.push_back(hex_digits[byte >> 4]);
+    hex.push_back(hex_digits[byte & 0xf]);
+  }
+  return hex;
+}
+
+std::string hash_key(const CodeCacheKey& key) {
+  std::string key_str;
+  for (const auto& part : key) {
+    key_str += std::to_string(part.size()) + ':' + part;
+  }
+  return sha1_hex(key_str);
+}
+
+std::string read_file(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+// Object code can only be reused by the build which produced it: it depends on the
+// compiler, on the CPU it was compiled for and on the runtime functions linked into the
+// query module. Any change to the server binary invalidates the cache as well.
+std::string compute_build_id() {
+  std::string build_id_str{LLVM_VERSION_STRING};
+  build_id_str += '|' + llvm::sys::getProcessTriple();
+  build_id_str += '|' + llvm::sys::getHostCPUName().str();
+  build_id_str +=
+      '|' + read_file(heavyai::get_root_abs_path() + "/QueryEngine/RuntimeFunctions.bc");
+  boost::system::error_code ec;
+  const auto exe_path = boost::filesystem::read_symlink("/proc/self/exe", ec);
+  if (!ec) {
+    build_id_str += '|' + exe_path.string();
+    build_id_str += '|' + std::to_string(boost::filesystem::file_size(exe_path, ec));
+    build_id_str +=
+        '|' + std::to_string(boost::filesystem::last_write_time(exe_path, ec));
+  }
+  return sha1_hex(build_id_str);
+}
+
+bool is_build_dir_name(const std::string& name) {
+  return name.size() == kHashLength &&
+         std::all_of(name.begin(), name.end(), [](const char c) {
+           return std::isdigit(c) || (c >= 'a' && c <= 'f');
+         });
+}
+
+}  // namespace
+
+std::mutex DiskCodeCache::instances_mutex_;
+std::map<std::string, std::unique_ptr<DiskCodeCache>> DiskCodeCache::instances_;
+
+DiskCodeCache::DiskCodeCache(const boost::filesystem::path& build_dir)
+    : build_dir_(build_dir) {
+  for (const auto& entry : boost::filesystem::directory_iterator(build_dir_)) {
+    boost::system::error_code ec;
+    const auto entry_size = boost::filesystem::file_size(entry.path(), ec);
+    if (!ec && entry.path().extension() == ".o") {
+      total_size_ += entry_size;
+    }
+  }
+}
+
+DiskCodeCache* DiskCodeCache::getInstance() {
+  if (g_disk_code_cache_dir.empty()) {
+    return nullptr;
+  }
+  // one cache per directory, so that changing the directory at runtime takes effect;
+  // an unusable directory is remembered as a nullptr
+  std::lock_guard<std::mutex> lock(instances_mutex_);
+  const auto [it, inserted] = instances_.try_emplace(g_disk_code_cache_dir);
+  if (!inserted) {
+    return it->second.get();
+  }
+  try {
+    const boost::filesystem::path cache_dir(g_disk_code_cache_dir);
+    const auto build_dir = cache_dir / compute_build_id();
+    boost::filesystem::create_directories(build_dir);
+    // entries of other builds can never be loaded again
+    for (const auto& entry : boost::filesystem::directory_iterator(cache_dir)) {
+      const auto& path = entry.path();
+      if (path != build_dir && boost::filesystem::is_directory(path) &&
+          is_build_dir_name(path.filename().string())) {
+        LOG(INFO) << "Disk code cache: removing entries of another build " << path;
+        boost::filesystem::remove_all(path);
+      }
+    }
+    LOG(INFO) << "Disk code cache: using " << build_dir;
+    it->second.reset(new DiskCodeCache(build_dir));
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Disk code cache disabled for " << g_disk_code_cache_dir << ": "
+                 << e.what();
+  }
+  return it->second.get();
+}
+
+void DiskCodeCache::tagModule(llvm::Module& module, const CodeCacheKey& key) {
+  module.setModuleIdentifier(kModuleIdPrefix + hash_key(key));
+}
+
+bool DiskCodeCache::isTagged(const llvm::Module& module) {
+  const auto& module_id = module.getModuleIdentifier();
+  return module_id.size() == kModuleIdPrefix.size() + kHashLength &&
+         module_id.compare(0, kModuleIdPrefix.size(), kModuleIdPrefix) == 0;
+}
+
+boost::filesystem::path DiskCodeCache::getEntryPath(const std::string& key_hash) const {
+  return build_dir_ / (key_hash + ".o");
+}
+
+bool DiskCodeCache::contains(const CodeCacheKey& key) const {
+  boost::system::error_code ec;
+  return boost::filesystem::exists(getEntryPath(hash_key(key)), ec);
+}
+
+std::unique_ptr<llvm::MemoryBuffer> DiskCodeCache::load(const llvm::Module& module) {
+  if (!isTagged(module)) {
+    return nullptr;
+  }
+  const auto path =
+      getEntryPath(module.getModuleIdentifier().substr(kModuleIdPrefix.size()));
+  auto object = llvm::MemoryBuffer::getFile(path.string());
+  if (!object) {
+    return nullptr;
+  }
+  // touch the entry, eviction drops the least recently used entries first
+  boost::system::error_code ec;
+  boost::filesystem::last_write_time(path, std::time(nullptr), ec);
+  ++hit_count_;
+  VLOG(1) << "Disk code cache: loaded compiled kernel " << path;
+  return std::move(object.get());
+}
+
+void DiskCodeCache::notifyObjectCompiled(const llvm::Module* module,
+                                         llvm::MemoryBufferRef obj) {
+  if (!module || !isTagged(*module)) {
+    return;
+  }
+  try {
+    const auto path =
+        getEntryPath(module->getModuleIdentifier().substr(kModuleIdPrefix.size()));
+    // write to a temporary file first, so that a concurrent load never sees a partial
+    // entry
+    const auto tmp_path =
+        boost::filesystem::unique_path(path.string() + ".%%%%-%%%%-%%%%.tmp");
+    {
+      std::ofstream out(tmp_path.string(), std::ios::binary);
+      out.write(obj.getBufferStart(), obj.getBufferSize());
+      if (!out) {
+        out.close();
+        boost::filesystem::remove(tmp_path);
+        LOG(WARNING) << "Disk code cache: failed to write " << tmp_path;
+        return;
+      }
+    }
+    std::lock_guard<std::mutex> lock(eviction_mutex_);
+    // an entry added concurrently for the same key is replaced
+    boost::system::error_code ec;
+    const auto replaced_size = boost::filesystem::file_size(path, ec);
+    boost::filesystem::rename(tmp_path, path);
+    if (!ec) {
+      total_size_ -= std::min(total_size_, static_cast<size_t>(replaced_size));
+    }
+    total_size_ += obj.getBufferSize();
+    VLOG(1) << "Disk code cache: added compiled kernel " << path;
+    if (total_size_ > g_disk_code_cache_max_size_in_bytes) {
+      evictEntries();
+    }
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Disk code cache: failed to add compiled kernel, " << e.what();
+  }
+}
+
+// Lists the entries only once they exceed the size limit, with eviction_mutex_ held.
+void DiskCodeCache::evictEntries() {
+  std::vector<std::pair<std::time_t, boost::filesystem::path>> entries;
+  size_t total_size{0};
+  for (const auto& entry : boost::filesystem::directory_iterator(build_dir_)) {
+    const auto& path = entry.path();
+    if (path.extension() != ".o") {
+      continue;
+    }
+    boost::system::error_code ec;
+    const auto entry_size = boost::filesystem::file_size(path, ec);
+    if (ec) {
+      continue;
+    }
+    total_size += entry_size;
+    entries.emplace_back(boost::filesystem::last_write_time(path, ec), path);
+  }
+  if (total_size <= g_disk_code_cache_max_size_in_bytes) {
+    total_size_ = total_size;
+    return;
+  }
+  std::sort(entries.begin(), entries.end());
+  for (const auto& [last_used, path] : entries) {
+    if (total_size <= g_disk_code_cache_max_size_in_bytes) {
+      break;
+    }
+    boost::system::error_code ec;
+    const auto entry_size = boost::filesystem::file_size(path, ec);
+    if (!ec && boost::filesystem::remove(path, ec)) {
+      total_size -= entry_size;
+      VLOG(1) << "Disk code cache: evicted compiled kernel " << path;
+    }
+  }
+  total_size_ = total_size;
+}
+
+void DiskCodeCache::clear() {
+  std::lock_guard<std::mutex> lock(eviction_mutex_);
+  for (const auto& entry : boost::filesystem::directory_iterator(build_dir_)) {
+    boost::system::error_code ec;
+    boost::filesystem::remove(entry.path(), ec);
+  }
+  total_size_ = 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    DiskCodeCache.h
+ * @brief   Persistent cache of compiled CPU kernels, which survives server restarts.
+ *
+ * Object code emitted by MCJIT is stored in a local directory, keyed by a hash of the
+ * code cache key (the IR of the generated functions). Entries live in a subdirectory
+ * named after the build: the LLVM version, the host CPU, the runtime functions module
+ * and the server binary. Subdirectories of other builds are removed on first use.
+ */
+
+#pragma once
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/Module.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "QueryEngine/CodeCache.h"
+
+extern std::string g_disk_code_cache_dir;
+extern size_t g_disk_code_cache_max_size_in_bytes;
+
+class DiskCodeCache : public llvm::ObjectCache {
+ public:
+  // Returns the cache in g_disk_code_cache_dir, or nullptr if the disk code cache is
+  // disabled or its directory is unusable.
+  static DiskCodeCache* getInstance();
+
+  // Tags the module so that its object code is written to the cache once compiled.
+  static void tagModule(llvm::Module& module, const CodeCacheKey& key);
+  static bool isTagged(const llvm::Module& module);
+
+  bool contains(const CodeCacheKey& key) const;
+  // Returns the cached object code of a tagged module, or nullptr on a miss.
+  std::unique_ptr<llvm::MemoryBuffer> load(const llvm::Module& module);
+
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef obj) override;
+  // Lookups go through load(), so that a hit can skip the IR optimization as well.
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override {
+    return nullptr;
+  }
+
+  // Removes every entry of the current build.
+  void clear();
+
+  // Number of kernels loaded from the cache rather than compiled.
+  size_t getHitCount() const { return hit_count_; }
+
+ private:
+  DiskCodeCache(const boost::filesystem::path& build_dir);
+
+  boost::filesystem::path getEntryPath(const std::string& key_hash) const;
+  void evictEntries();
+
+  const boost::filesystem::path build_dir_;
+  std::mutex eviction_mutex_;
+  // size of the entries in build_dir_, listed once on creation and kept up to date by
+  // the additions and evictions of this process
+  size_t total_size_{0};
+  std::atomic<size_t> hit_count_{0};
+
+  static std::mutex instances_mutex_;
+  static std::map<std::string, std::unique_ptr<DiskCodeCache>> instances_;
+};
@@ -88,6 +88,9 @@ size_t g_watchdog_in_clause_max_num_input_rows{5000000};
 size_t g_in_clause_num_elem_skip_bitmap{100};
 bool g_enable_cpu_sub_tasks{false};
 size_t g_cpu_sub_task_size{500'000};
+size_t g_parallel_reduction_min_entry_count{100'000};
+bool g_enable_partitioned_baseline_reduction{true};
+size_t g_partitioned_baseline_reduction_min_entry_count{10'000'000};
 bool g_enable_filter_function{true};
 unsigned g_dynamic_watchdog_time_limit{10000};
 bool g_allow_cpu_retry{true};
@@ -96,6 +99,8 @@ bool g_null_div_by_zero{false};
 unsigned g_trivial_loop_join_threshold{1000};
 bool g_from_table_reordering{true};
 bool g_inner_join_fragment_skipping{true};
+bool g_enable_runtime_join_filters{true};
+bool g_enable_loop_join_fragment_alignment{false};
 extern bool g_enable_smem_group_by;
 extern std::unique_ptr<llvm::Module> udf_gpu_module;
 extern std::unique_ptr<llvm::Module> udf_cpu_module;
@@ -134,6 +139,7 @@ double g_bump_allocator_step_reduction{0.75};
 bool g_enable_direct_columnarization{true};
 extern bool g_enable_string_functions;
 bool g_enable_lazy_fetch{true};
+bool g_enable_left_join_lazy_fetch{true};
 bool g_enable_runtime_query_interrupt{true};
 bool g_enable_non_kernel_time_query_interrupt{true};
 bool g_use_estimator_result_cache{true};
@@ -161,11 +167,13 @@ bool g_use_query_resultset_cache{true};
 bool g_use_chunk_metadata_cache{true};
 bool g_allow_auto_resultset_caching{false};
 bool g_allow_query_step_skipping{true};
+bool g_use_string_dict_translation_map_cache{true};
 size_t g_hashtable_cache_total_bytes{size_t(1) << 32};
 size_t g_max_cacheable_hashtable_size_bytes{size_t(1) << 31};
 size_t g_query_resultset_cache_total_bytes{size_t(1) << 32};
 size_t g_max_cacheable_query_resultset_size_bytes{size_t(1) << 31};
 size_t g_auto_resultset_caching_threshold{size_t(1) << 20};
+size_t g_string_dict_translation_map_cache_total_bytes{size_t(1) << 30};
 bool g_optimize_cuda_block_and_grid_sizes{false};
 
 size_t g_approx_quantile_buffer{1000};
@@ -546,6 +554,7 @@ void Executor::clearMemory(const Data_Namespace::MemoryLevel memory_level) {
         // CPU memory (currently used in ExecuteTest to lower memory pressure)
         // TODO: Move JoinHashTableCacheInvalidator to Executor::clearExternalCaches();
         JoinHashTableCacheInvalidator::invalidateCaches();
+        getStringDictTranslationMapCache()->clearCache();
       }
       Executor::clearExternalCaches(true, nullptr, 0);
       Catalog_Namespace::SysCatalog::instance().getDataMgr().clearMemory(memory_level);
@@ -613,8 +622,17 @@ const StringDictionaryProxy::IdMap* Executor::getStringProxyTranslationMap(
   CHECK(row_set_mem_owner);
   std::lock_guard<std::mutex> lock(
       str_dict_mutex_);  // TODO: can we use RowSetMemOwner state mutex here?
+  const auto persisted_translation_map = getPersistedStringDictTranslationMap(
+      row_set_mem_owner->getOrAddStringDictProxy(source_dict_key, with_generation),
+      row_set_mem_owner->getOrAddStringDictProxy(dest_dict_key, with_generation),
+      string_op_infos);
   return row_set_mem_owner->getOrAddStringProxyTranslationMap(
-      source_dict_key, dest_dict_key, with_generation, translation_type, string_op_infos);
+      source_dict_key,
+      dest_dict_key,
+      with_generation,
+      translation_type,
+      string_op_infos,
+      persisted_translation_map.get());
 }
 
 const StringDictionaryProxy::IdMap*
@@ -629,11 +647,43 @@ Executor::getJoinIntersectionStringProxyTranslationMap(
       str_dict_mutex_);  // TODO: can we use RowSetMemOwner state mutex here?
   // First translate lhs onto itself if there are string ops
   if (!dest_string_op_infos.empty()) {
-    row_set_mem_owner->addStringProxyUnionTranslationMap(
+    const auto persisted_dest_translation_map = getPersistedStringDictTranslationMap(
         dest_proxy, dest_proxy, dest_string_op_infos);
+    row_set_mem_owner->addStringProxyUnionTranslationMap(
+        dest_proxy,
+        dest_proxy,
+        dest_string_op_infos,
+        persisted_dest_translation_map.get());
   }
-  return row_set_mem_owner->addStringProxyIntersectionTranslationMap(
+  const auto persisted_translation_map = getPersistedStringDictTranslationMap(
       source_proxy, dest_proxy, source_string_op_infos);
+  return row_set_mem_owner->addStringProxyIntersectionTranslationMap(
+      source_proxy, dest_proxy, source_string_op_infos, persisted_translation_map.get());
+}
+
+std::shared_ptr<const DictionaryTranslationMap>
+Executor::getPersistedStringDictTranslationMap(
+    const StringDictionaryProxy* source_proxy,
+    const StringDictionaryProxy* dest_proxy,
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const {
+  CHECK(source_proxy);
+  CHECK(dest_proxy);
+  // Only translations that depend on nothing but the contents of persisted dictionaries
+  // can be shared across queries. A dictionary translated onto itself is the identity
+  // unless string ops are applied.
+  if (source_proxy->getGeneration() <= 0 ||
+      (string_op_infos.empty() &&
+       source_proxy->getDictKey() == dest_proxy->getDictKey()) ||
+      source_proxy->getDictKey().dict_id == DictRef::literalsDictId ||
+      dest_proxy->getDictKey().dict_id == DictRef::literalsDictId ||
+      source_proxy->getDictionary()->isClient() ||
+      dest_proxy->getDictionary()->isClient()) {
+    return nullptr;
+  }
+  return getStringDictTranslationMapCache()->getOrAddTranslationMap(
+      source_proxy->getDictionarySharedPtr(),
+      dest_proxy->getDictionarySharedPtr(),
+      string_op_infos);
 }
 
 const StringDictionaryProxy::TranslationMap<Datum>*
@@ -1670,51 +1720,82 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
 
   const auto& first = results_per_device.front().first;
 
-  if (query_mem_desc.getQueryDescriptionType() ==
-          QueryDescriptionType::GroupByBaselineHash &&
-      results_per_device.size() > 1) {
-    const auto total_entry_count = std::accumulate(
-        results_per_device.begin(),
-        results_per_device.end(),
-        size_t(0),
-        [](const size_t init, const std::pair<ResultSetPtr, std::vector<size_t>>& rs) {
-          const auto& r = rs.first;
-          return init + r->getQueryMemDesc().getEntryCount();
-        });
-    CHECK(total_entry_count);
-    auto query_mem_desc = first->getQueryMemDesc();
-    query_mem_desc.setEntryCount(total_entry_count);
-    reduced_results = std::make_shared<ResultSet>(first->getTargetInfos(),
-                                                  ExecutorDeviceType::CPU,
-                                                  query_mem_desc,
-                                                  row_set_mem_owner,
-                                                  blockSize(),
-                                                  gridSize());
-    auto result_storage = reduced_results->allocateStorage(plan_state_->init_agg_vals_);
-    reduced_results->initializeStorage();
-    switch (query_mem_desc.getEffectiveKeyWidth()) {
-      case 4:
-        first->getStorage()->moveEntriesToBuffer<int32_t>(
-            result_storage->getUnderlyingBuffer(), query_mem_desc.getEntryCount());
-        break;
-      case 8:
-        first->getStorage()->moveEntriesToBuffer<int64_t>(
-            result_storage->getUnderlyingBuffer(), query_mem_desc.getEntryCount());
-        break;
-      default:
-        CHECK(false);
-    }
-  } else {
-    reduced_results = first;
-  }
-
   int64_t compilation_queue_time = 0;
   const auto reduction_code =
       get_reduction_code(executor_id_, results_per_device, &compilation_queue_time);
 
-  for (size_t i = 1; i < results_per_device.size(); ++i) {
-    reduced_results->getStorage()->reduce(
-        *(results_per_device[i].first->getStorage()), {}, reduction_code, executor_id_);
+  const auto total_entry_count = std::accumulate(
+      results_per_device.begin(),
+      results_per_device.end(),
+      size_t(0),
+      [](const size_t init, const std::pair<ResultSetPtr, std::vector<size_t>>& rs) {
+        const auto& r = rs.first;
+        return init + r->getQueryMemDesc().getEntryCount();
+      });
+  if (g_enable_partitioned_baseline_reduction && results_per_device.size() > 1 &&
+      query_mem_desc.getQueryDescriptionType() ==
+          QueryDescriptionType::GroupByBaselineHash &&
+      !query_mem_desc.didOutputColumnar() &&
+      query_mem_desc.getEntryCount() >=
+          g_partitioned_baseline_reduction_min_entry_count) {
+    // The baseline hash entry count follows the estimated group count. With that many
+    // groups, scattering the partial results by hash range and reducing every range on
+    // its own keeps the reduction within the caches instead of moving the first partial
+    // into the reduced buffer and folding the others into all of it.
+    std::vector<ResultSetPtr> result_sets;
+    result_sets.reserve(results_per_device.size());
+    for (const auto& result : results_per_device) {
+      result_sets.push_back(result.first);
+    }
+    reduced_results =
+        ResultSetManager::reducePartitioned(result_sets, reduction_code, executor_id_);
+  } else if (results_per_device.size() > 2 &&
+             total_entry_count >= g_parallel_reduction_min_entry_count) {
+    // Folding many partial results one at a time leaves most threads idle whenever the
+    // individual results are too small for ResultSetStorage::reduce to split up
+    std::vector<ResultSetPtr> result_sets;
+    result_sets.reserve(results_per_device.size());
+    for (const auto& result : results_per_device) {
+      result_sets.push_back(result.first);
+    }
+    reduced_results =
+        ResultSetManager::reduceTree(result_sets, reduction_code, executor_id_);
+  } else {
+    if (query_mem_desc.getQueryDescriptionType() ==
+            QueryDescriptionType::GroupByBaselineHash &&
+        results_per_device.size() > 1) {
+      CHECK(total_entry_count);
+      auto query_mem_desc = first->getQueryMemDesc();
+      query_mem_desc.setEntryCount(total_entry_count);
+      reduced_results = std::make_shared<ResultSet>(first->getTargetInfos(),
+                                                    ExecutorDeviceType::CPU,
+                                                    query_mem_desc,
+                                                    row_set_mem_owner,
+                                                    blockSize(),
+                                                    gridSize());
+      auto result_storage =
+          reduced_results->allocateStorage(plan_state_->init_agg_vals_);
+      reduced_results->initializeStorage();
+      switch (query_mem_desc.getEffectiveKeyWidth()) {
+        case 4:
+          first->getStorage()->moveEntriesToBuffer<int32_t>(
+              result_storage->getUnderlyingBuffer(), query_mem_desc.getEntryCount());
+          break;
+        case 8:
+          first->getStorage()->moveEntriesToBuffer<int64_t>(
+              result_storage->getUnderlyingBuffer(), query_mem_desc.getEntryCount());
+          break;
+        default:
+          CHECK(false);
+      }
+    } else {
+      reduced_results = first;
+    }
+
+    for (size_t i = 1; i < results_per_device.size(); ++i) {
+      reduced_results->getStorage()->reduce(
+          *(results_per_device[i].first->getStorage()), {}, reduction_code, executor_id_);
+    }
   }
   reduced_results->addCompilationQueueTime(compilation_queue_time);
   reduced_results->invalidateCachedRowCount();
@@ -1772,6 +1853,19 @@ size_t get_context_count(const ExecutorDeviceType device_type,
 
 namespace {
 
+// With CPU sub-tasks every kernel is split into morsels pulled by any thread of the
+// pool, so a query step can keep more threads busy than it has kernels.
+bool use_cpu_sub_tasks(const ExecutorDeviceType device_type) {
+  return g_enable_cpu_sub_tasks && device_type == ExecutorDeviceType::CPU;
+}
+
+size_t get_kernel_thread_count(const ExecutorDeviceType device_type,
+                               const size_t num_kernels) {
+  return use_cpu_sub_tasks(device_type)
+             ? std::max(num_kernels, static_cast<size_t>(cpu_threads()))
+             : num_kernels;
+}
+
 // Compute a very conservative entry count for the output buffer entry count using no
 // other information than the number of tuples in each table and multiplying them
 // together.
@@ -2266,9 +2360,19 @@ ResultSetPtr Executor::executeWorkUnitImpl(
                                      available_gpus,
                                      available_cpus);
         if (!kernels.empty()) {
-          row_set_mem_owner_->setKernelMemoryAllocator(kernels.size());
+          row_set_mem_owner_->setKernelMemoryAllocator(get_kernel_thread_count(
+              query_comp_desc_owned->getDeviceType(), kernels.size()));
         }
-        if (g_enable_executor_resource_mgr) {
+        if (kernel_thread_limit_ &&
+            query_comp_desc_owned->getDeviceType() == ExecutorDeviceType::CPU) {
+          // the caller already holds the CPU slots, see setKernelThreadLimit
+          const size_t num_threads = std::min(
+              kernel_thread_limit_,
+              std::max(get_kernel_thread_count(ExecutorDeviceType::CPU, kernels.size()),
+                       size_t(1)));
+          launchKernelsImpl(
+              shared_context, std::move(kernels), ExecutorDeviceType::CPU, num_threads);
+        } else if (g_enable_executor_resource_mgr) {
           launchKernelsViaResourceMgr(shared_context,
                                       std::move(kernels),
                                       query_comp_desc_owned->getDeviceType(),
@@ -2902,6 +3006,27 @@ bool has_lazy_fetched_columns(const std::vector<ColumnLazyFetchInfo>& fetched_co
   return false;
 }
 
+// Adds the key ranges of the hash tables built for the inner joins to the simple quals of
+// the execution unit, so that outer fragments which can't match any inner row are
+// skipped. The quals are only used for fragment skipping, the generated code still
+// probes the hash table for every row of the fragments which remain.
+RelAlgExecutionUnit add_runtime_join_filters(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<std::shared_ptr<HashJoin>>& join_hash_tables) {
+  RelAlgExecutionUnit filtered_ra_exe_unit = ra_exe_unit;
+  for (const auto& hash_table : join_hash_tables) {
+    auto runtime_filter_quals = hash_table->getRuntimeFilterQuals();
+    if (!runtime_filter_quals.empty()) {
+      VLOG(1) << "Skipping outer fragments using " << runtime_filter_quals.size()
+              << " runtime join filter(s) from the " << hash_table->getHashJoinType()
+              << " hash table on " << hash_table->getInnerTableId();
+    }
+    filtered_ra_exe_unit.simple_quals.splice(filtered_ra_exe_unit.simple_quals.end(),
+                                             runtime_filter_quals);
+  }
+  return filtered_ra_exe_unit;
+}
+
 }  // namespace
 
 std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
@@ -2939,17 +3064,30 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
   const auto device_count = deviceCount(device_type);
   CHECK_GT(device_count, 0);
 
-  fragment_descriptor.buildFragmentKernelMap(ra_exe_unit,
-                                             shared_context.getFragOffsets(),
-                                             device_count,
-                                             device_type,
-                                             use_multifrag_kernel,
-                                             g_inner_join_fragment_skipping,
-                                             this);
+  std::optional<RelAlgExecutionUnit> filtered_ra_exe_unit;
+  if (g_enable_runtime_join_filters && !ra_exe_unit.union_all &&
+      !plan_state_->join_info_.join_hash_tables_.empty()) {
+    filtered_ra_exe_unit =
+        add_runtime_join_filters(ra_exe_unit, plan_state_->join_info_.join_hash_tables_);
+  }
+  fragment_descriptor.buildFragmentKernelMap(
+      filtered_ra_exe_unit ? *filtered_ra_exe_unit : ra_exe_unit,
+      shared_context.getFragOffsets(),
+      device_count,
+      device_type,
+      use_multifrag_kernel,
+      g_inner_join_fragment_skipping,
+      this);
   if (eo.with_watchdog && fragment_descriptor.shouldCheckWorkUnitWatchdog()) {
     checkWorkUnitWatchdog(ra_exe_unit, table_infos, device_type, device_count);
   }
 
+  if (query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection &&
+      !render_info) {
+    shared_context.setTopNKeyThreshold(
+        streaming_top_n::KeyThreshold::create(ra_exe_unit, table_infos));
+  }
+
   if (use_multifrag_kernel) {
     VLOG(1) << "Creating multifrag execution kernels";
     VLOG(1) << query_mem_desc.toString();
@@ -3044,13 +3182,15 @@ void Executor::launchKernelsImpl(SharedKernelContext& shared_context,
 #ifdef HAVE_TBB
   const size_t num_threads =
       requested_num_threads == Executor::auto_num_threads
-          ? std::min(kernels.size(), static_cast<size_t>(cpu_threads()))
+          ? std::min(get_kernel_thread_count(device_type, kernels.size()),
+                     static_cast<size_t>(cpu_threads()))
           : requested_num_threads;
   tbb::task_arena local_arena(num_threads);
 #else
   const size_t num_threads = cpu_threads();
 #endif
   shared_context.setNumAllocatedThreads(num_threads);
+  shared_context.setNumKernels(kernels.size());
   LOG(EXECUTOR) << "Launching query step with " << num_threads << " threads.";
   threading::task_group tg;
   // A hack to have unused unit for results collection.
@@ -3058,7 +3198,7 @@ void Executor::launchKernelsImpl(SharedKernelContext& shared_context,
       kernels.empty() ? nullptr : &kernels[0]->ra_exe_unit_;
 
 #ifdef HAVE_TBB
-  if (g_enable_cpu_sub_tasks && device_type == ExecutorDeviceType::CPU) {
+  if (use_cpu_sub_tasks(device_type)) {
     shared_context.setThreadPool(&tg);
   }
   ScopeGuard pool_guard([&shared_context]() { shared_context.setThreadPool(nullptr); });
@@ -3143,16 +3283,21 @@ void Executor::launchKernelsViaResourceMgr(
   // by capping the number of requested slots from GPU than actual GPUs
   const size_t num_kernels = kernels.size();
   constexpr bool cap_slots = false;
+  // Group by kernels split into sub-tasks can use a slot for every CPU thread, any slots
+  // the resource manager does not grant just leave more sub-tasks per thread.
+  const size_t num_requested_slots =
+      query_mem_desc.isGroupBy() ? get_kernel_thread_count(device_type, num_kernels)
+                                 : num_kernels;
   const size_t num_compute_slots =
       cap_slots
-          ? std::min(num_kernels,
+          ? std::min(num_requested_slots,
                      executor_resource_mgr_
                          ->get_resource_info(
                              device_type == ExecutorDeviceType::GPU
                                  ? ExecutorResourceMgr_Namespace::ResourceType::GPU_SLOTS
                                  : ExecutorResourceMgr_Namespace::ResourceType::CPU_SLOTS)
                          .second)
-          : num_kernels;
+          : num_requested_slots;
   const size_t cpu_result_mem_bytes_per_kernel =
       query_mem_desc.getBufferSizeBytes(device_type);
 
@@ -3257,6 +3402,7 @@ std::vector<size_t> Executor::getTableFragmentIndices(
   auto& inner_frags = table_frags_it->second;
   CHECK_LT(size_t(1), ra_exe_unit.input_descs.size());
   std::vector<size_t> all_frag_ids;
+  bool skipped_unaligned_fragment{false};
   for (size_t inner_frag_idx = 0; inner_frag_idx < inner_frags->size();
        ++inner_frag_idx) {
     const auto& inner_frag_info = (*inner_frags)[inner_frag_idx];
@@ -3268,11 +3414,272 @@ std::vector<size_t> Executor::getTableFragmentIndices(
                          device_type)) {
       continue;
     }
+    if (skipUnalignedFragmentPair(
+            outer_fragment_info, inner_frag_info, table_idx, ra_exe_unit)) {
+      skipped_unaligned_fragment = true;
+      continue;
+    }
     all_frag_ids.push_back(inner_frag_idx);
   }
+  if (skipped_unaligned_fragment) {
+    // the kernels now see a subset of the inner fragments, so they have to fetch and
+    // iterate over those one at a time rather than over the whole inner table
+    plan_state_->join_info_.sharded_range_table_indices_.emplace(table_idx);
+    plan_state_->join_info_.aligned_range_table_indices_.emplace(table_idx);
+  }
   return all_frag_ids;
 }
 
+namespace {
+
+// A join key column, shifted by a constant number of units of the column type.
+struct ShiftedColumnVar {
+  const Analyzer::ColumnVar* col_var;
+  int64_t offset;
+};
+
+std::optional<int64_t> get_int_constant(const Analyzer::Expr* expr) {
+  const auto constant = dynamic_cast<const Analyzer::Constant*>(expr);
+  if (!constant || constant->get_is_null() || !constant->get_type_info().is_integer()) {
+    return std::nullopt;
+  }
+  return extract_int_type_from_datum(constant->get_constval(),
+                                     constant->get_type_info());
+}
+
+// Number of units of a timestamp of the given precision in a DATEADD field, if the
+// field is a whole number of such units.
+std::optional<int64_t> get_dateadd_field_units(const DateaddField field,
+                                               const int32_t dimension) {
+  int64_t field_nanos{0};
+  switch (field) {
+    case daWEEK:
+      field_nanos = 7 * kSecsPerDay * kNanoSecsPerSec;
+      break;
+    case daDAY:
+      field_nanos = kSecsPerDay * kNanoSecsPerSec;
+      break;
+    case daHOUR:
+      field_nanos = kSecsPerHour * kNanoSecsPerSec;
+      break;
+    case daMINUTE:
+      field_nanos = kSecsPerMin * kNanoSecsPerSec;
+      break;
+    case daSECOND:
+      field_nanos = kNanoSecsPerSec;
+      break;
+    case daMILLISECOND:
+      field_nanos = kNanoSecsPerSec / kMilliSecsPerSec;
+      break;
+    case daMICROSECOND:
+      field_nanos = kNanoSecsPerSec / kMicroSecsPerSec;
+      break;
+    case daNANOSECOND:
+      field_nanos = 1;
+      break;
+    default:
+      return std::nullopt;
+  }
+  const auto unit_nanos =
+      kNanoSecsPerSec / DateTimeUtils::get_timestamp_precision_scale(dimension);
+  if (field_nanos % unit_nanos) {
+    return std::nullopt;
+  }
+  return field_nanos / unit_nanos;
+}
+
+// Matches `col`, `col +/- constant` and `DATEADD(field, constant, col)` over integer and
+// timestamp columns.
+std::optional<ShiftedColumnVar> get_shifted_column_var(const Analyzer::Expr* expr) {
+  if (const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr)) {
+    const auto& ti = col_var->get_type_info();
+    if (!ti.is_integer() && !ti.is_timestamp()) {
+      return std::nullopt;
+    }
+    return ShiftedColumnVar{col_var, 0};
+  }
+  if (const auto uoper = dynamic_cast<const Analyzer::UOper*>(expr)) {
+    // widening integer casts keep the values of the column
+    const auto& operand_ti = uoper->get_operand()->get_type_info();
+    if (uoper->get_optype() == kCAST && expr->get_type_info().is_integer() &&
+        operand_ti.is_integer() &&
+        expr->get_type_info().get_size() >= operand_ti.get_size()) {
+      return get_shifted_column_var(uoper->get_operand());
+    }
+    return std::nullopt;
+  }
+  if (const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(expr)) {
+    const auto optype = bin_oper->get_optype();
+    if ((optype != kPLUS && optype != kMINUS) || !expr->get_type_info().is_integer()) {
+      return std::nullopt;
+    }
+    auto shifted = get_shifted_column_var(bin_oper->get_left_operand());
+    auto number = get_int_constant(bin_oper->get_right_operand());
+    if ((!shifted || !number) && optype == kPLUS) {
+      shifted = get_shifted_column_var(bin_oper->get_right_operand());
+      number = get_int_constant(bin_oper->get_left_operand());
+    }
+    if (!shifted || !number ||
+        (optype == kPLUS
+             ? __builtin_add_overflow(shifted->offset, *number, &shifted->offset)
+             : __builtin_sub_overflow(shifted->offset, *number, &shifted->offset))) {
+      return std::nullopt;
+    }
+    return shifted;
+  }
+  if (const auto dateadd = dynamic_cast<const Analyzer::DateaddExpr*>(expr)) {
+    auto shifted = get_shifted_column_var(dateadd->get_datetime_expr());
+    const auto number = get_int_constant(dateadd->get_number_expr());
+    if (!shifted || !number || !shifted->col_var->get_type_info().is_timestamp() ||
+        shifted->col_var->get_type_info().get_dimension() !=
+            expr->get_type_info().get_dimension()) {
+      return std::nullopt;
+    }
+    const auto units = get_dateadd_field_units(
+        dateadd->get_field(), shifted->col_var->get_type_info().get_dimension());
+    int64_t shift{0};
+    if (!units || __builtin_mul_overflow(*number, *units, &shift) ||
+        __builtin_add_overflow(shifted->offset, shift, &shifted->offset)) {
+      return std::nullopt;
+    }
+    return shifted;
+  }
+  return std::nullopt;
+}
+
+std::optional<std::pair<int64_t, int64_t>> get_chunk_value_range(
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const Analyzer::ColumnVar* col_var) {
+  const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+  const auto chunk_metadata_it =
+      chunk_metadata_map.find(col_var->getColumnKey().column_id);
+  if (chunk_metadata_it == chunk_metadata_map.end()) {
+    return std::nullopt;
+  }
+  const auto& chunk_stats = chunk_metadata_it->second->chunkStats;
+  const auto& ti = col_var->get_type_info();
+  const auto chunk_min = extract_min_stat_int_type(chunk_stats, ti);
+  const auto chunk_max = extract_max_stat_int_type(chunk_stats, ti);
+  if (chunk_min > chunk_max) {
+    return std::nullopt;
+  }
+  return std::make_pair(chunk_min, chunk_max);
+}
+
+void collect_conjuncts(const Analyzer::Expr* expr,
+                       std::vector<const Analyzer::BinOper*>& conjuncts) {
+  const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(expr);
+  if (!bin_oper) {
+    return;
+  }
+  if (bin_oper->get_optype() == kAND) {
+    collect_conjuncts(bin_oper->get_left_operand(), conjuncts);
+    collect_conjuncts(bin_oper->get_right_operand(), conjuncts);
+  } else {
+    conjuncts.push_back(bin_oper);
+  }
+}
+
+}  // namespace
+
+// Returns true iff the key ranges of two fragments of tables in a loop join can't
+// satisfy one of the (in)equality or band conditions of the join, which lets a join of
+// tables clustered on the join key only visit the overlapping pairs of fragments.
+bool Executor::skipUnalignedFragmentPair(
+    const Fragmenter_Namespace::FragmentInfo& outer_fragment_info,
+    const Fragmenter_Namespace::FragmentInfo& inner_fragment_info,
+    const int table_idx,
+    const RelAlgExecutionUnit& ra_exe_unit) const {
+  if (!g_enable_loop_join_fragment_alignment || table_idx < 1 ||
+      static_cast<size_t>(table_idx) > ra_exe_unit.join_quals.size()) {
+    return false;
+  }
+  // the matched inner row bitmap of a FULL join is indexed by the position of the rows
+  // among all the inner fragments, see RelAlgExecutor::addUnmatchedInnerRows
+  if (std::any_of(ra_exe_unit.join_quals.begin(),
+                  ra_exe_unit.join_quals.end(),
+                  [](const JoinCondition& join_condition) {
+                    return static_cast<bool>(join_condition.matched_inner_rows);
+                  })) {
+    return false;
+  }
+  const auto& join_condition = ra_exe_unit.join_quals[table_idx - 1];
+  if (join_condition.type != JoinType::INNER) {
+    return false;
+  }
+  for (const auto& hash_table : plan_state_->join_info_.join_hash_tables_) {
+    // a hash table addresses the rows of all the fragments of its inner table
+    if (hash_table->getInnerTableRteIdx() == table_idx) {
+      return false;
+    }
+  }
+  std::vector<const Analyzer::BinOper*> conjuncts;
+  for (const auto& qual : join_condition.quals) {
+    collect_conjuncts(qual.get(), conjuncts);
+  }
+  for (const auto conjunct : conjuncts) {
+    auto optype = conjunct->get_optype();
+    if (optype != kEQ && optype != kLT && optype != kLE && optype != kGT &&
+        optype != kGE) {
+      continue;
+    }
+    auto lhs = get_shifted_column_var(conjunct->get_left_operand());
+    auto rhs = get_shifted_column_var(conjunct->get_right_operand());
+    if (!lhs || !rhs) {
+      continue;
+    }
+    if (lhs->col_var->get_rte_idx() == table_idx && rhs->col_var->get_rte_idx() == 0) {
+      std::swap(lhs, rhs);
+      optype = COMMUTE_COMPARISON(optype);
+    }
+    const auto& outer_ti = lhs->col_var->get_type_info();
+    const auto& inner_ti = rhs->col_var->get_type_info();
+    if (lhs->col_var->get_rte_idx() != 0 || rhs->col_var->get_rte_idx() != table_idx ||
+        outer_ti.is_timestamp() != inner_ti.is_timestamp() ||
+        outer_ti.get_dimension() != inner_ti.get_dimension()) {
+      continue;
+    }
+    const auto outer_range = get_chunk_value_range(outer_fragment_info, lhs->col_var);
+    const auto inner_range = get_chunk_value_range(inner_fragment_info, rhs->col_var);
+    // outer OP inner + offset, for every outer value in [outer_min, outer_max] and
+    // inner value in [inner_min, inner_max]
+    int64_t offset{0};
+    int64_t inner_min{0};
+    int64_t inner_max{0};
+    if (!outer_range || !inner_range ||
+        __builtin_sub_overflow(rhs->offset, lhs->offset, &offset) ||
+        __builtin_add_overflow(inner_range->first, offset, &inner_min) ||
+        __builtin_add_overflow(inner_range->second, offset, &inner_max)) {
+      continue;
+    }
+    const auto [outer_min, outer_max] = *outer_range;
+    bool unaligned{false};
+    switch (optype) {
+      case kEQ:
+        unaligned = outer_max < inner_min || outer_min > inner_max;
+        break;
+      case kGE:
+        unaligned = outer_max < inner_min;
+        break;
+      case kGT:
+        unaligned = outer_max <= inner_min;
+        break;
+      case kLE:
+        unaligned = outer_min > inner_max;
+        break;
+      case kLT:
+        unaligned = outer_min >= inner_max;
+        break;
+      default:
+        break;
+    }
+    if (unaligned) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Returns true iff the join between two fragments cannot yield any results, per
 // shard information. The pair can be skipped to avoid full broadcast.
 bool Executor::skipFragmentPair(
@@ -3425,6 +3832,10 @@ bool Executor::needFetchAllFragments(const InputColDescriptor& inner_col_desc,
        plan_state_->isLazyFetchColumn(inner_col_desc))) {
     return false;
   }
+  if (plan_state_->join_info_.aligned_range_table_indices_.count(nest_level)) {
+    // each of the selected fragments is fetched on its own
+    return false;
+  }
   const auto& table_key = inner_col_desc.getScanDesc().getTableKey();
   CHECK_LT(static_cast<size_t>(nest_level), selected_fragments.size());
   CHECK_EQ(table_key, selected_fragments[nest_level].table_key);
@@ -4271,18 +4682,27 @@ void Executor::nukeOldState(const bool allow_lazy_fetch,
                             const RelAlgExecutionUnit* ra_exe_unit) {
   kernel_queue_time_ms_ = 0;
   compilation_queue_time_ms_ = 0;
-  const bool contains_left_deep_outer_join =
-      ra_exe_unit && std::find_if(ra_exe_unit->join_quals.begin(),
-                                  ra_exe_unit->join_quals.end(),
-                                  [](const JoinCondition& join_condition) {
-                                    return join_condition.type == JoinType::LEFT;
-                                  }) != ra_exe_unit->join_quals.end();
+  // the inner table of the left join at nest level i is at rte_idx i + 1
+  std::unordered_set<int> null_extended_rte_idxs;
+  if (ra_exe_unit) {
+    for (size_t level_idx = 0; level_idx < ra_exe_unit->join_quals.size(); ++level_idx) {
+      if (ra_exe_unit->join_quals[level_idx].type == JoinType::LEFT) {
+        null_extended_rte_idxs.insert(static_cast<int>(level_idx + 1));
+      }
+    }
+  }
+  const bool contains_left_deep_outer_join = !null_extended_rte_idxs.empty();
   cgen_state_.reset(
       new CgenState(query_infos.size(), contains_left_deep_outer_join, this));
-  plan_state_.reset(new PlanState(allow_lazy_fetch && !contains_left_deep_outer_join,
+  const bool allow_lazy_fetch_with_joins =
+      !contains_left_deep_outer_join || g_enable_left_join_lazy_fetch;
+  plan_state_.reset(new PlanState(allow_lazy_fetch && allow_lazy_fetch_with_joins,
                                   query_infos,
                                   deleted_cols_map,
                                   this));
+  // rows without a match have no position in the inner table of a left join, so only
+  // the columns of the other tables can be fetched lazily
+  plan_state_->null_extended_rte_idxs_ = std::move(null_extended_rte_idxs);
 }
 
 void Executor::preloadFragOffsets(const std::vector<InputDescriptor>& input_descs,
@@ -4979,6 +5399,11 @@ ResultSetRecyclerHolder& Executor::getResultSetRecyclerHolder() {
   return resultset_recycler_holder_;
 }
 
+StringDictTranslationMapRecycler* Executor::getStringDictTranslationMapCache() {
+  CHECK(string_dict_translation_map_cache_);
+  return string_dict_translation_map_cache_.get();
+}
+
 heavyai::shared_mutex& Executor::getSessionLock() {
   return executor_session_mutex_;
 }
@@ -5514,6 +5939,9 @@ std::unordered_map<CardinalityCacheKey, size_t> Executor::cardinality_cache_;
 // Executor has a single global result set recycler holder
 // which contains two recyclers related to query resultset
 ResultSetRecyclerHolder Executor::resultset_recycler_holder_;
+std::unique_ptr<StringDictTranslationMapRecycler>
+    Executor::string_dict_translation_map_cache_ =
+        std::make_unique<StringDictTranslationMapRecycler>();
 QueryPlanDAG Executor::latest_query_plan_extracted_{EMPTY_QUERY_PLAN};
 
 // Useful for debugging.
@@ -60,6 +60,7 @@
 #include "QueryEngine/QueryPlanDagCache.h"
 #include "QueryEngine/RelAlgExecutionUnit.h"
 #include "QueryEngine/RelAlgTranslator.h"
+#include "QueryEngine/DataRecycler/StringDictTranslationMapRecycler.h"
 #include "QueryEngine/ResultSetRecyclerHolder.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
 #include "QueryEngine/TableGenerations.h"
@@ -464,6 +465,42 @@ class Executor {
     }
   }
 
+  // called before rows get appended to a table, clearExternalCachesAfterAppend has to
+  // be called once they are
+  static void clearExternalCachesForAppend(const TableDescriptor* td,
+                                           const int current_db_id) {
+    if (!g_enable_incremental_join_hash_table_maintenance || !td || !td->fragmenter ||
+        td->nShards > 0) {
+      clearExternalCaches(true, td, current_db_id);
+      return;
+    }
+    const auto table_info = td->fragmenter->getFragmentsForQuery();
+    if (table_info.chunkKeyPrefix.empty()) {
+      clearExternalCaches(true, td, current_db_id);
+      return;
+    }
+    auto table_key = boost::hash_value(table_info.chunkKeyPrefix);
+    ResultSetCacheInvalidator::invalidateCachesByTable(table_key);
+    AppendTriggeredCacheInvalidator::invalidateCachesByTable(table_key);
+    PerfectJoinHashTable::markCachedItemAsDirtyOnAppend(table_key,
+                                                        table_info.fragments.size());
+    Executor::invalidateCardinalityCacheForTable({current_db_id, td->tableId});
+  }
+
+  // drops the cached hash tables kept by clearExternalCachesForAppend which the append
+  // made unreachable by opening a new fragment
+  static void clearExternalCachesAfterAppend(const TableDescriptor* td) {
+    if (!g_enable_incremental_join_hash_table_maintenance || !td || !td->fragmenter ||
+        td->nShards > 0) {
+      return;
+    }
+    const auto table_info = td->fragmenter->getFragmentsForQuery();
+    if (!table_info.chunkKeyPrefix.empty()) {
+      PerfectJoinHashTable::markCachedItemAsDirtyOnAppend(
+          boost::hash_value(table_info.chunkKeyPrefix), table_info.fragments.size());
+    }
+  }
+
   void reset(bool discard_runtime_modules_only = false);
 
   template <typename F>
@@ -601,6 +638,13 @@ class Executor {
       const std::vector<StringOps_Namespace::StringOpInfo>& dest_source_string_op_infos,
       std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner) const;
 
+  // Persisted translation map between the dictionaries underlying the two proxies,
+  // string ops included, if the string dictionary translation map cache can serve it
+  std::shared_ptr<const DictionaryTranslationMap> getPersistedStringDictTranslationMap(
+      const StringDictionaryProxy* source_proxy,
+      const StringDictionaryProxy* dest_proxy,
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const;
+
   const StringDictionaryProxy::TranslationMap<Datum>* getStringProxyNumericTranslationMap(
       const shared::StringDictKey& source_dict_key,
       const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
@@ -1014,6 +1058,12 @@ class Executor {
       const RelAlgExecutionUnit& ra_exe_unit,
       const ExecutorDeviceType device_type);
 
+  bool skipUnalignedFragmentPair(
+      const Fragmenter_Namespace::FragmentInfo& outer_fragment_info,
+      const Fragmenter_Namespace::FragmentInfo& inner_fragment_info,
+      const int table_idx,
+      const RelAlgExecutionUnit& ra_exe_unit) const;
+
   FetchResult fetchChunks(const ColumnFetcher&,
                           const RelAlgExecutionUnit& ra_exe_unit,
                           const int device_id,
@@ -1211,6 +1261,11 @@ class Executor {
                         QueryMemoryDescriptor& query_mem_desc,
                         const CompilationOptions& co,
                         const ExecutionOptions& eo);
+  // Flags the inner rows matched by the current row of a FULL outer join before
+  // branching to the loop body, returns the block to enter the body through.
+  llvm::BasicBlock* codegenMarkMatchedInnerRows(const RelAlgExecutionUnit& ra_exe_unit,
+                                                llvm::BasicBlock* loop_body_bb,
+                                                const CompilationOptions& co);
   bool compileBody(const RelAlgExecutionUnit& ra_exe_unit,
                    GroupByAndAggregate& group_by_and_aggregate,
                    QueryMemoryDescriptor& query_mem_desc,
@@ -1330,6 +1385,11 @@ class Executor {
     agg_col_range_cache_ = aggregated_col_range;
   }
   ExecutorId getExecutorId() const { return executor_id_; };
+  // A non-zero limit caps the threads of CPU query steps, whose CPU slots are then
+  // held by the caller instead of being requested from the ExecutorResourceMgr.
+  void setKernelThreadLimit(const size_t kernel_thread_limit) {
+    kernel_thread_limit_ = kernel_thread_limit;
+  }
   QuerySessionId& getCurrentQuerySession(
       heavyai::shared_lock<heavyai::shared_mutex>& read_lock);
   QuerySessionStatus::QueryStatus getQuerySessionStatus(
@@ -1410,6 +1470,7 @@ class Executor {
   heavyai::shared_mutex& getDataRecyclerLock();
   QueryPlanDagCache& getQueryPlanDagCache();
   ResultSetRecyclerHolder& getResultSetRecyclerHolder();
+  static StringDictTranslationMapRecycler* getStringDictTranslationMapCache();
 
   CgenState* getCgenStatePtr() const { return cgen_state_.get(); }
   PlanState* getPlanStatePtr() const { return plan_state_.get(); }
@@ -1560,6 +1621,7 @@ class Executor {
   TableIdToNodeMap table_id_to_node_map_;
 
   int64_t kernel_queue_time_ms_ = 0;
+  size_t kernel_thread_limit_{0};
   int64_t compilation_queue_time_ms_ = 0;
 
   // Singleton instance used for an execution unit which is a project with window
@@ -1606,6 +1668,8 @@ class Executor {
 
   static std::unordered_map<CardinalityCacheKey, size_t> cardinality_cache_;
   static ResultSetRecyclerHolder resultset_recycler_holder_;
+  static std::unique_ptr<StringDictTranslationMapRecycler>
+      string_dict_translation_map_cache_;
 
   // a variable used for testing query plan DAG extractor when a query has a table
   // function
@@ -178,6 +178,25 @@ size_t get_available_cpu_threads_per_task(Executor* executor,
   CHECK_GE(available_slots_per_task, 1u);
   return available_slots_per_task;
 }
+
+#ifdef HAVE_TBB
+// Morsels per thread of the pool: enough for threads done with a small fragment to keep
+// pulling work from the larger ones instead of idling at the tail of the step
+constexpr size_t kCpuSubTasksPerThread{4};
+// Smaller morsels don't amortize the cost of launching the compiled kernel
+constexpr size_t kMinCpuSubTaskSize{16'384};
+
+size_t get_cpu_sub_task_size(const size_t num_rows,
+                             SharedKernelContext& shared_context) {
+  const auto num_threads = shared_context.getNumAllocatedThreads();
+  const auto num_kernels = std::max(shared_context.getNumKernels(), size_t(1));
+  const auto sub_tasks_per_kernel =
+      (num_threads * kCpuSubTasksPerThread + num_kernels - 1) / num_kernels;
+  const auto sub_task_size = (num_rows + sub_tasks_per_kernel - 1) / sub_tasks_per_kernel;
+  const auto min_sub_task_size = std::min(kMinCpuSubTaskSize, g_cpu_sub_task_size);
+  return std::min(std::max(sub_task_size, min_sub_task_size), g_cpu_sub_task_size);
+}
+#endif  // HAVE_TBB
 }  // namespace
 
 void ExecutionKernel::runImpl(Executor* executor,
@@ -195,6 +214,12 @@ void ExecutionKernel::runImpl(Executor* executor,
   CHECK_EQ(frag_list[0].table_key, outer_table_key);
   const auto& outer_tab_frag_ids = frag_list[0].fragment_ids;
 
+  const auto top_n_key_threshold = shared_context.getTopNKeyThreshold();
+  if (top_n_key_threshold && top_n_key_threshold->canSkipFragments(outer_tab_frag_ids)) {
+    VLOG(1) << "Skipping fragments ordered after the top n rows found so far.";
+    return;
+  }
+
   CHECK_GE(chosen_device_id, 0);
   CHECK_LT(chosen_device_id, Executor::max_gpu_count);
 
@@ -357,7 +382,7 @@ void ExecutionKernel::runImpl(Executor* executor,
   // result sets. Can we simply do it once and holdin an outer structure?
   if (can_run_subkernels) {
     size_t total_rows = fetch_result->num_rows[0][0];
-    size_t sub_size = g_cpu_sub_task_size;
+    size_t sub_size = get_cpu_sub_task_size(total_rows - start_rowid, shared_context);
 
     for (size_t sub_start = start_rowid; sub_start < total_rows; sub_start += sub_size) {
       sub_size = (sub_start + sub_size > total_rows) ? total_rows - sub_start : sub_size;
@@ -473,6 +498,9 @@ void ExecutionKernel::runImpl(Executor* executor,
   if (err) {
     throw QueryExecutionError(err);
   }
+  if (top_n_key_threshold && device_results_) {
+    top_n_key_threshold->update(*device_results_);
+  }
   shared_context.addDeviceResults(std::move(device_results_), outer_tab_frag_ids);
   executor->logSystemCPUMemoryStatus("After Query Execution", thread_idx);
   if (chosen_device_type == ExecutorDeviceType::GPU) {
@@ -541,8 +569,9 @@ void KernelSubtask::runImpl(Executor* executor) {
           executor->getRowSetMemoryOwner(),
           compilation_result.output_columnar,
           kernel_.query_mem_desc.sortOnGpu(),
-          // TODO: use TBB thread id to choose allocator
-          thread_idx_,
+          // The execution context is thread local, so is its output buffer. The memory
+          // owner has an allocator for every thread of the arena.
+          tbb::this_task_arena::current_thread_index(),
           do_render ? kernel_.render_info_ : nullptr);
     } catch (const OutOfHostMemory& e) {
       throw QueryExecutionError(ErrorCode::OUT_OF_CPU_MEM);
@@ -19,6 +19,7 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
+#include "QueryEngine/StreamingTopN.h"
 
 #include "Shared/threading.h"
 
@@ -55,6 +56,18 @@ class SharedKernelContext {
     return num_allocated_threads_;
   }
 
+  void setNumKernels(size_t num_kernels) { num_kernels_ = num_kernels; }
+
+  size_t getNumKernels() const { return num_kernels_; }
+
+  void setTopNKeyThreshold(std::unique_ptr<streaming_top_n::KeyThreshold> threshold) {
+    top_n_key_threshold_ = std::move(threshold);
+  }
+
+  streaming_top_n::KeyThreshold* getTopNKeyThreshold() const {
+    return top_n_key_threshold_.get();
+  }
+
   std::atomic_flag dynamic_watchdog_set = ATOMIC_FLAG_INIT;
 
 #ifdef HAVE_TBB
@@ -81,6 +94,10 @@ class SharedKernelContext {
   // query execution). After finishing the compilation of the kernel, we will set it to a
   // proper value based on the query's status
   size_t num_allocated_threads_{1};
+  // the # kernels launched for the query step, which share the allocated threads
+  size_t num_kernels_{1};
+  // set for streaming top n queries whose kernels can skip fragments
+  std::unique_ptr<streaming_top_n::KeyThreshold> top_n_key_threshold_;
 
 #ifdef HAVE_TBB
   threading::task_group* task_group_;
@@ -36,6 +36,15 @@ using UpdateTriggeredCacheInvalidator =
                      PerfectJoinHashTable>;
 using DeleteTriggeredCacheInvalidator = UpdateTriggeredCacheInvalidator;
 
+extern bool g_enable_incremental_join_hash_table_maintenance;
+
+// Appending rows keeps the row ids of existing rows, and a cached perfect join hash table
+// compares the row counts of the fragments it was built from before it is reused, so
+// appends leave it in the cache to be extended rather than rebuilt (see
+// PerfectJoinHashTable::markCachedItemAsDirtyOnAppend).
+using AppendTriggeredCacheInvalidator =
+    CacheInvalidator<BoundingBoxIntersectJoinHashTable, BaselineJoinHashTable>;
+
 // Note that this is functionally the same as the above two invalidators. The
 // JoinHashTableCacheInvalidator is a generic invalidator used during `clear_cpu` calls.
 // The above cache invalidators are specific invalidators called during update/delete and
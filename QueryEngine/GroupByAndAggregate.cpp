@@ -23,9 +23,11 @@
 #include "ExpressionRange.h"
 #include "ExpressionRewrite.h"
 #include "GpuInitGroups.h"
+#include "HyperLogLogRank.h"
 #include "InPlaceSort.h"
 #include "LLVMFunctionAttributesUtil.h"
 #include "MaxwellCodegenPatch.h"
+#include "MurmurHash.h"
 #include "OutputBufferInitialization.h"
 #include "TargetExprBuilder.h"
 
@@ -53,7 +55,10 @@
 bool g_cluster{false};
 bool g_bigint_count{false};
 int g_hll_precision_bits{11};
+bool g_enable_sparse_hll{true};
 size_t g_watchdog_baseline_max_groups{120000000};
+bool g_enable_predicated_aggregates{true};
+double g_predicated_aggregates_min_selectivity{0.1};
 extern size_t g_approx_quantile_buffer;
 extern size_t g_approx_quantile_centroids;
 extern int64_t g_bitmap_memory_limit;
@@ -82,6 +87,9 @@ std::ostream& operator<<(std::ostream& out, const CountDistinctImplType& type) {
     case CountDistinctImplType::UnorderedSet:
       out << "UnorderedSet";
       break;
+    case CountDistinctImplType::SparseHll:
+      out << "SparseHll";
+      break;
     default:
       out << "<Unkown Type>";
       break;
@@ -824,6 +832,13 @@ CountDistinctDescriptors init_count_distinct_descriptors(
           !(arg_ti.is_array() || arg_ti.is_geometry())) {
         count_distinct_impl_type = CountDistinctImplType::Bitmap;
       }
+      // dense registers for every group dominate the memory use of grouped queries
+      if (agg_info.agg_kind == kAPPROX_COUNT_DISTINCT &&
+          count_distinct_impl_type == CountDistinctImplType::Bitmap &&
+          g_enable_sparse_hll && !g_cluster && device_type == ExecutorDeviceType::CPU &&
+          group_by_range_info.hash_type_ != QueryDescriptionType::NonGroupedAggregate) {
+        count_distinct_impl_type = CountDistinctImplType::SparseHll;
+      }
       const size_t too_many_entries{100000000};
       if (g_enable_watchdog && !(arg_range_info.isEmpty()) &&
           worst_case_num_groups > too_many_entries &&
@@ -1061,6 +1076,13 @@ bool GroupByAndAggregate::codegen(llvm::Value* filter_result,
     if (executor_->isArchMaxwell(co.device_type)) {
       prependForceSync();
     }
+    agg_predicate_ = nullptr;
+    if (!is_group_by && usePredicatedAggregates(co)) {
+      // Update the aggregates for every row and mask out the rows which fail the
+      // filter, rather than branching on a filter which is hard to predict.
+      agg_predicate_ = filter_result;
+      filter_result = executor_->cgen_state_->llBool(true);
+    }
     DiamondCodegen filter_cfg(filter_result,
                               executor_,
                               !is_group_by || query_mem_desc.usesGetGroupValueFast(),
@@ -1182,6 +1204,36 @@ bool GroupByAndAggregate::codegen(llvm::Value* filter_result,
   return can_return_error;
 }
 
+bool GroupByAndAggregate::usePredicatedAggregates(const CompilationOptions& co) const {
+  if (!g_enable_predicated_aggregates || co.device_type != ExecutorDeviceType::CPU ||
+      !ra_exe_unit_.groupby_exprs.empty() || ra_exe_unit_.estimator ||
+      !ra_exe_unit_.join_quals.empty() || ra_exe_unit_.input_descs.size() != 1 ||
+      (ra_exe_unit_.simple_quals.empty() && ra_exe_unit_.quals.empty())) {
+    return false;
+  }
+  for (const auto target_expr : ra_exe_unit_.target_exprs) {
+    const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+    if (!agg_expr || agg_expr->get_is_distinct() ||
+        !shared::is_any<kCOUNT, kSUM, kAVG, kMIN, kMAX>(agg_expr->get_aggtype())) {
+      return false;
+    }
+    // The argument is evaluated for the rows which fail the filter as well, so it must
+    // be a plain column read which can neither fail nor have side effects.
+    const auto arg_expr = agg_expr->get_arg();
+    if (arg_expr) {
+      const auto& arg_ti = arg_expr->get_type_info();
+      if (!dynamic_cast<const Analyzer::ColumnVar*>(arg_expr) ||
+          !(arg_ti.is_number() || arg_ti.is_time() || arg_ti.is_boolean())) {
+        return false;
+      }
+    }
+  }
+  // Very selective filters are cheaper with a branch, which is well predicted and
+  // skips the aggregate arguments of the rows filtered out.
+  return CodeGenerator::getExpectedSelectivity(ra_exe_unit_) >=
+         g_predicated_aggregates_min_selectivity;
+}
+
 llvm::Value* GroupByAndAggregate::codegenOutputSlot(
     llvm::Value* groups_buffer,
     const QueryMemoryDescriptor& query_mem_desc,
@@ -1867,6 +1919,15 @@ extern "C" RUNTIME_EXPORT void agg_count_distinct_skip_val(int64_t* agg,
   }
 }
 
+extern "C" RUNTIME_EXPORT void agg_approximate_count_distinct_sparse(int64_t* agg,
+                                                                     const int64_t key,
+                                                                     const uint32_t b) {
+  const uint64_t hash = MurmurHash64A(&key, sizeof(key), 0);
+  const uint32_t index = hash >> (64 - b);
+  const uint8_t rank = get_rank(hash << b, 64 - b);
+  reinterpret_cast<SparseHll*>(*agg)->update(index, rank);
+}
+
 extern "C" RUNTIME_EXPORT void agg_approx_quantile(int64_t* agg, const double val) {
   auto* t_digest = reinterpret_cast<quantile::TDigest*>(*agg);
   t_digest->allocate();
@@ -1896,8 +1957,15 @@ void GroupByAndAggregate::codegenCountDistinct(
       query_mem_desc.getCountDistinctDescriptor(target_idx);
   CHECK(count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid);
   if (agg_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
-    CHECK(count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap);
     agg_args.push_back(LL_INT(int32_t(count_distinct_descriptor.bitmap_sz_bits)));
+    if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::SparseHll) {
+      CHECK(device_type == ExecutorDeviceType::CPU);
+      executor_->cgen_state_->emitExternalCall("agg_approximate_count_distinct_sparse",
+                                               llvm::Type::getVoidTy(LL_CONTEXT),
+                                               agg_args);
+      return;
+    }
+    CHECK(count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap);
     if (device_type == ExecutorDeviceType::GPU) {
       const auto base_dev_addr = getAdditionalLiteral(-1);
       const auto base_host_addr = getAdditionalLiteral(-2);
@@ -101,6 +101,8 @@ class GroupByAndAggregate {
   int64_t getShardedTopBucket(const ColRangeInfo& col_range_info,
                               const size_t shard_count) const;
 
+  bool usePredicatedAggregates(const CompilationOptions& co) const;
+
   llvm::Value* codegenOutputSlot(llvm::Value* groups_buffer,
                                  const QueryMemoryDescriptor& query_mem_desc,
                                  const CompilationOptions& co,
@@ -215,6 +217,8 @@ class GroupByAndAggregate {
   const ExecutorDeviceType device_type_;
 
   const std::optional<int64_t> group_cardinality_estimation_;
+  // when set, aggregates are updated for every row and this filter masks their inputs
+  llvm::Value* agg_predicate_{nullptr};
 
   friend class Executor;
   friend class QueryMemoryDescriptor;
@@ -25,7 +25,10 @@
 
 #include "Descriptors/CountDistinctDescriptor.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <vector>
 
 inline double get_alpha(const size_t m) {
   switch (m) {
@@ -62,15 +65,15 @@ inline double get_harmonic_mean_denominator(T* M, uint32_t m) {
   return accumulator;
 }
 
-template <typename T>
-inline double get_beta_adjusted_estimate(const size_t m, const uint32_t z, T* M) {
-  return (get_alpha(m) * m * (m - z) *
-          (1 / (get_beta(z) + get_harmonic_mean_denominator(M, m))));
+inline double get_beta_adjusted_estimate(const size_t m,
+                                         const uint32_t z,
+                                         const double harmonic_mean_denominator) {
+  return (get_alpha(m) * m * (m - z) * (1 / (get_beta(z) + harmonic_mean_denominator)));
 }
 
-template <typename T>
-inline double get_alpha_adjusted_estimate(const size_t m, T* M) {
-  return (get_alpha(m) * m * m) * (1 / get_harmonic_mean_denominator(M, m));
+inline double get_alpha_adjusted_estimate(const size_t m,
+                                          const double harmonic_mean_denominator) {
+  return (get_alpha(m) * m * m) * (1 / harmonic_mean_denominator);
 };
 
 template <typename T>
@@ -84,25 +87,34 @@ inline uint32_t count_zeros(T* M, size_t m) {
   return zeros;
 }
 
-template <class T>
-inline size_t hll_size(const T* M, const size_t bitmap_sz_bits) {
+// Estimates the cardinality from the number of zero registers and the sum of 2^-M[i]
+// over all the registers, which is all the dense and the sparse representations share.
+inline size_t hll_size_from_summary(const size_t bitmap_sz_bits,
+                                    const uint32_t zeros,
+                                    const double harmonic_mean_denominator) {
   size_t const m = size_t(1) << bitmap_sz_bits;
 
-  uint32_t zeros = count_zeros(M, m);
-  double estimate = get_alpha_adjusted_estimate(m, M);
+  double estimate = get_alpha_adjusted_estimate(m, harmonic_mean_denominator);
   if (estimate <= 2.5 * m) {
     if (zeros != 0) {
       estimate = m * log(static_cast<double>(m) / zeros);
     }
   } else {
     if (bitmap_sz_bits == 14) {  // Apply LogLog-Beta adjustment only when p=14
-      estimate = get_beta_adjusted_estimate(m, zeros, M);
+      estimate = get_beta_adjusted_estimate(m, zeros, harmonic_mean_denominator);
     }
   }
   // No correction for large estimates since we're using 64-bit hashes.
   return estimate;
 }
 
+template <class T>
+inline size_t hll_size(const T* M, const size_t bitmap_sz_bits) {
+  size_t const m = size_t(1) << bitmap_sz_bits;
+  return hll_size_from_summary(
+      bitmap_sz_bits, count_zeros(M, m), get_harmonic_mean_denominator(M, m));
+}
+
 template <class T1, class T2>
 inline void hll_unify(T1* lhs, T2* rhs, const size_t m) {
   for (size_t r = 0; r < m; ++r) {
@@ -110,6 +122,135 @@ inline void hll_unify(T1* lhs, T2* rhs, const size_t m) {
   }
 }
 
+/**
+ * HyperLogLog record which only keeps its non-zero registers, as (index << 8 | rank)
+ * words sorted by register index, until they would take a quarter of the dense
+ * registers. It then switches to the dense registers for good. Groups seeing a few
+ * values take a few bytes instead of 1 << b bytes each. The register bytes of all the
+ * records of a query add up in memory_usage, checked against g_bitmap_memory_limit.
+ */
+class SparseHll {
+ public:
+  SparseHll(const uint32_t b, std::atomic<int64_t>* memory_usage)
+      : b_(b), memory_usage_(memory_usage) {}
+
+  SparseHll(SparseHll&&) = default;
+
+  SparseHll& operator=(const SparseHll& that) {
+    CHECK_EQ(b_, that.b_);
+    const auto register_bytes = registerBytes();
+    sparse_ = that.sparse_;
+    dense_ = that.dense_;
+    trackRegisterBytes(register_bytes);
+    return *this;
+  }
+
+  void update(const uint32_t index, const uint8_t rank) {
+    if (isDense()) {
+      dense_[index] = std::max(dense_[index], rank);
+      return;
+    }
+    const uint32_t entry = (index << 8) | rank;
+    auto it = std::lower_bound(sparse_.begin(), sparse_.end(), index << 8);
+    if (it != sparse_.end() && (*it >> 8) == index) {
+      *it = std::max(*it, entry);
+      return;
+    }
+    const auto register_bytes = registerBytes();
+    sparse_.insert(it, entry);
+    if (sparse_.size() > maxSparseSize()) {
+      toDense();
+    }
+    trackRegisterBytes(register_bytes);
+  }
+
+  void merge(const SparseHll& that) {
+    CHECK_EQ(b_, that.b_);
+    const auto register_bytes = registerBytes();
+    mergeRegisters(that);
+    trackRegisterBytes(register_bytes);
+  }
+
+  size_t cardinality() const {
+    if (isDense()) {
+      return hll_size(dense_.data(), b_);
+    }
+    const uint32_t zeros = (uint32_t(1) << b_) - sparse_.size();
+    double harmonic_mean_denominator = zeros;
+    for (const auto entry : sparse_) {
+      harmonic_mean_denominator += 1.0 / (1ULL << (entry & 0xff));
+    }
+    return hll_size_from_summary(b_, zeros, harmonic_mean_denominator);
+  }
+
+  bool isDense() const { return !dense_.empty(); }
+
+ private:
+  size_t maxSparseSize() const { return (size_t(1) << b_) / (4 * sizeof(uint32_t)); }
+
+  size_t registerBytes() const {
+    return sparse_.capacity() * sizeof(uint32_t) + dense_.capacity();
+  }
+
+  void trackRegisterBytes(const size_t old_register_bytes) {
+    const auto register_bytes = registerBytes();
+    if (memory_usage_ && register_bytes != old_register_bytes) {
+      memory_usage_->fetch_add(static_cast<int64_t>(register_bytes) -
+                                   static_cast<int64_t>(old_register_bytes),
+                               std::memory_order_relaxed);
+    }
+  }
+
+  void mergeRegisters(const SparseHll& that) {
+    if (that.isDense()) {
+      toDense();
+      for (size_t i = 0; i < dense_.size(); ++i) {
+        dense_[i] = std::max(dense_[i], that.dense_[i]);
+      }
+      return;
+    }
+    if (isDense()) {
+      for (const auto entry : that.sparse_) {
+        update(entry >> 8, entry & 0xff);
+      }
+      return;
+    }
+    std::vector<uint32_t> merged;
+    merged.reserve(sparse_.size() + that.sparse_.size());
+    auto lhs = sparse_.begin();
+    auto rhs = that.sparse_.begin();
+    while (lhs != sparse_.end() && rhs != that.sparse_.end()) {
+      if ((*lhs >> 8) == (*rhs >> 8)) {
+        merged.push_back(std::max(*lhs++, *rhs++));
+      } else {
+        merged.push_back(*lhs < *rhs ? *lhs++ : *rhs++);
+      }
+    }
+    merged.insert(merged.end(), lhs, sparse_.end());
+    merged.insert(merged.end(), rhs, that.sparse_.end());
+    sparse_ = std::move(merged);
+    if (sparse_.size() > maxSparseSize()) {
+      toDense();
+    }
+  }
+
+  void toDense() {
+    if (isDense()) {
+      return;
+    }
+    dense_.resize(size_t(1) << b_, 0);
+    for (const auto entry : sparse_) {
+      dense_[entry >> 8] = entry & 0xff;
+    }
+    std::vector<uint32_t>().swap(sparse_);
+  }
+
+  uint32_t b_;
+  std::vector<uint32_t> sparse_;
+  std::vector<uint8_t> dense_;
+  std::atomic<int64_t>* memory_usage_;
+};
+
 inline int hll_size_for_rate(const int err_percent) {
   double err_rate{static_cast<double>(err_percent) / 100.0};
   double k = ceil(2 * log2(1.04 / err_rate));
@@ -119,5 +260,6 @@ inline int hll_size_for_rate(const int err_percent) {
 }
 
 extern int g_hll_precision_bits;
+extern bool g_enable_sparse_hll;
 
 #endif  // QUERYENGINE_HYPERLOGLOG_H
@@ -16,6 +16,7 @@
 
 #include "../Parser/ParserNode.h"
 #include "CodeGenerator.h"
+#include "CodegenHelper.h"
 #include "Execute.h"
 #include "ExternalExecutor.h"
 #include "MaxwellCodegenPatch.h"
@@ -866,7 +867,9 @@ JoinLoop::HoistedFiltersCallback Executor::buildHoistLeftHandSideFiltersCb(
   }
 
   const auto& current_level_join_conditions = ra_exe_unit.join_quals[level_idx];
-  if (level_idx == 0 && current_level_join_conditions.type == JoinType::LEFT) {
+  // a FULL outer join must see every outer row to flag the inner rows it matches
+  if (level_idx == 0 && current_level_join_conditions.type == JoinType::LEFT &&
+      !current_level_join_conditions.matched_inner_rows) {
     const auto& condition = current_level_join_conditions.quals.front();
     const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(condition.get());
     CHECK(bin_oper) << condition->toString();
@@ -1314,6 +1317,8 @@ void Executor::codegenJoinLoops(const std::vector<JoinLoop>& join_loops,
                     llvm::BasicBlock::Create(builder.getContext(),
                                              "loop_body",
                                              builder.GetInsertBlock()->getParent());
+                const auto body_entry_bb =
+                    codegenMarkMatchedInnerRows(ra_exe_unit, loop_body_bb, co);
                 builder.SetInsertPoint(loop_body_bb);
                 const bool can_return_error =
                     compileBody(ra_exe_unit, group_by_and_aggregate, query_mem_desc, co);
@@ -1326,7 +1331,7 @@ void Executor::codegenJoinLoops(const std::vector<JoinLoop>& join_loops,
                                               co.device_type,
                                               group_by_and_aggregate.query_infos_);
                 }
-                return loop_body_bb;
+                return body_entry_bb;
               },
               prev_iters.back(),
               body_exit_bb,
@@ -1358,6 +1363,8 @@ void Executor::codegenJoinLoops(const std::vector<JoinLoop>& join_loops,
           auto& builder = cgen_state_->ir_builder_;
           const auto loop_body_bb = llvm::BasicBlock::Create(
               builder.getContext(), "loop_body", builder.GetInsertBlock()->getParent());
+          const auto body_entry_bb =
+              codegenMarkMatchedInnerRows(ra_exe_unit, loop_body_bb, co);
           builder.SetInsertPoint(loop_body_bb);
           const bool can_return_error =
               compileBody(ra_exe_unit, group_by_and_aggregate, query_mem_desc, co);
@@ -1370,7 +1377,7 @@ void Executor::codegenJoinLoops(const std::vector<JoinLoop>& join_loops,
                                         co.device_type,
                                         group_by_and_aggregate.query_infos_);
           }
-          return loop_body_bb;
+          return body_entry_bb;
         },
         /*outer_iter=*/code_generator.posArg(nullptr),
         exit_bb,
@@ -1381,6 +1388,68 @@ void Executor::codegenJoinLoops(const std::vector<JoinLoop>& join_loops,
   cgen_state_->ir_builder_.CreateBr(loops_entry_bb);
 }
 
+llvm::BasicBlock* Executor::codegenMarkMatchedInnerRows(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    llvm::BasicBlock* loop_body_bb,
+    const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_.get());
+  if (std::none_of(ra_exe_unit.join_quals.begin(),
+                   ra_exe_unit.join_quals.end(),
+                   [](const JoinCondition& join_condition) {
+                     return join_condition.matched_inner_rows != nullptr;
+                   })) {
+    return loop_body_bb;
+  }
+  CHECK(co.device_type == ExecutorDeviceType::CPU);
+  auto& builder = cgen_state_->ir_builder_;
+  const auto mark_entry_bb = llvm::BasicBlock::Create(
+      cgen_state_->context_, "mark_matched_inner_rows", cgen_state_->current_func_);
+  builder.SetInsertPoint(mark_entry_bb);
+  CodeGenerator code_generator(this);
+  for (size_t level_idx = 0; level_idx < ra_exe_unit.join_quals.size(); ++level_idx) {
+    const auto& matched_inner_rows = ra_exe_unit.join_quals[level_idx].matched_inner_rows;
+    if (!matched_inner_rows) {
+      continue;
+    }
+    CHECK_LT(level_idx, cgen_state_->outer_join_match_found_per_level_.size());
+    const auto match_found_lv = cgen_state_->outer_join_match_found_per_level_[level_idx];
+    CHECK(match_found_lv);
+    const auto mark_bb = llvm::BasicBlock::Create(
+        cgen_state_->context_, "mark_matched_inner_row", cgen_state_->current_func_);
+    const auto marked_bb = llvm::BasicBlock::Create(
+        cgen_state_->context_, "matched_inner_row_marked", cgen_state_->current_func_);
+    builder.CreateCondBr(match_found_lv, mark_bb, marked_bb);
+    builder.SetInsertPoint(mark_bb);
+    // the join loop iterates on the position of the row in the inner table
+    CHECK_LT(level_idx + 1, ra_exe_unit.input_descs.size());
+    const auto& inner_table_key = ra_exe_unit.input_descs[level_idx + 1].getTableKey();
+    const Analyzer::ColumnVar inner_col_var(
+        SQLTypeInfo(kBIGINT, true),
+        shared::ColumnKey{inner_table_key.db_id, inner_table_key.table_id, 0},
+        level_idx + 1);
+    const auto inner_pos_lv = code_generator.posArg(&inner_col_var);
+    const auto matched_inner_rows_lv = CodegenUtil::createPtrWithHoistedMemoryAddr(
+                                           cgen_state_.get(),
+                                           &code_generator,
+                                           co,
+                                           cgen_state_->llInt(reinterpret_cast<int64_t>(
+                                               matched_inner_rows->data())),
+                                           llvm::PointerType::get(
+                                               get_int_type(8, cgen_state_->context_), 0),
+                                           1)
+                                           .front();
+    // the flags only ever go from 0 to 1, the kernels can set them concurrently
+    builder.CreateStore(
+        cgen_state_->llInt(int8_t(1)),
+        builder.CreateGEP(
+            get_int_type(8, cgen_state_->context_), matched_inner_rows_lv, inner_pos_lv));
+    builder.CreateBr(marked_bb);
+    builder.SetInsertPoint(marked_bb);
+  }
+  builder.CreateBr(loop_body_bb);
+  return mark_entry_bb;
+}
+
 Executor::GroupColLLVMValue Executor::groupByColumnCodegen(
     Analyzer::Expr* group_by_col,
     const size_t col_width,
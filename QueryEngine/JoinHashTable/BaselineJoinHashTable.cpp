@@ -18,6 +18,10 @@
 
 #include <future>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif  // _WIN32
+
 #include "DataMgr/Allocators/CudaAllocator.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/ColumnFetcher.h"
@@ -37,6 +41,50 @@ std::unique_ptr<HashtableRecycler> BaselineJoinHashTable::hash_table_cache_ =
 std::unique_ptr<HashingSchemeRecycler> BaselineJoinHashTable::hash_table_layout_cache_ =
     std::make_unique<HashingSchemeRecycler>();
 
+bool g_enable_radix_partitioned_hash_join_build{true};
+// 0 derives the threshold from the size of the last level cache
+size_t g_radix_partitioned_hash_join_build_threshold{0};
+
+namespace {
+
+size_t get_llc_size_in_bytes() {
+  constexpr size_t kDefaultLlcSize{32 * 1024 * 1024};
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  static const auto llc_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  return llc_size > 0 ? static_cast<size_t>(llc_size) : kDefaultLlcSize;
+#else
+  return kDefaultLlcSize;
+#endif
+}
+
+}  // namespace
+
+size_t get_baseline_hash_table_partition_count(const size_t hash_table_size,
+                                               const int thread_count) {
+  if (!g_enable_radix_partitioned_hash_join_build) {
+    return 0;
+  }
+  const auto llc_size = get_llc_size_in_bytes();
+  const auto threshold = g_radix_partitioned_hash_join_build_threshold
+                             ? g_radix_partitioned_hash_join_build_threshold
+                             : llc_size;
+  if (hash_table_size <= threshold) {
+    return 0;
+  }
+  // every thread should insert into its own share of the last level cache at a time
+  constexpr size_t kMinPartitionSize{256 * 1024};
+  constexpr size_t kMaxPartitionCount{4096};
+  const auto partition_size =
+      std::max(llc_size / std::max(thread_count, 1), kMinPartitionSize);
+  size_t partition_count{1};
+  while (partition_count < kMaxPartitionCount &&
+         partition_count * partition_size < hash_table_size) {
+    partition_count *= 2;
+  }
+  // a single partition would only add the scatter pass to the build
+  return partition_count > 1 ? partition_count : 0;
+}
+
 //! Make hash table from an in-flight SQL query's parse tree etc.
 std::shared_ptr<BaselineJoinHashTable> BaselineJoinHashTable::getInstance(
     const std::shared_ptr<Analyzer::BinOper> condition,
@@ -22,8 +22,17 @@
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinKeyHandlers.h"
 #include "QueryEngine/JoinHashTable/Runtime/JoinHashTableGpuUtils.h"
 #include "QueryEngine/QueryEngine.h"
+#include "Shared/scope.h"
 #include "Shared/thread_count.h"
 
+extern bool g_enable_radix_partitioned_hash_join_build;
+extern size_t g_radix_partitioned_hash_join_build_threshold;
+
+// Returns the number of partitions to build a CPU baseline hash table of the given size
+// with, 0 if it should be built without partitioning the input.
+size_t get_baseline_hash_table_partition_count(const size_t hash_table_size,
+                                               const int thread_count);
+
 template <typename SIZE,
           class KEY_HANDLER,
           typename std::enable_if<sizeof(SIZE) == 4, SIZE>::type* = nullptr>
@@ -124,6 +133,66 @@ int fill_baseline_hash_join_buff(int8_t* hash_buff,
   }
 }
 
+template <typename SIZE,
+          class KEY_HANDLER,
+          typename std::enable_if<sizeof(SIZE) == 4, SIZE>::type* = nullptr>
+int fill_baseline_hash_join_buff_partitioned(int8_t* hash_buff,
+                                             const size_t entry_count,
+                                             const int32_t invalid_slot_val,
+                                             const bool for_semi_join,
+                                             const size_t key_component_count,
+                                             const bool with_val_slot,
+                                             const KEY_HANDLER* key_handler,
+                                             int8_t* partition_buff,
+                                             const size_t partition_count,
+                                             const int32_t cpu_thread_count) {
+  if constexpr (std::is_same<KEY_HANDLER, GenericKeyHandler>::value) {
+    return fill_baseline_hash_join_buff_partitioned_32(hash_buff,
+                                                       entry_count,
+                                                       invalid_slot_val,
+                                                       for_semi_join,
+                                                       key_component_count,
+                                                       with_val_slot,
+                                                       key_handler,
+                                                       partition_buff,
+                                                       partition_count,
+                                                       cpu_thread_count);
+  } else {
+    UNREACHABLE() << "Radix partitioned build requires a generic key handler";
+    return -1;
+  }
+}
+
+template <typename SIZE,
+          class KEY_HANDLER,
+          typename std::enable_if<sizeof(SIZE) == 8, SIZE>::type* = nullptr>
+int fill_baseline_hash_join_buff_partitioned(int8_t* hash_buff,
+                                             const size_t entry_count,
+                                             const int32_t invalid_slot_val,
+                                             const bool for_semi_join,
+                                             const size_t key_component_count,
+                                             const bool with_val_slot,
+                                             const KEY_HANDLER* key_handler,
+                                             int8_t* partition_buff,
+                                             const size_t partition_count,
+                                             const int32_t cpu_thread_count) {
+  if constexpr (std::is_same<KEY_HANDLER, GenericKeyHandler>::value) {
+    return fill_baseline_hash_join_buff_partitioned_64(hash_buff,
+                                                       entry_count,
+                                                       invalid_slot_val,
+                                                       for_semi_join,
+                                                       key_component_count,
+                                                       with_val_slot,
+                                                       key_handler,
+                                                       partition_buff,
+                                                       partition_count,
+                                                       cpu_thread_count);
+  } else {
+    UNREACHABLE() << "Radix partitioned build requires a generic key handler";
+    return -1;
+  }
+}
+
 template <typename SIZE,
           class KEY_HANDLER,
           typename std::enable_if<sizeof(SIZE) == 4, SIZE>::type* = nullptr>
@@ -357,61 +426,113 @@ class BaselineJoinHashTableBuilder {
       }
 #endif  // !HAVE_TBB
     }
-    std::vector<std::future<int>> fill_cpu_buff_threads;
     auto timer_fill = DEBUG_TIMER("Fill CPU Baseline Join Hash Table");
-    for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
-      fill_cpu_buff_threads.emplace_back(std::async(
-          std::launch::async,
-          [key_handler,
-           &join_columns,
-           hash_table_entry_info,
-           thread_idx,
-           cpu_hash_table_ptr,
-           thread_count,
-           for_semi_join,
-           hash_table_layout,
-           parent_thread_local_ids = logger::thread_local_ids()] {
-            logger::LocalIdsScopeGuard lisg = parent_thread_local_ids.setNewThreadId();
-            DEBUG_TIMER_NEW_THREAD(parent_thread_local_ids.thread_id_);
-            switch (hash_table_entry_info.getJoinKeysSize()) {
-              case 4: {
-                return fill_baseline_hash_join_buff<int32_t>(
-                    cpu_hash_table_ptr,
-                    hash_table_entry_info.getNumHashEntries(),
-                    -1,
-                    for_semi_join,
-                    hash_table_entry_info.getNumJoinKeys(),
-                    hash_table_layout == HashType::OneToOne,
-                    key_handler,
-                    join_columns[0].num_elems,
-                    thread_idx,
-                    thread_count);
-              }
-              case 8: {
-                return fill_baseline_hash_join_buff<int64_t>(
-                    cpu_hash_table_ptr,
-                    hash_table_entry_info.getNumHashEntries(),
-                    -1,
-                    for_semi_join,
-                    hash_table_entry_info.getNumJoinKeys(),
-                    hash_table_layout == HashType::OneToOne,
-                    key_handler,
-                    join_columns[0].num_elems,
-                    thread_idx,
-                    thread_count);
-              }
-              default:
-                UNREACHABLE() << "Unexpected hash join key size: "
-                              << hash_table_entry_info.getJoinKeysSize();
-            }
-            return -1;
-          }));
-    }
     int err = 0;
-    for (auto& child : fill_cpu_buff_threads) {
-      int partial_err = child.get();
-      if (partial_err) {
-        err = partial_err;
+    const size_t partition_count =
+        std::is_same_v<KEY_HANDLER, GenericKeyHandler>
+            ? get_baseline_hash_table_partition_count(hash_table_size, thread_count)
+            : 0;
+    if (partition_count) {
+      // a (row id, home slot, key) record per row, allocated from the CPU buffer pool so
+      // that the scratch space counts against the memory of the server
+      const size_t partition_buff_size = join_columns[0].num_elems *
+                                         (hash_table_entry_info.getNumJoinKeys() + 2) *
+                                         hash_table_entry_info.getJoinKeysSize();
+      VLOG(1) << "Filling a baseline hash table of " << hash_table_size
+              << " bytes from " << partition_count << " radix partitions of "
+              << partition_buff_size << " bytes";
+      auto data_mgr = executor->getDataMgr();
+      auto partition_buff =
+          data_mgr->alloc(Data_Namespace::CPU_LEVEL, 0, partition_buff_size);
+      ScopeGuard free_partition_buff = [data_mgr, partition_buff] {
+        data_mgr->free(partition_buff);
+      };
+      switch (hash_table_entry_info.getJoinKeysSize()) {
+        case 4:
+          err = fill_baseline_hash_join_buff_partitioned<int32_t>(
+              cpu_hash_table_ptr,
+              hash_table_entry_info.getNumHashEntries(),
+              -1,
+              for_semi_join,
+              hash_table_entry_info.getNumJoinKeys(),
+              hash_table_layout == HashType::OneToOne,
+              key_handler,
+              partition_buff->getMemoryPtr(),
+              partition_count,
+              thread_count);
+          break;
+        case 8:
+          err = fill_baseline_hash_join_buff_partitioned<int64_t>(
+              cpu_hash_table_ptr,
+              hash_table_entry_info.getNumHashEntries(),
+              -1,
+              for_semi_join,
+              hash_table_entry_info.getNumJoinKeys(),
+              hash_table_layout == HashType::OneToOne,
+              key_handler,
+              partition_buff->getMemoryPtr(),
+              partition_count,
+              thread_count);
+          break;
+        default:
+          UNREACHABLE() << "Unexpected hash join key size: "
+                        << hash_table_entry_info.getJoinKeysSize();
+      }
+    } else {
+      std::vector<std::future<int>> fill_cpu_buff_threads;
+      for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        fill_cpu_buff_threads.emplace_back(std::async(
+            std::launch::async,
+            [key_handler,
+             &join_columns,
+             hash_table_entry_info,
+             thread_idx,
+             cpu_hash_table_ptr,
+             thread_count,
+             for_semi_join,
+             hash_table_layout,
+             parent_thread_local_ids = logger::thread_local_ids()] {
+              logger::LocalIdsScopeGuard lisg = parent_thread_local_ids.setNewThreadId();
+              DEBUG_TIMER_NEW_THREAD(parent_thread_local_ids.thread_id_);
+              switch (hash_table_entry_info.getJoinKeysSize()) {
+                case 4: {
+                  return fill_baseline_hash_join_buff<int32_t>(
+                      cpu_hash_table_ptr,
+                      hash_table_entry_info.getNumHashEntries(),
+                      -1,
+                      for_semi_join,
+                      hash_table_entry_info.getNumJoinKeys(),
+                      hash_table_layout == HashType::OneToOne,
+                      key_handler,
+                      join_columns[0].num_elems,
+                      thread_idx,
+                      thread_count);
+                }
+                case 8: {
+                  return fill_baseline_hash_join_buff<int64_t>(
+                      cpu_hash_table_ptr,
+                      hash_table_entry_info.getNumHashEntries(),
+                      -1,
+                      for_semi_join,
+                      hash_table_entry_info.getNumJoinKeys(),
+                      hash_table_layout == HashType::OneToOne,
+                      key_handler,
+                      join_columns[0].num_elems,
+                      thread_idx,
+                      thread_count);
+                }
+                default:
+                  UNREACHABLE() << "Unexpected hash join key size: "
+                                << hash_table_entry_info.getJoinKeysSize();
+              }
+              return -1;
+            }));
+      }
+      for (auto& child : fill_cpu_buff_threads) {
+        int partial_err = child.get();
+        if (partial_err) {
+          err = partial_err;
+        }
       }
     }
     if (err) {
@@ -360,6 +360,133 @@ class PerfectJoinHashTableBuilder {
     hash_table_fill_func(args, thread_count);
   }
 
+  // builds a copy of the given cached one-to-one hash table that also covers the rows
+  // appended to its input after it was built; rows are only ever appended after the
+  // ones the cached hash table covers, so their row ids never clash with the cached ones
+  void appendToOneToOneHashTableOnCpu(
+      PerfectHashTable* cached_hash_table,
+      const JoinColumn& join_column,
+      const ExpressionRange& col_range,
+      const bool is_bitwise_eq,
+      const InnerOuter& cols,
+      const StringDictionaryProxy::IdMap* str_proxy_translation_map,
+      const JoinType join_type,
+      const BucketizedHashEntryInfo hash_entry_info,
+      const PerfectHashTableEntryInfo hash_table_entry_info,
+      const int32_t hash_join_invalid_val) {
+    auto timer = DEBUG_TIMER(__func__);
+    CHECK(cached_hash_table);
+    const auto num_cached_rows = cached_hash_table->getColumnNumElems();
+    CHECK_LT(num_cached_rows, join_column.num_elems);
+    const auto inner_col = cols.first;
+    CHECK(inner_col);
+    const auto& ti = inner_col->get_type_info();
+    CHECK(!hash_table_);
+    hash_table_ = std::make_unique<PerfectHashTable>(ExecutorDeviceType::CPU,
+                                                     hash_table_entry_info);
+    auto const hash_table_size =
+        hash_table_->getHashTableBufferSize(ExecutorDeviceType::CPU);
+    CHECK_EQ(cached_hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU),
+             hash_table_size);
+    auto cpu_hash_table_buff = reinterpret_cast<int32_t*>(hash_table_->getCpuBuffer());
+    memcpy(cpu_hash_table_buff, cached_hash_table->getCpuBuffer(), hash_table_size);
+    auto const for_semi_join = for_semi_anti_join(join_type);
+    auto const use_bucketization = inner_col->get_type_info().get_type() == kDATE;
+    auto translated_null_val = col_range.getIntMax() + 1;
+    if (col_range.getIntMax() < col_range.getIntMin()) {
+      translated_null_val = col_range.getIntMin() - 1;
+    }
+    JoinColumnTypeInfo type_info{static_cast<size_t>(ti.get_size()),
+                                 col_range.getIntMin(),
+                                 col_range.getIntMax(),
+                                 inline_fixed_encoding_null_val(ti),
+                                 is_bitwise_eq,
+                                 translated_null_val,
+                                 get_join_column_type_kind(ti)};
+    OneToOnePerfectJoinHashTableFillFuncArgs args{
+        cpu_hash_table_buff,
+        nullptr,
+        hash_join_invalid_val,
+        for_semi_join,
+        join_column,
+        type_info,
+        str_proxy_translation_map ? str_proxy_translation_map->data() : nullptr,
+        str_proxy_translation_map ? str_proxy_translation_map->domainStart()
+                                  : 0,  // 0 is dummy value
+        hash_entry_info.bucket_normalization};
+    decltype(&fill_hash_join_buff) const hash_table_fill_func =
+        use_bucketization      ? fill_hash_join_buff_bucketized
+        : type_info.uses_bw_eq ? fill_hash_join_buff_bitwise_eq
+                               : fill_hash_join_buff;
+    // a single slice starting at the first appended row visits the appended rows only
+    if (hash_table_fill_func(args, static_cast<int32_t>(num_cached_rows), 1)) {
+      // an appended row duplicates a key, so we need a 1:many table
+      hash_table_ = nullptr;
+      throw NeedsOneToManyHash();
+    }
+  }
+
+  // same as above for a one-to-many hash table, whose row id lists are laid out again
+  // to make room for the appended rows
+  void appendToOneToManyHashTableOnCpu(
+      PerfectHashTable* cached_hash_table,
+      const JoinColumn& join_column,
+      const ExpressionRange& col_range,
+      const bool is_bitwise_eq,
+      const InnerOuter& cols,
+      const StringDictionaryProxy::IdMap* str_proxy_translation_map,
+      const JoinType join_type,
+      const BucketizedHashEntryInfo hash_entry_info,
+      const PerfectHashTableEntryInfo hash_table_entry_info,
+      const int32_t hash_join_invalid_val) {
+    auto timer = DEBUG_TIMER(__func__);
+    CHECK(cached_hash_table);
+    CHECK(join_type != JoinType::WINDOW_FUNCTION_FRAMING);
+    const auto num_cached_rows = cached_hash_table->getColumnNumElems();
+    CHECK_LT(num_cached_rows, join_column.num_elems);
+    const auto inner_col = cols.first;
+    CHECK(inner_col);
+    const auto& ti = inner_col->get_type_info();
+    CHECK(!hash_table_);
+    hash_table_ = std::make_unique<PerfectHashTable>(ExecutorDeviceType::CPU,
+                                                     hash_table_entry_info);
+    auto cpu_hash_table_buff = reinterpret_cast<int32_t*>(hash_table_->getCpuBuffer());
+    init_hash_join_buff(cpu_hash_table_buff,
+                        hash_entry_info.getNormalizedHashEntryCount(),
+                        hash_join_invalid_val,
+                        0,
+                        1);
+    auto const use_bucketization = inner_col->get_type_info().get_type() == kDATE;
+    auto translated_null_val = col_range.getIntMax() + 1;
+    if (col_range.getIntMax() < col_range.getIntMin()) {
+      translated_null_val = col_range.getIntMin() - 1;
+    }
+    JoinColumnTypeInfo type_info{static_cast<size_t>(ti.get_size()),
+                                 col_range.getIntMin(),
+                                 col_range.getIntMax(),
+                                 inline_fixed_encoding_null_val(ti),
+                                 is_bitwise_eq,
+                                 translated_null_val,
+                                 get_join_column_type_kind(ti)};
+    OneToManyPerfectJoinHashTableFillFuncArgs args{
+        cpu_hash_table_buff,
+        hash_entry_info,
+        join_column,
+        type_info,
+        str_proxy_translation_map ? str_proxy_translation_map->data() : nullptr,
+        str_proxy_translation_map ? str_proxy_translation_map->domainStart()
+                                  : 0 /*dummy*/,
+        hash_entry_info.bucket_normalization,
+        false};
+    decltype(&append_to_one_to_many_hash_table) const hash_table_append_func =
+        use_bucketization ? append_to_one_to_many_hash_table_bucketized
+                          : append_to_one_to_many_hash_table;
+    hash_table_append_func(
+        args,
+        reinterpret_cast<const int32_t*>(cached_hash_table->getCpuBuffer()),
+        num_cached_rows);
+  }
+
   std::unique_ptr<PerfectHashTable> getHashTable() {
     return std::move(hash_table_);
   }
@@ -207,6 +207,12 @@ class HashJoin {
 
   virtual bool isBitwiseEq() const = 0;
 
+  // Simple quals on the outer (probe) side column implied by the keys this hash table
+  // was built from, used to skip outer fragments which cannot produce a match.
+  virtual std::list<std::shared_ptr<Analyzer::Expr>> getRuntimeFilterQuals() const {
+    return {};
+  }
+
   JoinColumn fetchJoinColumn(
       const Analyzer::ColumnVar* hash_col,
       const std::vector<Fragmenter_Namespace::FragmentInfo>& fragment_info,
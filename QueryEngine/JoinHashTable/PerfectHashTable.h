@@ -17,6 +17,8 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include "DataMgr/Allocators/CudaAllocator.h"
@@ -140,6 +142,80 @@ class PerfectHashTable : public HashTable {
     return hash_table_entry_info_;
   }
 
+  void setColumnRange(const ExpressionRange& col_range) { col_range_ = col_range; }
+
+  const std::optional<ExpressionRange>& getColumnRange() const { return col_range_; }
+
+  void setFragmentNumTuples(
+      const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments) {
+    fragment_num_tuples_.clear();
+    for (const auto& fragment : fragments) {
+      fragment_num_tuples_.emplace_back(fragment.fragmentId, fragment.getNumTuples());
+    }
+  }
+
+  size_t getNumFragments() const { return fragment_num_tuples_.size(); }
+
+  // finds the first and last occupied slots of the CPU buffer, which bound the keys
+  // present in the hash table; an append only adds keys, so the scan of a hash table
+  // extended by an append stops at the slots occupied before
+  void computeOccupiedSlotRange() {
+    occupied_slot_range_ = std::nullopt;
+    if (!cpu_hash_table_buff_) {
+      return;
+    }
+    const auto entry_count = static_cast<int64_t>(getEntryCount());
+    const bool is_one_to_one = getLayout() == HashType::OneToOne;
+    const int32_t* slots =
+        is_one_to_one ? cpu_hash_table_buff_.get()
+                      : cpu_hash_table_buff_.get() + entry_count;  // the count buffer
+    auto is_occupied = [is_one_to_one, slots](const int64_t slot) {
+      return is_one_to_one ? slots[slot] != -1 : slots[slot] > 0;
+    };
+    int64_t first_slot{0};
+    while (first_slot < entry_count && !is_occupied(first_slot)) {
+      ++first_slot;
+    }
+    if (first_slot == entry_count) {
+      return;
+    }
+    int64_t last_slot{entry_count - 1};
+    while (!is_occupied(last_slot)) {
+      --last_slot;
+    }
+    occupied_slot_range_ = std::make_pair(first_slot, last_slot);
+  }
+
+  const std::optional<std::pair<int64_t, int64_t>>& getOccupiedSlotRange() const {
+    return occupied_slot_range_;
+  }
+
+  // returns the number of leading rows of the given fragments that this hash table
+  // covers, or std::nullopt if a fragment it was built from has changed other than by
+  // appending rows to the last of them (row ids of the covered rows would move)
+  std::optional<size_t> getNumUpToDateRows(
+      const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments) const {
+    if (fragment_num_tuples_.empty() || fragment_num_tuples_.size() > fragments.size()) {
+      return std::nullopt;
+    }
+    size_t num_rows{0};
+    for (size_t i = 0; i < fragment_num_tuples_.size(); ++i) {
+      const auto [fragment_id, num_tuples] = fragment_num_tuples_[i];
+      const auto& fragment = fragments[i];
+      if (fragment.fragmentId != fragment_id) {
+        return std::nullopt;
+      }
+      const auto cur_num_tuples = fragment.getNumTuples();
+      const bool is_last_fragment = i + 1 == fragment_num_tuples_.size();
+      if (cur_num_tuples < num_tuples ||
+          (cur_num_tuples != num_tuples && !is_last_fragment)) {
+        return std::nullopt;
+      }
+      num_rows += num_tuples;
+    }
+    return num_rows;
+  }
+
   void printInitLog(ExecutorDeviceType device_type) {
     std::string device_str = device_type == ExecutorDeviceType::CPU ? "CPU" : "GPU";
     std::string layout_str =
@@ -165,6 +241,10 @@ class PerfectHashTable : public HashTable {
   PerfectHashTableEntryInfo hash_table_entry_info_;
   BucketizedHashEntryInfo hash_entry_info_;
   size_t column_num_elems_;
+  // the key range and the per-fragment row counts this hash table was built from
+  std::optional<ExpressionRange> col_range_;
+  std::vector<std::pair<int, size_t>> fragment_num_tuples_;
+  std::optional<std::pair<int64_t, int64_t>> occupied_slot_range_;
   Data_Namespace::DataMgr* data_mgr_;
   int device_id_;
 };
@@ -33,6 +33,8 @@
 
 extern bool g_is_test_env;
 
+bool g_enable_incremental_join_hash_table_maintenance{true};
+
 // let's only consider CPU hahstable recycler at this moment
 std::unique_ptr<HashtableRecycler> PerfectJoinHashTable::hash_table_cache_ =
     std::make_unique<HashtableRecycler>(CacheItemType::PERFECT_HT,
@@ -503,6 +505,7 @@ void PerfectJoinHashTable::reify() {
                                                       join_type_};
       hashtable_cache_key_[device_id] = getAlternativeCacheKey(cache_key);
     }
+    uses_alternative_cache_key_ = true;
   }
 
   // register a mapping between cache key and its input table info for per-table cache
@@ -600,6 +603,12 @@ void PerfectJoinHashTable::reify() {
           initHashTableOnCpuFromCache(hashtable_cache_key_[device_id],
                                       CacheItemType::PERFECT_HT,
                                       DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+      if (hash_table && isExtendableOnAppend()) {
+        hash_table = refreshCachedHashTableOnCpu(hashtable_cache_key_[device_id],
+                                                 hash_table,
+                                                 fragments_per_device[device_id],
+                                                 device_id);
+      }
       if (hash_table) {
         hash_tables_for_device_[device_id] = hash_table;
         hash_type_ = hash_table->getLayout();
@@ -652,6 +661,7 @@ void PerfectJoinHashTable::reify() {
                                         this,
                                         chunk_key,
                                         columns_per_device[device_id],
+                                        fragments_per_device[device_id],
                                         hash_type_,
                                         device_id,
                                         logger::thread_local_ids()));
@@ -681,6 +691,7 @@ void PerfectJoinHashTable::reify() {
                                         this,
                                         chunk_key,
                                         columns_per_device[device_id],
+                                        fragments_per_device[device_id],
                                         hash_type_,
                                         device_id,
                                         logger::thread_local_ids()));
@@ -758,6 +769,7 @@ ColumnsForDevice PerfectJoinHashTable::fetchColumnsForDevice(
 void PerfectJoinHashTable::reifyForDevice(
     const ChunkKey& chunk_key,
     const ColumnsForDevice& columns_for_device,
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
     const HashType layout,
     const int device_id,
     const logger::ThreadLocalIds parent_thread_local_ids) {
@@ -772,6 +784,7 @@ void PerfectJoinHashTable::reifyForDevice(
   if (layout == HashType::OneToOne) {
     const auto err = initHashTableForDevice(chunk_key,
                                             join_column,
+                                            fragments,
                                             inner_outer_pairs_.front(),
                                             layout,
                                             effective_memory_level,
@@ -782,6 +795,7 @@ void PerfectJoinHashTable::reifyForDevice(
   } else {
     const auto err = initHashTableForDevice(chunk_key,
                                             join_column,
+                                            fragments,
                                             inner_outer_pairs_.front(),
                                             HashType::OneToMany,
                                             effective_memory_level,
@@ -796,6 +810,7 @@ void PerfectJoinHashTable::reifyForDevice(
 int PerfectJoinHashTable::initHashTableForDevice(
     const ChunkKey& chunk_key,
     const JoinColumn& join_column,
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
     const InnerOuter& cols,
     const HashType layout,
     const Data_Namespace::MemoryLevel effective_memory_level,
@@ -867,6 +882,9 @@ int PerfectJoinHashTable::initHashTableForDevice(
           std::chrono::duration_cast<std::chrono::milliseconds>(ts2 - ts1).count();
       hash_table->setHashEntryInfo(hash_entry_info_);
       hash_table->setColumnNumElems(join_column.num_elems);
+      hash_table->setColumnRange(col_range_);
+      hash_table->setFragmentNumTuples(fragments);
+      hash_table->computeOccupiedSlotRange();
       if (allow_hashtable_recycling && hash_table &&
           hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU) > 0) {
         putHashTableOnCpuToCache(hashtable_cache_key_[device_id],
@@ -977,13 +995,125 @@ void PerfectJoinHashTable::putHashTableOnCpuToCache(
     size_t hashtable_building_time) {
   CHECK(hash_table_cache_);
   CHECK(hashtable_ptr && !hashtable_ptr->getGpuBuffer());
+  HashtableCacheMetaInfo meta_info;
+  meta_info.extendable_on_append = isExtendableOnAppend();
+  meta_info.num_fragments = hashtable_ptr->getNumFragments();
   hash_table_cache_->putItemToCache(
       key,
       hashtable_ptr,
       item_type,
       device_identifier,
       hashtable_ptr->getHashTableBufferSize(ExecutorDeviceType::CPU),
-      hashtable_building_time);
+      hashtable_building_time,
+      meta_info);
+}
+
+bool PerfectJoinHashTable::isExtendableOnAppend() const {
+  // a hash table whose keys are translated to the dictionary of the probe side also
+  // depends on the probe side table, whose appends we cannot track here, and one cached
+  // under the alternative cache key would be orphaned by the first append
+  return g_enable_incremental_join_hash_table_maintenance &&
+         getInnerTableId().table_id > 0 && !uses_alternative_cache_key_ &&
+         !needs_dict_translation_ &&
+         inner_outer_string_op_infos_.first.empty() &&
+         inner_outer_string_op_infos_.second.empty() &&
+         join_type_ != JoinType::WINDOW_FUNCTION_FRAMING;
+}
+
+std::shared_ptr<PerfectHashTable> PerfectJoinHashTable::refreshCachedHashTableOnCpu(
+    QueryPlanHash key,
+    std::shared_ptr<PerfectHashTable> cached_hash_table,
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
+    const int device_id) {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(cached_hash_table);
+  // appends do not invalidate cached perfect hash tables, so check per fragment whether
+  // rows were appended since the hash table was built
+  const auto num_cached_rows = cached_hash_table->getNumUpToDateRows(fragments);
+  const auto& cached_col_range = cached_hash_table->getColumnRange();
+  if (num_cached_rows && cached_col_range && *cached_col_range == col_range_) {
+    const auto num_rows = std::accumulate(
+        fragments.begin(),
+        fragments.end(),
+        size_t(0),
+        [](size_t sum, const auto& fragment) { return sum + fragment.getNumTuples(); });
+    if (*num_cached_rows == num_rows) {
+      return cached_hash_table;
+    }
+    if (*num_cached_rows > 0 &&
+        *num_cached_rows == cached_hash_table->getColumnNumElems()) {
+      // the appended rows fit into the key range of the cached hash table, so extend it
+      // rather than rebuilding it from scratch
+      auto columns_for_device = fetchColumnsForDevice(fragments, device_id, nullptr);
+      CHECK_EQ(columns_for_device.join_columns.size(), size_t(1));
+      const auto& join_column = columns_for_device.join_columns.front();
+      const auto layout = cached_hash_table->getLayout();
+      const int32_t hash_join_invalid_val{-1};
+      PerfectHashTableEntryInfo hash_table_entry_info(
+          getNormalizedHashEntryCount(), join_column.num_elems, rowid_size_, layout);
+      std::shared_ptr<PerfectHashTable> hash_table{nullptr};
+      auto ts1 = std::chrono::steady_clock::now();
+      try {
+        PerfectJoinHashTableBuilder builder;
+        if (layout == HashType::OneToOne) {
+          builder.appendToOneToOneHashTableOnCpu(cached_hash_table.get(),
+                                                 join_column,
+                                                 col_range_,
+                                                 isBitwiseEq(),
+                                                 inner_outer_pairs_.front(),
+                                                 str_proxy_translation_map_,
+                                                 join_type_,
+                                                 hash_entry_info_,
+                                                 hash_table_entry_info,
+                                                 hash_join_invalid_val);
+        } else {
+          builder.appendToOneToManyHashTableOnCpu(cached_hash_table.get(),
+                                                  join_column,
+                                                  col_range_,
+                                                  isBitwiseEq(),
+                                                  inner_outer_pairs_.front(),
+                                                  str_proxy_translation_map_,
+                                                  join_type_,
+                                                  hash_entry_info_,
+                                                  hash_table_entry_info,
+                                                  hash_join_invalid_val);
+        }
+        hash_table = builder.getHashTable();
+      } catch (const NeedsOneToManyHash&) {
+        VLOG(1) << "Appended rows duplicate a key of a cached One-to-One hash table, "
+                   "rebuilding it.";
+      }
+      if (hash_table) {
+        auto ts2 = std::chrono::steady_clock::now();
+        auto append_time =
+            std::chrono::duration_cast<std::chrono::milliseconds>(ts2 - ts1).count();
+        VLOG(1) << "Extended a cached perfect join hash table with "
+                << num_rows - *num_cached_rows << " appended rows";
+        hash_table->setHashEntryInfo(hash_entry_info_);
+        hash_table->setColumnNumElems(join_column.num_elems);
+        hash_table->setColumnRange(col_range_);
+        hash_table->setFragmentNumTuples(fragments);
+        hash_table->computeOccupiedSlotRange();
+        // the cached hash table may still be in use by other queries, so we replace it
+        // in the cache instead of modifying it
+        hash_table_cache_->markCachedItemAsDirtyByKey(
+            key, CacheItemType::PERFECT_HT, DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+        putHashTableOnCpuToCache(key,
+                                 CacheItemType::PERFECT_HT,
+                                 hash_table,
+                                 DataRecyclerUtil::CPU_DEVICE_IDENTIFIER,
+                                 append_time);
+        return hash_table;
+      }
+    }
+  }
+  // the cached hash table cannot be brought up to date, i.e., appended rows exceed its
+  // key range, so drop it to let the rebuilt one take its place in the cache
+  hash_table_layout_cache_->markCachedItemAsDirtyByKey(
+      key, CacheItemType::HT_HASHING_SCHEME, DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+  hash_table_cache_->markCachedItemAsDirtyByKey(
+      key, CacheItemType::PERFECT_HT, DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+  return nullptr;
 }
 
 llvm::Value* PerfectJoinHashTable::codegenHashTableLoad(const size_t table_idx) {
@@ -1316,3 +1446,48 @@ size_t PerfectJoinHashTable::shardCount() const {
 bool PerfectJoinHashTable::isBitwiseEq() const {
   return qual_bin_oper_->get_optype() == kBW_EQ;
 }
+
+std::list<std::shared_ptr<Analyzer::Expr>> PerfectJoinHashTable::getRuntimeFilterQuals()
+    const {
+  if (join_type_ != JoinType::INNER || memory_level_ != Data_Namespace::CPU_LEVEL ||
+      isBitwiseEq() || inner_outer_pairs_.size() != 1 ||
+      !inner_outer_string_op_infos_.first.empty() ||
+      !inner_outer_string_op_infos_.second.empty() ||
+      hash_entry_info_.bucket_normalization != 1) {
+    return {};
+  }
+  const auto inner_col = inner_outer_pairs_.front().first;
+  const auto outer_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(inner_outer_pairs_.front().second);
+  if (!outer_col || outer_col->get_rte_idx() != 0 ||
+      !inner_col->get_type_info().is_integer() ||
+      !outer_col->get_type_info().is_integer()) {
+    return {};
+  }
+  const auto hash_table = dynamic_cast<PerfectHashTable*>(getHashTableForDevice(0));
+  if (!hash_table) {
+    return {};
+  }
+  // A slot is occupied iff some inner row has the key `col_range_.getIntMin() + slot`,
+  // the first and last occupied slots, found when the hash table was built or extended,
+  // bound the keys actually present in the table. An empty build side is left to the
+  // join itself.
+  const auto& occupied_slot_range = hash_table->getOccupiedSlotRange();
+  if (!occupied_slot_range) {
+    return {};
+  }
+  const auto [first_slot, last_slot] = *occupied_slot_range;
+  auto make_bound = [outer_col](const SQLOps op, const int64_t key) {
+    Datum d;
+    d.bigintval = key;
+    return makeExpr<Analyzer::BinOper>(kBOOLEAN,
+                                       op,
+                                       kONE,
+                                       outer_col->deep_copy(),
+                                       makeExpr<Analyzer::Constant>(kBIGINT, false, d));
+  };
+  std::list<std::shared_ptr<Analyzer::Expr>> quals;
+  quals.push_back(make_bound(kGE, col_range_.getIntMin() + first_slot));
+  quals.push_back(make_bound(kLE, col_range_.getIntMin() + last_slot));
+  return quals;
+}
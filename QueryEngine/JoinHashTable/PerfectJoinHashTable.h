@@ -99,6 +99,8 @@ class PerfectJoinHashTable : public HashJoin {
 
   std::string getHashJoinType() const final { return "Perfect"; }
 
+  std::list<std::shared_ptr<Analyzer::Expr>> getRuntimeFilterQuals() const override;
+
   static HashtableRecycler* getHashTableCache() {
     CHECK(hash_table_cache_);
     return hash_table_cache_.get();
@@ -134,6 +136,23 @@ class PerfectJoinHashTable : public HashJoin {
     }
   }
 
+  // called instead of markCachedItemAsDirty both before and after rows get appended to
+  // the given table, which then consists of `num_fragments` fragments
+  static void markCachedItemAsDirtyOnAppend(size_t table_key, size_t num_fragments) {
+    CHECK(hash_table_layout_cache_);
+    CHECK(hash_table_cache_);
+    auto dirty_keys = hash_table_cache_->markCachedItemAsDirtyOnAppend(
+        table_key,
+        num_fragments,
+        CacheItemType::PERFECT_HT,
+        DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+    hash_table_layout_cache_->markCachedItemAsDirty(
+        table_key,
+        dirty_keys,
+        CacheItemType::HT_HASHING_SCHEME,
+        DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+  }
+
   const RegisteredQueryHint& getRegisteredQueryHint() { return query_hints_; }
 
   BucketizedHashEntryInfo getHashEntryInfo() const { return hash_entry_info_; }
@@ -156,16 +175,27 @@ class PerfectJoinHashTable : public HashJoin {
 
   void reifyForDevice(const ChunkKey& hash_table_key,
                       const ColumnsForDevice& columns_for_device,
+                      const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
                       const HashType layout,
                       const int device_id,
                       const logger::ThreadLocalIds);
 
-  int initHashTableForDevice(const ChunkKey& chunk_key,
-                             const JoinColumn& join_column,
-                             const InnerOuter& cols,
-                             const HashType layout,
-                             const Data_Namespace::MemoryLevel effective_memory_level,
-                             const int device_id);
+  int initHashTableForDevice(
+      const ChunkKey& chunk_key,
+      const JoinColumn& join_column,
+      const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
+      const InnerOuter& cols,
+      const HashType layout,
+      const Data_Namespace::MemoryLevel effective_memory_level,
+      const int device_id);
+
+  bool isExtendableOnAppend() const;
+
+  std::shared_ptr<PerfectHashTable> refreshCachedHashTableOnCpu(
+      QueryPlanHash key,
+      std::shared_ptr<PerfectHashTable> cached_hash_table,
+      const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
+      const int device_id);
 
   Data_Namespace::MemoryLevel getEffectiveMemoryLevel(
       const std::vector<InnerOuter>& inner_outer_pairs) const;
@@ -297,6 +327,9 @@ class PerfectJoinHashTable : public HashJoin {
   // per-device cache key to cover hash table for sharded table
   std::vector<QueryPlanHash> hashtable_cache_key_;
   HashtableCacheMetaInfo hashtable_cache_meta_info_;
+  // the cache key hashes the number of rows instead of the query plan dag, so it changes
+  // on every append
+  bool uses_alternative_cache_key_{false};
   std::unordered_set<size_t> table_keys_;
   const TableIdToNodeMap table_id_to_node_map_;
   const InnerOuterStringOpInfos inner_outer_string_op_infos_;
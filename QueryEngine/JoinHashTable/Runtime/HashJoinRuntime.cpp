@@ -38,6 +38,7 @@
 #include <tbb/parallel_for.h>
 #endif
 
+#include <atomic>
 #include <future>
 #endif
 
@@ -502,17 +503,14 @@ T* get_matching_baseline_hash_slot_at(int8_t* hash_buff,
 
 #endif  // __CUDACC__
 
+// Finds or claims the slot of the key, probing linearly from its home slot h.
 template <typename T>
-DEVICE int write_baseline_hash_slot(const int32_t val,
-                                    int8_t* hash_buff,
-                                    const int64_t entry_count,
-                                    const T* key,
-                                    const size_t key_component_count,
-                                    const bool with_val_slot,
-                                    const int32_t invalid_slot_val,
-                                    const size_t key_size_in_bytes,
-                                    const size_t hash_entry_size) {
-  const uint32_t h = MurmurHash1Impl(key, key_size_in_bytes, 0) % entry_count;
+DEVICE T* get_matching_baseline_hash_slot(int8_t* hash_buff,
+                                          const uint32_t h,
+                                          const int64_t entry_count,
+                                          const T* key,
+                                          const size_t key_component_count,
+                                          const size_t hash_entry_size) {
   T* matching_group = get_matching_baseline_hash_slot_at(
       hash_buff, h, key, key_component_count, hash_entry_size);
   if (!matching_group) {
@@ -526,6 +524,22 @@ DEVICE int write_baseline_hash_slot(const int32_t val,
       h_probe = (h_probe + 1) % entry_count;
     }
   }
+  return matching_group;
+}
+
+template <typename T>
+DEVICE int write_baseline_hash_slot(const int32_t val,
+                                    int8_t* hash_buff,
+                                    const int64_t entry_count,
+                                    const T* key,
+                                    const size_t key_component_count,
+                                    const bool with_val_slot,
+                                    const int32_t invalid_slot_val,
+                                    const size_t key_size_in_bytes,
+                                    const size_t hash_entry_size) {
+  const uint32_t h = MurmurHash1Impl(key, key_size_in_bytes, 0) % entry_count;
+  T* matching_group = get_matching_baseline_hash_slot<T>(
+      hash_buff, h, entry_count, key, key_component_count, hash_entry_size);
   if (!matching_group) {
     return -2;
   }
@@ -549,19 +563,8 @@ DEVICE int write_baseline_hash_slot_for_semi_join(const int32_t val,
                                                   const size_t key_size_in_bytes,
                                                   const size_t hash_entry_size) {
   const uint32_t h = MurmurHash1Impl(key, key_size_in_bytes, 0) % entry_count;
-  T* matching_group = get_matching_baseline_hash_slot_at(
-      hash_buff, h, key, key_component_count, hash_entry_size);
-  if (!matching_group) {
-    uint32_t h_probe = (h + 1) % entry_count;
-    while (h_probe != h) {
-      matching_group = get_matching_baseline_hash_slot_at(
-          hash_buff, h_probe, key, key_component_count, hash_entry_size);
-      if (matching_group) {
-        break;
-      }
-      h_probe = (h_probe + 1) % entry_count;
-    }
-  }
+  T* matching_group = get_matching_baseline_hash_slot<T>(
+      hash_buff, h, entry_count, key, key_component_count, hash_entry_size);
   if (!matching_group) {
     return -2;
   }
@@ -638,6 +641,163 @@ DEVICE int SUFFIX(fill_baseline_hash_join_buff)(int8_t* hash_buff,
   return 0;
 }
 
+#ifndef __CUDACC__
+/*
+ * Radix-partitioned variant of fill_baseline_hash_join_buff for build sides much larger
+ * than the last level cache. A histogram pass counts the rows every thread sends to each
+ * partition, each covering a contiguous range of partition_count-th of the hash table
+ * slots. A scatter pass then writes the (row id, home slot, key) records of a partition
+ * contiguously into partition_buff, which has room for a record per row. The last pass
+ * inserts the records partition by partition, so that the writes of a thread stay within
+ * a cache-sized region of the table instead of hitting a random cache line for every
+ * row. Keys probing past the end of their partition still go through the
+ * compare-and-swap protocol, the resulting table is the same as the one built by
+ * fill_baseline_hash_join_buff.
+ */
+template <typename T, typename FILL_HANDLER>
+int fill_baseline_hash_join_buff_partitioned(int8_t* hash_buff,
+                                             const int64_t entry_count,
+                                             const int32_t invalid_slot_val,
+                                             const bool for_semi_join,
+                                             const size_t key_component_count,
+                                             const bool with_val_slot,
+                                             const FILL_HANDLER* f,
+                                             int8_t* partition_buff,
+                                             const size_t partition_count,
+                                             const int32_t cpu_thread_count) {
+  CHECK_GT(partition_count, size_t(1));
+  CHECK_GT(cpu_thread_count, 0);
+  const size_t key_size_in_bytes = key_component_count * sizeof(T);
+  const size_t hash_entry_size =
+      (key_component_count + (with_val_slot ? 1 : 0)) * sizeof(T);
+  const int64_t slots_per_partition =
+      (entry_count + partition_count - 1) / partition_count;
+  // every record holds the row id, the home slot and the key components
+  const size_t record_size = key_component_count + 2;
+  auto records = reinterpret_cast<T*>(partition_buff);
+  // the record counts, then the next record offsets, of every thread and partition
+  std::vector<size_t> partition_offsets(cpu_thread_count * partition_count, 0);
+
+  // both passes visit the rows of a thread in the same order
+  auto run_partition_pass = [&](auto make_key_buff_handler) {
+    std::vector<std::future<int>> partition_threads;
+    for (int32_t cpu_thread_idx = 0; cpu_thread_idx < cpu_thread_count;
+         ++cpu_thread_idx) {
+      partition_threads.push_back(std::async(std::launch::async, [&, cpu_thread_idx] {
+        auto key_buff_handler =
+            make_key_buff_handler(&partition_offsets[cpu_thread_idx * partition_count]);
+        T key_scratch_buff[g_maximum_conditions_to_coalesce];
+        JoinColumnTuple cols(f->get_number_of_columns(),
+                             f->get_join_columns(),
+                             f->get_join_column_type_infos());
+        for (auto& it : cols.slice(cpu_thread_idx, cpu_thread_count)) {
+          const auto err =
+              (*f)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
+          if (err) {
+            return err;
+          }
+        }
+        return 0;
+      }));
+    }
+    int err = 0;
+    for (auto& child : partition_threads) {
+      const auto partial_err = child.get();
+      if (partial_err) {
+        err = partial_err;
+      }
+    }
+    return err;
+  };
+  const auto get_home_slot = [entry_count, key_size_in_bytes](const T* key) {
+    return MurmurHash1Impl(key, key_size_in_bytes, 0) % entry_count;
+  };
+
+  int err = run_partition_pass([&](size_t* counts) {
+    return [counts, &get_home_slot, slots_per_partition](
+               const int64_t entry_idx,
+               const T* key_scratch_buffer,
+               const size_t key_component_count) {
+      ++counts[get_home_slot(key_scratch_buffer) / slots_per_partition];
+      return 0;
+    };
+  });
+  if (err) {
+    return err;
+  }
+  // lay the records out partition by partition, in thread order within a partition
+  std::vector<size_t> partition_ends(partition_count);
+  size_t record_count = 0;
+  for (size_t partition_idx = 0; partition_idx < partition_count; ++partition_idx) {
+    for (int32_t cpu_thread_idx = 0; cpu_thread_idx < cpu_thread_count;
+         ++cpu_thread_idx) {
+      auto& offset = partition_offsets[cpu_thread_idx * partition_count + partition_idx];
+      const auto count = offset;
+      offset = record_count;
+      record_count += count;
+    }
+    partition_ends[partition_idx] = record_count;
+  }
+  err = run_partition_pass([&](size_t* offsets) {
+    return [offsets, records, record_size, &get_home_slot, slots_per_partition](
+               const int64_t entry_idx,
+               const T* key_scratch_buffer,
+               const size_t key_component_count) {
+      const uint32_t h = get_home_slot(key_scratch_buffer);
+      auto record = records + offsets[h / slots_per_partition]++ * record_size;
+      record[0] = static_cast<T>(entry_idx);
+      record[1] = static_cast<T>(h);
+      std::copy(key_scratch_buffer, key_scratch_buffer + key_component_count, record + 2);
+      return 0;
+    };
+  });
+  if (err) {
+    return err;
+  }
+
+  std::atomic<size_t> next_partition_idx{0};
+  std::vector<std::future<int>> build_threads;
+  for (int32_t cpu_thread_idx = 0; cpu_thread_idx < cpu_thread_count; ++cpu_thread_idx) {
+    build_threads.push_back(std::async(std::launch::async, [&] {
+      for (size_t partition_idx = next_partition_idx++; partition_idx < partition_count;
+           partition_idx = next_partition_idx++) {
+        const size_t partition_begin =
+            partition_idx ? partition_ends[partition_idx - 1] : 0;
+        for (size_t i = partition_begin; i < partition_ends[partition_idx]; ++i) {
+          const auto record = records + i * record_size;
+          T* matching_group =
+              get_matching_baseline_hash_slot<T>(hash_buff,
+                                                 static_cast<uint32_t>(record[1]),
+                                                 entry_count,
+                                                 record + 2,
+                                                 key_component_count,
+                                                 hash_entry_size);
+          if (!matching_group) {
+            return -2;
+          }
+          if (!with_val_slot) {
+            continue;
+          }
+          const auto val = static_cast<int32_t>(record[0]);
+          if (mapd_cas(matching_group, invalid_slot_val, val) != invalid_slot_val &&
+              !for_semi_join) {
+            return -1;
+          }
+        }
+      }
+      return 0;
+    }));
+  }
+  for (auto& child : build_threads) {
+    const auto partial_err = child.get();
+    if (partial_err) {
+      err = partial_err;
+    }
+  }
+  return err;
+}
+#endif  // #ifndef __CUDACC__
+
 #undef mapd_cas
 
 #ifdef __CUDACC__
@@ -1652,6 +1812,130 @@ void fill_one_to_many_hash_table_bucketized(
                                    launch_fill_row_ids);
 }
 
+template <typename COUNT_MATCHES_LAUNCH_FUNCTOR, typename FILL_ROW_IDS_LAUNCH_FUNCTOR>
+void append_to_one_to_many_hash_table_impl(
+    int32_t* buff,
+    const int64_t hash_entry_count,
+    const int32_t* cached_buff,
+    const size_t num_cached_elems,
+    COUNT_MATCHES_LAUNCH_FUNCTOR count_matches_func,
+    FILL_ROW_IDS_LAUNCH_FUNCTOR fill_row_ids_func) {
+  auto timer = DEBUG_TIMER(__func__);
+  int32_t* pos_buff = buff;
+  int32_t* count_buff = buff + hash_entry_count;
+  int32_t* id_buff = count_buff + hash_entry_count;
+  const int32_t* cached_pos_buff = cached_buff;
+  const int32_t* cached_count_buff = cached_buff + hash_entry_count;
+  const int32_t* cached_id_buff = cached_count_buff + hash_entry_count;
+  // appended rows follow the ones the cached hash table was built from, so a single
+  // slice starting right after them visits the appended rows only
+  memset(count_buff, 0, hash_entry_count * sizeof(int32_t));
+  count_matches_func(static_cast<int32_t>(num_cached_elems), 1);
+
+  // lay out the row ids of each entry again, keeping the cached ones in front
+  int32_t pos = 0;
+  for (int64_t i = 0; i < hash_entry_count; ++i) {
+    const auto num_cached_ids = cached_count_buff[i];
+    const auto num_ids = num_cached_ids + count_buff[i];
+    if (num_ids) {
+      pos_buff[i] = pos;
+      if (num_cached_ids) {
+        memcpy(id_buff + pos,
+               cached_id_buff + cached_pos_buff[i],
+               num_cached_ids * sizeof(int32_t));
+      }
+      pos += num_ids;
+    }
+    count_buff[i] = num_cached_ids;
+  }
+  fill_row_ids_func(static_cast<int32_t>(num_cached_elems), 1);
+}
+
+void append_to_one_to_many_hash_table(
+    OneToManyPerfectJoinHashTableFillFuncArgs const args,
+    const int32_t* cached_buff,
+    const size_t num_cached_elems) {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(!args.for_window_framing);
+  auto const buff = args.buff;
+  auto const hash_entry_count = args.hash_entry_info.bucketized_hash_entry_count;
+  auto launch_count_matches = [count_buff = buff + hash_entry_count, &args](
+                                  auto cpu_thread_idx, auto cpu_thread_count) {
+    SUFFIX(count_matches)
+    (count_buff,
+     args.join_column,
+     args.type_info,
+     args.sd_inner_to_outer_translation_map,
+     args.min_inner_elem,
+     cpu_thread_idx,
+     cpu_thread_count);
+  };
+  auto launch_fill_row_ids = [hash_entry_count, buff, &args](auto cpu_thread_idx,
+                                                             auto cpu_thread_count) {
+    SUFFIX(fill_row_ids)
+    (buff,
+     hash_entry_count,
+     args.join_column,
+     args.type_info,
+     false,
+     args.sd_inner_to_outer_translation_map,
+     args.min_inner_elem,
+     cpu_thread_idx,
+     cpu_thread_count);
+  };
+
+  append_to_one_to_many_hash_table_impl(buff,
+                                        hash_entry_count,
+                                        cached_buff,
+                                        num_cached_elems,
+                                        launch_count_matches,
+                                        launch_fill_row_ids);
+}
+
+void append_to_one_to_many_hash_table_bucketized(
+    OneToManyPerfectJoinHashTableFillFuncArgs const args,
+    const int32_t* cached_buff,
+    const size_t num_cached_elems) {
+  auto timer = DEBUG_TIMER(__func__);
+  auto const buff = args.buff;
+  auto const hash_entry_info = args.hash_entry_info;
+  auto bucket_normalization = hash_entry_info.bucket_normalization;
+  auto hash_entry_count = hash_entry_info.getNormalizedHashEntryCount();
+  auto launch_count_matches = [bucket_normalization,
+                               count_buff = buff + hash_entry_count,
+                               &args](auto cpu_thread_idx, auto cpu_thread_count) {
+    SUFFIX(count_matches_bucketized)
+    (count_buff,
+     args.join_column,
+     args.type_info,
+     args.sd_inner_to_outer_translation_map,
+     args.min_inner_elem,
+     cpu_thread_idx,
+     cpu_thread_count,
+     bucket_normalization);
+  };
+  auto launch_fill_row_ids = [bucket_normalization, hash_entry_count, buff, &args](
+                                 auto cpu_thread_idx, auto cpu_thread_count) {
+    SUFFIX(fill_row_ids_bucketized)
+    (buff,
+     hash_entry_count,
+     args.join_column,
+     args.type_info,
+     args.sd_inner_to_outer_translation_map,
+     args.min_inner_elem,
+     cpu_thread_idx,
+     cpu_thread_count,
+     bucket_normalization);
+  };
+
+  append_to_one_to_many_hash_table_impl(buff,
+                                        hash_entry_count,
+                                        cached_buff,
+                                        num_cached_elems,
+                                        launch_count_matches,
+                                        launch_fill_row_ids);
+}
+
 template <typename COUNT_MATCHES_LAUNCH_FUNCTOR, typename FILL_ROW_IDS_LAUNCH_FUNCTOR>
 void fill_one_to_many_hash_table_sharded_impl(
     int32_t* buff,
@@ -1928,6 +2212,50 @@ int fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                                cpu_thread_count);
 }
 
+int fill_baseline_hash_join_buff_partitioned_32(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                int8_t* partition_buff,
+                                                const size_t partition_count,
+                                                const int32_t cpu_thread_count) {
+  return fill_baseline_hash_join_buff_partitioned<int32_t>(hash_buff,
+                                                           entry_count,
+                                                           invalid_slot_val,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           with_val_slot,
+                                                           key_handler,
+                                                           partition_buff,
+                                                           partition_count,
+                                                           cpu_thread_count);
+}
+
+int fill_baseline_hash_join_buff_partitioned_64(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                int8_t* partition_buff,
+                                                const size_t partition_count,
+                                                const int32_t cpu_thread_count) {
+  return fill_baseline_hash_join_buff_partitioned<int64_t>(hash_buff,
+                                                           entry_count,
+                                                           invalid_slot_val,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           with_val_slot,
+                                                           key_handler,
+                                                           partition_buff,
+                                                           partition_count,
+                                                           cpu_thread_count);
+}
+
 int bbox_intersect_fill_baseline_hash_join_buff_64(
     int8_t* hash_buff,
     const int64_t entry_count,
@@ -219,6 +219,16 @@ void fill_one_to_many_hash_table_bucketized(
     OneToManyPerfectJoinHashTableFillFuncArgs const args,
     int32_t const cpu_thread_count);
 
+void append_to_one_to_many_hash_table(
+    OneToManyPerfectJoinHashTableFillFuncArgs const args,
+    const int32_t* cached_buff,
+    const size_t num_cached_elems);
+
+void append_to_one_to_many_hash_table_bucketized(
+    OneToManyPerfectJoinHashTableFillFuncArgs const args,
+    const int32_t* cached_buff,
+    const size_t num_cached_elems);
+
 void fill_one_to_many_hash_table_on_device(
     OneToManyPerfectJoinHashTableFillFuncArgs const args);
 
@@ -272,6 +282,28 @@ int fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                     const int32_t cpu_thread_idx,
                                     const int32_t cpu_thread_count);
 
+int fill_baseline_hash_join_buff_partitioned_32(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                int8_t* partition_buff,
+                                                const size_t partition_count,
+                                                const int32_t cpu_thread_count);
+
+int fill_baseline_hash_join_buff_partitioned_64(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                int8_t* partition_buff,
+                                                const size_t partition_count,
+                                                const int32_t cpu_thread_count);
+
 int bbox_intersect_fill_baseline_hash_join_buff_64(
     int8_t* hash_buff,
     const int64_t entry_count,
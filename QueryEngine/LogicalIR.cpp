@@ -194,6 +194,21 @@ bool CodeGenerator::prioritizeQuals(const RelAlgExecutionUnit& ra_exe_unit,
   return short_circuit;
 }
 
+float CodeGenerator::getExpectedSelectivity(const RelAlgExecutionUnit& ra_exe_unit) {
+  Likelihood selectivity{1.0};
+  bool has_likelihood{false};
+  for (const auto quals : {&ra_exe_unit.simple_quals, &ra_exe_unit.quals}) {
+    for (const auto& qual : *quals) {
+      const auto qual_likelihood = get_likelihood(qual.get());
+      if (qual_likelihood.isValid()) {
+        selectivity = selectivity * qual_likelihood;
+        has_likelihood = true;
+      }
+    }
+  }
+  return has_likelihood ? selectivity.getValue() : Likelihood::getDefaultValue();
+}
+
 llvm::Value* CodeGenerator::codegenLogicalShortCircuit(const Analyzer::BinOper* bin_oper,
                                                        const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
@@ -66,6 +66,7 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include "CudaMgr/CudaMgr.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/CodegenHelper.h"
+#include "QueryEngine/DiskCodeCache.h"
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/GpuSharedMemoryUtils.h"
 #include "QueryEngine/LLVMFunctionAttributesUtil.h"
@@ -76,11 +77,18 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include "QueryEngine/UsedColumnsVisitor.h"
 #include "Shared/InlineNullValues.h"
 #include "Shared/MathUtils.h"
+#include "Shared/measure.h"
 #include "StreamingTopN.h"
 
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 using heavyai::ErrorCode;
 
 float g_fraction_code_cache_to_evict = 0.2;
+bool g_enable_tiered_cpu_compilation{false};
+bool g_enable_concurrent_cpu_codegen{false};
 
 #ifdef ENABLE_GEOS
 
@@ -351,6 +359,19 @@ void optimize_ir(llvm::Function* query_func,
 
   eliminate_dead_self_recursive_funcs(*llvm_module, live_funcs);
 }
+
+// First tier of tiered CPU compilation: only the passes the generated code relies on
+void optimize_ir_quick(llvm::Module* llvm_module,
+                       llvm::legacy::PassManager& pass_manager,
+                       const std::unordered_set<llvm::Function*>& live_funcs) {
+  auto timer = DEBUG_TIMER(__func__);
+  pass_manager.add(llvm::createVerifierPass());
+  pass_manager.add(llvm::createAlwaysInlinerLegacyPass());
+  pass_manager.add(llvm::createPromoteMemoryToRegisterPass());
+  pass_manager.run(*llvm_module);
+
+  eliminate_dead_self_recursive_funcs(*llvm_module, live_funcs);
+}
 #endif
 
 }  // namespace
@@ -417,23 +438,215 @@ std::string assemblyForCPU(ExecutionEngineWrapper& execution_engine,
   return "Assembly for the CPU:\n" + std::string(code_str.str()) + "\nEnd of assembly";
 }
 
-ExecutionEngineWrapper create_execution_engine(llvm::Module* llvm_module,
-                                               llvm::EngineBuilder& eb,
-                                               const CompilationOptions& co) {
+// Hands object code loaded from the disk code cache, or generated ahead of
+// finalizeObject, to MCJIT in place of code generation
+class LoadedObjectCache : public llvm::ObjectCache {
+ public:
+  LoadedObjectCache(std::unique_ptr<llvm::MemoryBuffer> object)
+      : object_(std::move(object)) {}
+
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef obj) override {}
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override {
+    return std::move(object_);
+  }
+
+ private:
+  std::unique_ptr<llvm::MemoryBuffer> object_;
+};
+
+// Generates the object code of the module the way MCJIT::finalizeObject would, but
+// without loading it.
+std::unique_ptr<llvm::MemoryBuffer> emit_object_for_cpu(
+    ExecutionEngineWrapper& execution_engine,
+    llvm::Module* llvm_module) {
+  auto cpu_target_machine = execution_engine->getTargetMachine();
+  CHECK(cpu_target_machine);
+  llvm::legacy::PassManager pass_manager;
+  llvm::MCContext* mc_context;
+  llvm::SmallVector<char, 4096> object_buffer;
+  llvm::raw_svector_ostream os(object_buffer);
+  const auto err = cpu_target_machine->addPassesToEmitMC(
+      pass_manager, mc_context, os, /*DisableVerify=*/true);
+  CHECK(!err) << "Target does not support MC emission.";
+  pass_manager.run(*llvm_module);
+  return llvm::MemoryBuffer::getMemBufferCopy(
+      llvm::StringRef(object_buffer.data(), object_buffer.size()),
+      llvm_module->getModuleIdentifier());
+}
+
+ExecutionEngineWrapper create_execution_engine(
+    llvm::Module* llvm_module,
+    llvm::EngineBuilder& eb,
+    const CompilationOptions& co,
+    llvm::ObjectCache* object_cache,
+    const bool needs_codegen,
+    std::unique_lock<std::mutex>& backend_lock) {
   auto timer = DEBUG_TIMER(__func__);
   ExecutionEngineWrapper execution_engine(eb.create(), co);
   CHECK(execution_engine.get());
   // Force the module data layout to match the layout for the selected target
   llvm_module->setDataLayout(execution_engine->getDataLayout());
+  // Machine code generation only touches the state of this execution engine, so
+  // kernels of different modules can be generated concurrently. Loading the object code
+  // in finalizeObject notifies the process-wide JIT event listeners, so it stays
+  // under the lock.
+  const bool concurrent_codegen = g_enable_concurrent_cpu_codegen && needs_codegen;
+  if (concurrent_codegen) {
+    backend_lock.unlock();
+  }
 
   LOG(ASM) << assemblyForCPU(execution_engine, llvm_module);
 
+  std::unique_ptr<LoadedObjectCache> emitted_object_cache;
+  if (concurrent_codegen) {
+    auto object = emit_object_for_cpu(execution_engine, llvm_module);
+    if (object_cache) {
+      object_cache->notifyObjectCompiled(llvm_module, object->getMemBufferRef());
+    }
+    emitted_object_cache = std::make_unique<LoadedObjectCache>(std::move(object));
+    object_cache = emitted_object_cache.get();
+    backend_lock.lock();
+  }
+
+  execution_engine->setObjectCache(object_cache);
   execution_engine->finalizeObject();
+  execution_engine->setObjectCache(nullptr);
   return execution_engine;
 }
 
+// Runs the optimized tier of tiered CPU compilation. A single worker thread is used so
+// that background compilation never takes more than one core away from query execution.
+class TieredCpuCompiler {
+ public:
+  static TieredCpuCompiler& instance() {
+    static TieredCpuCompiler compiler;
+    return compiler;
+  }
+
+  ~TieredCpuCompiler() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+      tasks_.clear();
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+  // Returns false if the queue is full, in which case the quick tier is kept.
+  bool enqueue(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stop_ || tasks_.size() >= kMaxQueuedTasks) {
+        return false;
+      }
+      if (!worker_.joinable()) {
+        worker_ = std::thread([this] { run(); });
+      }
+      tasks_.push_back(std::move(task));
+    }
+    cv_.notify_all();
+    return true;
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return stop_ || (tasks_.empty() && !busy_); });
+  }
+
+ private:
+  static constexpr size_t kMaxQueuedTasks{16};
+
+  void run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        busy_ = false;
+        cv_.notify_all();
+        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (stop_) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+        busy_ = true;
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool busy_{false};
+  bool stop_{false};
+  std::thread worker_;
+};
+
+// Recompiles a kernel compiled by the quick tier with the full optimization pipeline
+// and swaps it into the CPU code cache (and into the disk code cache if `persist`). The
+// module is rebuilt from bitcode in a context of its own, since the executor context may
+// be in use by the next query already. The query which enqueued it has usually finished
+// along with its debug timer tree, so the timer here is the root of a tree of its own,
+// logged under the request id of that query.
+void compile_optimized_cpu_tier(const CodeCacheKey& key,
+                                const std::string& bitcode,
+                                const std::string& query_func_name,
+                                const std::string& multifrag_query_func_name,
+                                const std::vector<std::string>& live_func_names,
+                                const CompilationOptions& co,
+                                const bool persist) {
+  auto timer = DEBUG_TIMER(__func__);
+  auto clock_begin = timer_start();
+  auto llvm_context = std::make_unique<llvm::LLVMContext>();
+  auto module_or_err =
+      llvm::parseBitcodeFile(llvm::MemoryBufferRef(bitcode, "tiered_cpu_kernel"),
+                             *llvm_context);
+  if (!module_or_err) {
+    LOG(WARNING) << "Tiered compilation: failed to read kernel bitcode, "
+                 << llvm::toString(module_or_err.takeError());
+    return;
+  }
+  auto llvm_module = std::move(module_or_err.get());
+  if (persist) {
+    DiskCodeCache::tagModule(*llvm_module, key);
+  }
+  auto query_func = llvm_module->getFunction(query_func_name);
+  auto multifrag_query_func = llvm_module->getFunction(multifrag_query_func_name);
+  CHECK(query_func);
+  CHECK(multifrag_query_func);
+  std::unordered_set<llvm::Function*> live_funcs;
+  for (const auto& live_func_name : live_func_names) {
+    if (auto live_func = llvm_module->getFunction(live_func_name)) {
+      live_funcs.insert(live_func);
+    }
+  }
+  // generateNativeCPUCode takes ownership of the module
+  llvm_module.release();
+  auto execution_engine =
+      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+  auto cpu_compilation_context = std::make_shared<CpuCompilationContext>(
+      std::move(execution_engine), std::move(llvm_context));
+  cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+  const auto optimized_ms = timer_stop(clock_begin);
+  if (QueryEngine::getInstance()->cpu_code_accessor->replace(key,
+                                                             cpu_compilation_context)) {
+    LOG(INFO) << "Tiered compilation: optimized CPU kernel compiled in " << optimized_ms
+              << " ms and swapped into the code cache";
+  }
+}
+
 }  // namespace
 
+void CodeGenerator::waitForTieredCPUCompilation() {
+  TieredCpuCompiler::instance().wait();
+}
+
 std::mutex CodeGenerator::initialize_cpu_backend_mutex_;
 
 ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
@@ -443,11 +656,26 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
   auto timer = DEBUG_TIMER(__func__);
   llvm::Module* llvm_module = func->getParent();
   CHECK(llvm_module);
+  // a module tagged for the disk code cache either loads its object code from there,
+  // which makes the optimizations below moot, or adds the object code once compiled
+  auto disk_code_cache = DiskCodeCache::getInstance();
+  std::unique_ptr<LoadedObjectCache> loaded_object_cache;
+  if (disk_code_cache) {
+    if (auto object = disk_code_cache->load(*llvm_module)) {
+      loaded_object_cache = std::make_unique<LoadedObjectCache>(std::move(object));
+    }
+  }
   // run optimizations
 #ifndef WITH_JIT_DEBUG
   llvm::legacy::PassManager pass_manager;
-  optimize_ir(
-      func, llvm_module, pass_manager, live_funcs, /*is_gpu_smem_used=*/false, co);
+  if (loaded_object_cache) {
+    VLOG(1) << "Skipping optimizations of a kernel found in the disk code cache";
+  } else if (co.opt_level == ExecutorOptLevel::QuickJIT) {
+    optimize_ir_quick(llvm_module, pass_manager, live_funcs);
+  } else {
+    optimize_ir(
+        func, llvm_module, pass_manager, live_funcs, /*is_gpu_smem_used=*/false, co);
+  }
 #endif  // WITH_JIT_DEBUG
 
   // The following lock avoids a data race in two places:
@@ -456,11 +684,14 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
   // GDBJITRegistrationListener::notifyObjectLoaded while creating a
   // new ExecutionEngine instance in the child call create_execution_engine.
 
+  // With g_enable_concurrent_cpu_codegen, the lock is released once the execution
+  // engine has been created while the machine code is generated, and taken again to
+  // load it.
+
   // Todo: Initialize backend CPU (and perhaps GPU?) targets at startup
-  // instead of for every compilation, and see if we can reduce
-  // the scope of the below lock
+  // instead of for every compilation
 
-  std::lock_guard<std::mutex> lock(initialize_cpu_backend_mutex_);
+  std::unique_lock<std::mutex> lock(initialize_cpu_backend_mutex_);
   auto init_err = llvm::InitializeNativeTarget();
   CHECK(!init_err);
 
@@ -477,11 +708,17 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
   llvm::TargetOptions to;
   to.EnableFastISel = true;
   eb.setTargetOptions(to);
-  if (co.opt_level == ExecutorOptLevel::ReductionJIT) {
+  if (co.opt_level == ExecutorOptLevel::ReductionJIT ||
+      co.opt_level == ExecutorOptLevel::QuickJIT) {
     eb.setOptLevel(llvm::CodeGenOpt::None);
   }
 
-  return create_execution_engine(llvm_module, eb, co);
+  llvm::ObjectCache* object_cache = disk_code_cache;
+  if (loaded_object_cache) {
+    object_cache = loaded_object_cache.get();
+  }
+  return create_execution_engine(
+      llvm_module, eb, co, object_cache, /*needs_codegen=*/!loaded_object_cache, lock);
 }
 
 std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
@@ -493,12 +730,14 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
                    serialize_llvm_object(cgen_state_->row_func_)};
 
   llvm::Module* M = query_func->getParent();
+  bool includes_executor_addr{false};
   auto* flag = llvm::mdconst::extract_or_null<llvm::ConstantInt>(
       M->getModuleFlag("manage_memory_buffer"));
   if (flag and flag->getZExtValue() == 1 and M->getFunction("allocate_varlen_buffer") and
       M->getFunction("register_buffer_with_executor_rsm")) {
     LOG(INFO) << "including executor addr to cache key\n";
     key.push_back(std::to_string(reinterpret_cast<int64_t>(this)));
+    includes_executor_addr = true;
   }
   if (cgen_state_->filter_func_) {
     key.push_back(serialize_llvm_object(cgen_state_->filter_func_));
@@ -542,12 +781,79 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
 #endif
   }
 
+  // Kernels linked with UDFs are kept out of the disk code cache, since the UDF modules
+  // can change between restarts of the same build.
+  auto disk_code_cache = includes_executor_addr || has_udf_module(/*is_gpu=*/false) ||
+                                 has_rt_udf_module(/*is_gpu=*/false)
+                             ? nullptr
+                             : DiskCodeCache::getInstance();
+  const bool found_on_disk = disk_code_cache && disk_code_cache->contains(key);
+
+  // The kernel is compiled quickly first and the optimized version is compiled in the
+  // background. Kernels bound to this executor are never shared through the cache, so
+  // they are not worth a second compilation.
+  const bool tiered_compilation = g_enable_tiered_cpu_compilation &&
+                                  co.opt_level == ExecutorOptLevel::Default &&
+                                  !includes_executor_addr && !found_on_disk;
+  if (disk_code_cache && !tiered_compilation) {
+    DiskCodeCache::tagModule(*M, key);
+  }
+  std::string bitcode;
+  std::string query_func_name;
+  std::string multifrag_query_func_name;
+  std::vector<std::string> live_func_names;
+  auto cpu_co = co;
+  if (tiered_compilation) {
+    llvm::raw_string_ostream os(bitcode);
+    llvm::WriteBitcodeToFile(*multifrag_query_func->getParent(), os);
+    os.flush();
+    query_func_name = query_func->getName().str();
+    multifrag_query_func_name = multifrag_query_func->getName().str();
+    for (const auto live_func : live_funcs) {
+      live_func_names.push_back(live_func->getName().str());
+    }
+    cpu_co.opt_level = ExecutorOptLevel::QuickJIT;
+  }
+
+  auto clock_begin = timer_start();
   auto execution_engine =
-      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, cpu_co);
   auto cpu_compilation_context =
       std::make_shared<CpuCompilationContext>(std::move(execution_engine));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
-  QueryEngine::getInstance()->cpu_code_accessor->put(key, cpu_compilation_context);
+  if (tiered_compilation) {
+    LOG(INFO) << "Tiered compilation: quick CPU kernel compiled in "
+              << timer_stop(clock_begin) << " ms";
+  }
+  const bool added_to_cache =
+      QueryEngine::getInstance()->cpu_code_accessor->put(key, cpu_compilation_context);
+  if (tiered_compilation && added_to_cache) {
+    TieredCpuCompiler::instance().enqueue([key,
+                                           bitcode = std::move(bitcode),
+                                           query_func_name,
+                                           multifrag_query_func_name,
+                                           live_func_names = std::move(live_func_names),
+                                           co,
+                                           persist = disk_code_cache != nullptr,
+                                           parent_thread_local_ids =
+                                               logger::thread_local_ids()]() {
+      logger::LocalIdsScopeGuard lisg = parent_thread_local_ids.setNewThreadId();
+      try {
+        compile_optimized_cpu_tier(key,
+                                   bitcode,
+                                   query_func_name,
+                                   multifrag_query_func_name,
+                                   live_func_names,
+                                   co,
+                                   persist);
+      } catch (const std::exception& e) {
+        // the quick kernel stays in the cache, and the query engine may be gone
+        // already if this runs at shutdown
+        LOG(WARNING) << "Tiered compilation: optimized CPU kernel not compiled, "
+                     << e.what();
+      }
+    });
+  }
   return std::dynamic_pointer_cast<CompilationContext>(cpu_compilation_context);
 }
 
@@ -844,6 +1150,18 @@ declare i1 @string_like_simple(i8*, i32, i8*, i32, i8);
 declare i1 @string_ilike_simple(i8*, i32, i8*, i32, i8);
 declare i8 @string_like_simple_nullable(i8*, i32, i8*, i32, i8, i8);
 declare i8 @string_ilike_simple_nullable(i8*, i32, i8*, i32, i8, i8);
+declare i1 @string_like_prefix(i8*, i32, i8*, i32, i8);
+declare i1 @string_ilike_prefix(i8*, i32, i8*, i32, i8);
+declare i1 @string_like_suffix(i8*, i32, i8*, i32, i8);
+declare i1 @string_ilike_suffix(i8*, i32, i8*, i32, i8);
+declare i1 @string_like_exact(i8*, i32, i8*, i32, i8);
+declare i1 @string_ilike_exact(i8*, i32, i8*, i32, i8);
+declare i8 @string_like_prefix_nullable(i8*, i32, i8*, i32, i8, i8);
+declare i8 @string_ilike_prefix_nullable(i8*, i32, i8*, i32, i8, i8);
+declare i8 @string_like_suffix_nullable(i8*, i32, i8*, i32, i8, i8);
+declare i8 @string_ilike_suffix_nullable(i8*, i32, i8*, i32, i8, i8);
+declare i8 @string_like_exact_nullable(i8*, i32, i8*, i32, i8, i8);
+declare i8 @string_ilike_exact_nullable(i8*, i32, i8*, i32, i8, i8);
 declare i1 @string_lt(i8*, i32, i8*, i32);
 declare i1 @string_le(i8*, i32, i8*, i32);
 declare i1 @string_gt(i8*, i32, i8*, i32);
@@ -2903,6 +3221,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
       const auto& count_distinct_descriptor =
           query_mem_desc->getCountDistinctDescriptor(i);
       if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::UnorderedSet ||
+          count_distinct_descriptor.impl_type_ == CountDistinctImplType::SparseHll ||
           (count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid &&
            !co.hoist_literals)) {
         throw QueryMustRunOnCpu();
@@ -27,6 +27,9 @@ bool PlanState::isLazyFetchColumn(const Analyzer::Expr* target_expr) const {
   if (!do_not_fetch_column || dynamic_cast<const Analyzer::Var*>(do_not_fetch_column)) {
     return false;
   }
+  if (null_extended_rte_idxs_.count(do_not_fetch_column->get_rte_idx())) {
+    return false;
+  }
   const auto& column_key = do_not_fetch_column->getColumnKey();
   if (column_key.table_id > 0) {
     const auto cd = get_column_descriptor(column_key);
@@ -83,7 +86,9 @@ int PlanState::getLocalColumnId(const Analyzer::ColumnVar* col_var,
     }
   }
   if (col_id && *col_id >= 0) {
-    if (fetch_column) {
+    // the columns of the inner table of a left join are never fetched lazily, hence
+    // they must be fetched to the device even when the caller allows a lazy fetch
+    if (fetch_column || null_extended_rte_idxs_.count(col_var->get_rte_idx())) {
       addColumnToFetch(global_col_key);
     }
     return *col_id;
@@ -38,6 +38,9 @@ struct JoinInfo {
                                // fold them to true during code generation
   std::vector<std::shared_ptr<HashJoin>> join_hash_tables_;
   std::unordered_set<size_t> sharded_range_table_indices_;
+  // inner tables of loop joins whose fragments are paired with the outer fragments by
+  // the ranges of the join keys, and thus are fetched one fragment at a time
+  std::unordered_set<size_t> aligned_range_table_indices_;
 };
 
 struct PlanState {
@@ -60,6 +63,8 @@ struct PlanState {
   std::unordered_map<size_t, std::vector<std::shared_ptr<Analyzer::Expr>>>
       left_join_non_hashtable_quals_;
   bool allow_lazy_fetch_;
+  // nest levels which are the inner table of a left join
+  std::unordered_set<int> null_extended_rte_idxs_;
   JoinInfo join_info_;
   const DeletedColumnsMap deleted_columns_;
   const std::vector<InputTableInfo>& query_infos_;
@@ -26,10 +26,13 @@
 #include "QueryMemoryInitializer.h"
 #include "RelAlgExecutionUnit.h"
 #include "ResultSet.h"
+#include "Shared/checked_alloc.h"
 #include "Shared/likely.h"
 #include "SpeculativeTopN.h"
 #include "StreamingTopN.h"
 
+extern int64_t g_bitmap_memory_limit;
+
 QueryExecutionContext::QueryExecutionContext(
     const RelAlgExecutionUnit& ra_exe_unit,
     const QueryMemoryDescriptor& query_mem_desc,
@@ -697,6 +700,14 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
     *error_code = 0;
   }
 
+  // the sparse HLL records of grouped APPROX_COUNT_DISTINCT grow while the kernel runs
+  if (row_set_mem_owner_) {
+    const auto sparse_hll_bytes = row_set_mem_owner_->getSparseHllBytes();
+    if (sparse_hll_bytes >= g_bitmap_memory_limit) {
+      throw OutOfHostMemory(sparse_hll_bytes);
+    }
+  }
+
   if (query_mem_desc_.useStreamingTopN()) {
     query_buffers_->applyStreamingTopNOffsetCpu(query_mem_desc_, ra_exe_unit);
   }
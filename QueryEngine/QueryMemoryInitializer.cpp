@@ -26,6 +26,8 @@
 
 // 8 GB, the limit of perfect hash group by under normal conditions
 int64_t g_bitmap_memory_limit{8LL * 1000 * 1000 * 1000};
+// Per kernel limit of the CPU group by buffer, 0 means no limit
+size_t g_max_cpu_group_by_buffer_size{0};
 
 namespace {
 
@@ -37,13 +39,20 @@ struct AddNbytes {
   }
 };
 
-inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_desc) {
+// The sparse HLL records only take their registers as they fill up, hence they count
+// with the bytes the records of the query already take, rather than the dense size.
+inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_desc,
+                                      const int64_t sparse_hll_bytes) {
   const size_t groups_buffer_entry_count = query_mem_desc.getEntryCount();
   checked_int64_t total_bytes_per_group = 0;
   const size_t num_count_distinct_descs =
       query_mem_desc.getCountDistinctDescriptorsSize();
   for (size_t i = 0; i < num_count_distinct_descs; i++) {
     const auto count_distinct_desc = query_mem_desc.getCountDistinctDescriptor(i);
+    if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll) {
+      total_bytes_per_group += sizeof(SparseHll);
+      continue;
+    }
     if (count_distinct_desc.impl_type_ != CountDistinctImplType::Bitmap) {
       continue;
     }
@@ -53,7 +62,8 @@ inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_des
   // Using OutOfHostMemory until we can verify that SlabTooBig would also be properly
   // caught
   try {
-    total_bytes = static_cast<int64_t>(total_bytes_per_group * groups_buffer_entry_count);
+    total_bytes = static_cast<int64_t>(total_bytes_per_group * groups_buffer_entry_count +
+                                       sparse_hll_bytes);
   } catch (...) {
     // Absurd amount of memory, merely computing the number of bits overflows int64_t.
     // Don't bother to report the real amount, this is unlikely to ever happen.
@@ -265,13 +275,15 @@ QueryMemoryInitializer::QueryMemoryInitializer(
   if (agg_op_metadata.has_count_distinct) {
     check_count_distinct_expr_metadata(query_mem_desc, ra_exe_unit);
     if (!ra_exe_unit.use_bump_allocator) {
-      check_total_bitmap_memory(query_mem_desc);
+      check_total_bitmap_memory(query_mem_desc, row_set_mem_owner_->getSparseHllBytes());
     }
     if (device_type == ExecutorDeviceType::GPU) {
       allocateCountDistinctGpuMem(query_mem_desc);
     }
     agg_op_metadata.count_distinct_buf_size =
         calculateCountDistinctBufferSize(query_mem_desc, ra_exe_unit);
+    agg_op_metadata.sparse_hll_bits =
+        calculateSparseHllBits(query_mem_desc, ra_exe_unit);
     size_t total_buffer_size{0};
     for (auto buffer_size : agg_op_metadata.count_distinct_buf_size) {
       if (buffer_size > 0) {
@@ -341,6 +353,11 @@ QueryMemoryInitializer::QueryMemoryInitializer(
   } else {
     group_buffer_size =
         query_mem_desc.getBufferSizeBytes(ra_exe_unit, thread_count, device_type);
+    if (device_type == ExecutorDeviceType::CPU && query_mem_desc.isGroupBy() &&
+        g_max_cpu_group_by_buffer_size &&
+        group_buffer_size > g_max_cpu_group_by_buffer_size) {
+      throw OutOfHostMemory(group_buffer_size);
+    }
   }
   CHECK_GE(group_buffer_size, size_t(0));
 
@@ -786,8 +803,12 @@ void QueryMemoryInitializer::initColumnsPerRow(
         const int64_t bm_sz{agg_op_metadata.count_distinct_buf_size[col_idx]};
         CHECK_EQ(static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(col_idx)),
                  sizeof(int64_t));
-        init_val =
-            bm_sz > 0 ? allocateCountDistinctBitmap(bm_sz) : allocateCountDistinctSet();
+        const auto sparse_hll_bits = agg_op_metadata.sparse_hll_bits[col_idx];
+        init_val = bm_sz > 0 ? allocateCountDistinctBitmap(bm_sz)
+                   : sparse_hll_bits
+                       ? allocateSparseHll(
+                             col_idx, sparse_hll_bits, query_mem_desc.getEntryCount())
+                       : allocateCountDistinctSet();
         CHECK_NE(init_val, 0);
         ++init_vec_idx;
       } else if (agg_op_metadata.has_tdigest &&
@@ -879,7 +900,8 @@ std::vector<int64_t> QueryMemoryInitializer::calculateCountDistinctBufferSize(
         const auto bitmap_byte_sz = count_distinct_desc.bitmapPaddedSizeBytes();
         agg_bitmap_size[agg_col_idx] = bitmap_byte_sz;
       } else {
-        CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::UnorderedSet);
+        CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::UnorderedSet ||
+              count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll);
         agg_bitmap_size[agg_col_idx] = -1;
       }
     }
@@ -887,6 +909,27 @@ std::vector<int64_t> QueryMemoryInitializer::calculateCountDistinctBufferSize(
   return agg_bitmap_size;
 }
 
+std::vector<uint32_t> QueryMemoryInitializer::calculateSparseHllBits(
+    const QueryMemoryDescriptor& query_mem_desc,
+    const RelAlgExecutionUnit& ra_exe_unit) const {
+  std::vector<uint32_t> sparse_hll_bits(query_mem_desc.getSlotCount());
+  for (size_t target_idx = 0; target_idx < ra_exe_unit.target_exprs.size();
+       ++target_idx) {
+    const auto target_expr = ra_exe_unit.target_exprs[target_idx];
+    const auto agg_info = get_target_info(target_expr, g_bigint_count);
+    if (is_distinct_target(agg_info)) {
+      const auto& count_distinct_desc =
+          query_mem_desc.getCountDistinctDescriptor(target_idx);
+      if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll) {
+        const size_t agg_col_idx =
+            query_mem_desc.getSlotIndexForSingleSlotCol(target_idx);
+        sparse_hll_bits[agg_col_idx] = count_distinct_desc.bitmap_sz_bits;
+      }
+    }
+  }
+  return sparse_hll_bits;
+}
+
 void QueryMemoryInitializer::allocateCountDistinctBuffers(
     const QueryMemoryDescriptor& query_mem_desc,
     const RelAlgExecutionUnit& ra_exe_unit) {
@@ -901,6 +944,9 @@ void QueryMemoryInitializer::allocateCountDistinctBuffers(
       if (count_distinct_desc.impl_type_ == CountDistinctImplType::Bitmap) {
         const auto bitmap_byte_sz = count_distinct_desc.bitmapPaddedSizeBytes();
         init_agg_vals_[agg_col_idx] = allocateCountDistinctBitmap(bitmap_byte_sz);
+      } else if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHll) {
+        init_agg_vals_[agg_col_idx] =
+            allocateSparseHll(agg_col_idx, count_distinct_desc.bitmap_sz_bits, 1);
       } else {
         CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::UnorderedSet);
         init_agg_vals_[agg_col_idx] = allocateCountDistinctSet();
@@ -928,6 +974,20 @@ int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
   return reinterpret_cast<int64_t>(count_distinct_set);
 }
 
+int64_t QueryMemoryInitializer::allocateSparseHll(const size_t col_idx,
+                                                  const uint32_t bitmap_sz_bits,
+                                                  const size_t block_size) {
+  if (sparse_hll_blocks_.size() <= col_idx) {
+    sparse_hll_blocks_.resize(col_idx + 1, {nullptr, nullptr});
+  }
+  auto& [next, end] = sparse_hll_blocks_[col_idx];
+  if (next == end) {
+    next = row_set_mem_owner_->allocateSparseHlls(block_size, bitmap_sz_bits);
+    end = next + block_size;
+  }
+  return reinterpret_cast<int64_t>(next++);
+}
+
 QueryMemoryInitializer::ModeIndexSet QueryMemoryInitializer::initializeModeIndexSet(
     const QueryMemoryDescriptor& query_mem_desc,
     const RelAlgExecutionUnit& ra_exe_unit) {
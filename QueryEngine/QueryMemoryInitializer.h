@@ -41,6 +41,7 @@ class QueryMemoryInitializer {
     bool has_mode{false};
     bool has_tdigest{false};
     std::vector<int64_t> count_distinct_buf_size;
+    std::vector<uint32_t> sparse_hll_bits;
     ModeIndexSet mode_index_set;
     std::vector<QuantileParam> quantile_params;
   };
@@ -191,6 +192,14 @@ class QueryMemoryInitializer {
 
   int64_t allocateCountDistinctSet();
 
+  std::vector<uint32_t> calculateSparseHllBits(
+      const QueryMemoryDescriptor& query_mem_desc,
+      const RelAlgExecutionUnit& ra_exe_unit) const;
+
+  int64_t allocateSparseHll(const size_t col_idx,
+                            const uint32_t bitmap_sz_bits,
+                            const size_t block_size);
+
   ModeIndexSet initializeModeIndexSet(const QueryMemoryDescriptor& query_mem_desc,
                                       const RelAlgExecutionUnit& ra_exe_unit);
 
@@ -264,6 +273,8 @@ class QueryMemoryInitializer {
   size_t count_distinct_bitmap_mem_size_;
   int8_t* count_distinct_bitmap_host_crt_ptr_;
   int8_t* count_distinct_bitmap_host_mem_ptr_;
+  // next and end of the block of sparse HLL records being handed out, per slot
+  std::vector<std::pair<SparseHll*, SparseHll*>> sparse_hll_blocks_;
 
   DeviceAllocator* device_allocator_{nullptr};
   std::vector<Data_Namespace::AbstractBuffer*> temporary_buffers_;
@@ -36,6 +36,8 @@
 extern bool g_cluster;
 extern bool g_enable_union;
 
+bool g_enable_partitioned_count_distinct{false};
+
 namespace {
 
 const unsigned FIRST_RA_NODE_ID = 1;
@@ -1414,6 +1416,12 @@ JoinType to_join_type(const std::string& join_type_name) {
   if (join_type_name == "anti") {
     return JoinType::ANTI;
   }
+  if (join_type_name == "right") {
+    return JoinType::RIGHT;
+  }
+  if (join_type_name == "full") {
+    return JoinType::FULL;
+  }
   throw QueryNotSupported("Join type (" + join_type_name + ") not supported");
 }
 
@@ -1570,6 +1578,161 @@ void bind_inputs(const std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept
   }
 }
 
+// Redirects the references to the inputs of a join, which is how the projects, filters
+// and table functions reading from the join bind their expressions, to the columns of a
+// node producing the join output in the same order.
+class RexRebindJoinInputsVisitor : public RexVisitor<void*> {
+ public:
+  RexRebindJoinInputsVisitor(const RelAlgNode* lhs,
+                             const RelAlgNode* rhs,
+                             const RelAlgNode* join_output)
+      : lhs_(lhs), rhs_(rhs), join_output_(join_output) {}
+
+  void* visitInput(const RexInput* rex_input) const override {
+    const auto source = rex_input->getSourceNode();
+    if (source == lhs_) {
+      rex_input->setSourceNode(join_output_);
+    } else if (source == rhs_) {
+      rex_input->setSourceNode(join_output_);
+      rex_input->setIndex(static_cast<unsigned>(lhs_->size()) + rex_input->getIndex());
+    }
+    return nullptr;
+  }
+
+ private:
+  const RelAlgNode* lhs_;
+  const RelAlgNode* rhs_;
+  const RelAlgNode* join_output_;
+};
+
+// Projects the columns of the inputs of a join, in the order of the given inputs.
+std::shared_ptr<RelProject> create_join_output_project(
+    std::shared_ptr<const RelAlgNode> join,
+    const RelAlgNode* lhs,
+    const RelAlgNode* rhs) {
+  std::vector<std::unique_ptr<const RexScalar>> scalar_exprs;
+  std::vector<std::string> fields;
+  for (const auto input : {lhs, rhs}) {
+    for (size_t i = 0; i < input->size(); ++i) {
+      scalar_exprs.emplace_back(std::make_unique<RexInput>(input, i));
+      fields.emplace_back("");
+    }
+  }
+  return std::make_shared<RelProject>(scalar_exprs, fields, join);
+}
+
+// Visits the expressions referencing the columns of the inputs of a node which can read
+// a join before the left-deep joins are built.
+void visit_input_references(const RelAlgNode* node, const RexVisitor<void*>& visitor) {
+  if (const auto project = dynamic_cast<const RelProject*>(node)) {
+    for (size_t i = 0; i < project->size(); ++i) {
+      visitor.visit(project->getProjectAt(i));
+    }
+  } else if (const auto filter = dynamic_cast<const RelFilter*>(node)) {
+    visitor.visit(filter->getCondition());
+  } else if (const auto join = dynamic_cast<const RelJoin*>(node)) {
+    if (join->getCondition()) {
+      visitor.visit(join->getCondition());
+    }
+  } else if (const auto table_func = dynamic_cast<const RelTableFunction*>(node)) {
+    for (size_t i = 0; i < table_func->getTableFuncInputsSize(); ++i) {
+      visitor.visit(table_func->getTableFuncInputAt(i));
+    }
+  }
+}
+
+// Makes the given consumers of a join read a project of the join output, inserted in
+// the node list before `insert_pos`. The consumers reference the join columns through
+// the join inputs, and the nodes reading from a consumer through the join itself.
+void redirect_join_consumers(
+    std::list<std::shared_ptr<RelAlgNode>>& node_list,
+    std::list<std::shared_ptr<RelAlgNode>>::iterator insert_pos,
+    const std::shared_ptr<const RelAlgNode>& join,
+    const RelAlgNode* lhs,
+    const RelAlgNode* rhs,
+    const std::vector<std::shared_ptr<RelAlgNode>>& consumers) {
+  const auto join_output = create_join_output_project(join, lhs, rhs);
+  const auto join_output_itr = node_list.insert(insert_pos, join_output);
+  RexRebindJoinInputsVisitor rebind_join_inputs(lhs, rhs, join_output.get());
+  for (const auto& consumer : consumers) {
+    consumer->replaceInput(join, join_output);
+    visit_input_references(consumer.get(), rebind_join_inputs);
+  }
+  RexRebindInputsVisitor rebind_join(join.get(), join_output.get());
+  for (auto node_itr = std::next(join_output_itr); node_itr != node_list.end();
+       ++node_itr) {
+    visit_input_references(node_itr->get(), rebind_join);
+  }
+}
+
+/**
+ * Rewrites the RIGHT and FULL outer joins before the left-deep joins are built. A RIGHT
+ * join swaps its inputs into a LEFT join, so that the preserved input becomes the outer
+ * (probe) table and the other input is built into the hash table, and each input is
+ * read once. A FULL join runs as a LEFT join flagging the matched inner rows, followed by
+ * a pass adding the unmatched ones (see RelAlgExecutor::executeWorkUnit), hence it must
+ * be the only level of its left-deep join and only projects read it. Joins which can't
+ * be part of the rewritten left-deep join, and consumers which can't read the rewritten
+ * join, get a project of the join output with the columns in the original order.
+ */
+void rewrite_right_and_full_joins(std::vector<std::shared_ptr<RelAlgNode>>& nodes) {
+  std::list<std::shared_ptr<RelAlgNode>> node_list(nodes.begin(), nodes.end());
+  bool rewritten{false};
+  for (auto node_itr = node_list.begin(); node_itr != node_list.end(); ++node_itr) {
+    const auto join = std::dynamic_pointer_cast<RelJoin>(*node_itr);
+    if (!join || (join->getJoinType() != JoinType::RIGHT &&
+                  join->getJoinType() != JoinType::FULL)) {
+      continue;
+    }
+    rewritten = true;
+    const bool is_full_join = join->getJoinType() == JoinType::FULL;
+    const auto lhs = join->getAndOwnInput(0);
+    const auto rhs = join->getAndOwnInput(1);
+    std::vector<std::shared_ptr<RelAlgNode>> consumers;
+    for (auto consumer_itr = std::next(node_itr); consumer_itr != node_list.end();
+         ++consumer_itr) {
+      if ((*consumer_itr)->hasInput(join.get())) {
+        consumers.push_back(*consumer_itr);
+      }
+    }
+    if (!is_full_join) {
+      VLOG(1) << "Rewrote RIGHT join " << join->getId() << " into a LEFT join.";
+      join->swapInputs();
+      join->setJoinType(JoinType::LEFT);
+    }
+    // projects and table functions bind their expressions to the join inputs, hence
+    // their output doesn't depend on the order of the join columns
+    const auto reads_join_inputs = [is_full_join](
+                                       const std::shared_ptr<RelAlgNode>& consumer) {
+      return std::dynamic_pointer_cast<RelProject>(consumer) ||
+             (!is_full_join && std::dynamic_pointer_cast<RelTableFunction>(consumer));
+    };
+    consumers.erase(
+        std::remove_if(consumers.begin(), consumers.end(), reads_join_inputs),
+        consumers.end());
+    if (!consumers.empty()) {
+      redirect_join_consumers(
+          node_list, std::next(node_itr), join, lhs.get(), rhs.get(), consumers);
+    }
+    // a left-deep join only continues through the outer input of its joins
+    for (size_t input_idx = is_full_join ? 0 : 1; input_idx < 2; ++input_idx) {
+      const auto input_join =
+          std::dynamic_pointer_cast<const RelJoin>(join->getAndOwnInput(input_idx));
+      if (input_join) {
+        redirect_join_consumers(node_list,
+                                node_itr,
+                                input_join,
+                                input_join->getInput(0),
+                                input_join->getInput(1),
+                                {join});
+      }
+    }
+  }
+  if (rewritten) {
+    nodes.assign(node_list.begin(), node_list.end());
+  }
+}
+
 void handle_query_hint(const std::vector<std::shared_ptr<RelAlgNode>>& nodes,
                        RelAlgDag& rel_alg_dag) noexcept {
   // query hint is delivered by the above three nodes
@@ -2006,6 +2169,13 @@ bool is_window_function_operator(const RexScalar* rex) {
          is_window_function_sum(rex) || is_window_function_avg(rex);
 }
 
+// The unmatched rows of a FULL outer join are added to its projection afterwards, hence
+// an aggregate can't be coalesced with the project reading the join.
+bool reads_full_join(const RelAlgNode* node) {
+  const auto join = dynamic_cast<const RelJoin*>(node->getInput(0));
+  return join && join->getJoinType() == JoinType::FULL;
+}
+
 }  // namespace
 
 void coalesce_nodes(
@@ -2060,7 +2230,8 @@ void coalesce_nodes(
         break;
       }
       case CoalesceState::FirstProject: {
-        if (std::dynamic_pointer_cast<const RelAggregate>(ra_node)) {
+        if (std::dynamic_pointer_cast<const RelAggregate>(ra_node) &&
+            !reads_full_join(nodes[crt_pattern.front()].get())) {
           crt_pattern.push_back(size_t(nodeIt));
           crt_state = CoalesceState::Aggregate;
           nodeIt.advance(RANodeIterator::AdvancingMode::DUChain);
@@ -2637,7 +2808,119 @@ std::pair<bool, bool> need_pushdown_generic_expr(
   }
   return std::make_pair(has_generic_expr_in_window_func, res);
 }
+
+// Resolves the type of a column which is passed through unchanged from a table scan,
+// returns nullopt for computed columns and for anything above a join.
+std::optional<SQLTypeInfo> get_scan_column_type(const RelAlgNode* node,
+                                                const size_t col_idx) {
+  if (auto scan = dynamic_cast<const RelScan*>(node)) {
+    const auto cd = scan->getCatalog().getMetadataForColumn(
+        scan->getTableDescriptor()->tableId, scan->getFieldName(col_idx));
+    return cd ? std::make_optional(cd->columnType) : std::nullopt;
+  }
+  if (dynamic_cast<const RelFilter*>(node)) {
+    return get_scan_column_type(node->getInput(0), col_idx);
+  }
+  if (auto project = dynamic_cast<const RelProject*>(node)) {
+    auto input = dynamic_cast<const RexInput*>(project->getProjectAt(col_idx));
+    if (input) {
+      return get_scan_column_type(input->getSourceNode(), input->getIndex());
+    }
+  }
+  return std::nullopt;
+}
+
+// Returns the operand shared by all the aggregates if they are all COUNT(DISTINCT x)
+// over the same plain column x, which can be used as a group by key.
+std::optional<size_t> get_common_count_distinct_operand(const RelAggregate* aggregate) {
+  const auto& agg_exprs = aggregate->getAggExprs();
+  if (agg_exprs.empty()) {
+    return std::nullopt;
+  }
+  const auto first_agg = agg_exprs.front().get();
+  if (first_agg->getKind() != kCOUNT || !first_agg->isDistinct() ||
+      first_agg->size() != 1) {
+    return std::nullopt;
+  }
+  const auto operand = first_agg->getOperand(0);
+  for (const auto& agg_expr : agg_exprs) {
+    if (agg_expr->getKind() != kCOUNT || !agg_expr->isDistinct() ||
+        agg_expr->size() != 1 || agg_expr->getOperand(0) != operand) {
+      return std::nullopt;
+    }
+  }
+  if (operand < aggregate->getGroupByCount()) {
+    return std::nullopt;
+  }
+  // arrays count their distinct elements, none encoded strings and geometries can't be
+  // grouped on
+  const auto operand_ti = get_scan_column_type(aggregate->getInput(0), operand);
+  if (!operand_ti || operand_ti->is_varlen()) {
+    return std::nullopt;
+  }
+  return operand;
+}
+
+/**
+ * Rewrites an aggregate computing only COUNT(DISTINCT x) into two aggregates: an inner
+ * one grouped by the original keys and x, which removes the duplicate (group, x) pairs,
+ * and an outer one counting the non-null x per original group. The inner aggregate is
+ * a regular hash group by, hence its buffers are reduced in parallel partitions and
+ * spilled like any other group by, whereas the per group hash sets of COUNT(DISTINCT)
+ * are merged one group at a time and can't be spilled. The original aggregate node is
+ * rewritten in place, so its parents keep pointing to it.
+ */
+void expand_count_distinct_aggregates(std::vector<std::shared_ptr<RelAlgNode>>& nodes) {
+  if (!g_enable_partitioned_count_distinct) {
+    return;
+  }
+  std::list<std::shared_ptr<RelAlgNode>> node_list(nodes.begin(), nodes.end());
+  for (auto node_itr = node_list.begin(); node_itr != node_list.end(); ++node_itr) {
+    auto aggregate = std::dynamic_pointer_cast<RelAggregate>(*node_itr);
+    if (!aggregate) {
+      continue;
+    }
+    const auto operand = get_common_count_distinct_operand(aggregate.get());
+    if (!operand) {
+      continue;
+    }
+    const auto groupby_count = aggregate->getGroupByCount();
+    const auto& fields = aggregate->getFields();
+    std::vector<std::string> inner_fields(fields.begin(),
+                                          fields.begin() + groupby_count);
+    inner_fields.push_back(fields[groupby_count]);
+    auto input = aggregate->getAndOwnInput(0);
+    std::shared_ptr<const RelAlgNode> inner_input = input;
+    if (*operand != groupby_count) {
+      // the inner group by keys must be the leading input columns
+      std::vector<std::unique_ptr<const RexScalar>> scalar_exprs;
+      for (size_t i = 0; i < groupby_count; ++i) {
+        scalar_exprs.emplace_back(std::make_unique<RexInput>(input.get(), i));
+      }
+      scalar_exprs.emplace_back(std::make_unique<RexInput>(input.get(), *operand));
+      auto project = std::make_shared<RelProject>(scalar_exprs, inner_fields, input);
+      node_list.insert(node_itr, project);
+      inner_input = project;
+    }
+    std::vector<std::unique_ptr<const RexAgg>> no_agg_exprs;
+    auto inner_aggregate = std::make_shared<RelAggregate>(
+        groupby_count + 1, no_agg_exprs, inner_fields, inner_input);
+    node_list.insert(node_itr, inner_aggregate);
+    std::vector<std::unique_ptr<const RexAgg>> count_exprs;
+    for (const auto& agg_expr : aggregate->getAggExprs()) {
+      count_exprs.emplace_back(std::make_unique<RexAgg>(
+          kCOUNT, false, agg_expr->getType(), std::vector<size_t>{groupby_count}));
+    }
+    aggregate->setAggExprs(count_exprs);
+    aggregate->replaceInput(input, inner_aggregate);
+    VLOG(1) << "Rewrote COUNT(DISTINCT) aggregate " << aggregate->getId()
+            << " into a two-phase aggregate.";
+  }
+  nodes.assign(node_list.begin(), node_list.end());
+}
+
 };  // namespace
+
 /**
  * Inserts a simple project before any project containing a window function node. Forces
  * all window function inputs into a single contiguous buffer for centralized processing
@@ -3398,6 +3681,7 @@ std::unique_ptr<RelAlgDag> RelAlgDagBuilder::build(const rapidjson::Value& query
   }
   CHECK(!nodes.empty());
   bind_inputs(nodes);
+  rewrite_right_and_full_joins(nodes);
 
   setBuildState(rel_alg_dag, RelAlgDag::BuildState::kBuiltNotOptimized);
 
@@ -3444,6 +3728,7 @@ void RelAlgDagBuilder::optimizeDag(RelAlgDag& rel_alg_dag) {
   if (filtered_left_deep_joins.empty()) {
     hoist_filter_cond_to_cross_join(nodes);
   }
+  expand_count_distinct_aggregates(nodes);
   eliminate_dead_columns(nodes);
   eliminate_dead_subqueries(subqueries, nodes.back().get());
   separate_window_function_expressions(nodes, query_hints);
@@ -1649,6 +1649,11 @@ class RelJoin : public RelAlgNode {
 
   JoinType getJoinType() const { return join_type_; }
 
+  void setJoinType(const JoinType join_type) { join_type_ = join_type; }
+
+  // The condition references the join inputs directly, hence it stays valid.
+  void swapInputs() { std::swap(inputs_[0], inputs_[1]); }
+
   const RexScalar* getCondition() const { return condition_.get(); }
 
   const RexScalar* getAndReleaseCondition() const { return condition_.release(); }
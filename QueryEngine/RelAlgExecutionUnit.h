@@ -158,6 +158,9 @@ struct SortInfo {
 struct JoinCondition {
   std::list<std::shared_ptr<Analyzer::Expr>> quals;
   JoinType type;
+  // set for the LEFT join a FULL outer join runs as: one flag per inner table row, set
+  // when the row matches, so that the unmatched inner rows can be added afterwards
+  std::shared_ptr<std::vector<int8_t>> matched_inner_rows{nullptr};
 };
 
 using JoinQualsPerNestingLevel = std::vector<JoinCondition>;
@@ -22,6 +22,7 @@
 #include "QueryEngine/CalciteDeserializerUtils.h"
 #include "QueryEngine/CardinalityEstimator.h"
 #include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/DeepCopyVisitor.h"
 #include "QueryEngine/EquiJoinCondition.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/ExpressionRewrite.h"
@@ -38,11 +39,13 @@
 #include "QueryEngine/RexVisitor.h"
 #include "QueryEngine/TableOptimizer.h"
 #include "QueryEngine/Visitors/RelAlgDagViewer.h"
+#include "QueryEngine/Visitors/RexSubQueryIdCollector.h"
 #include "QueryEngine/WindowContext.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/measure.h"
 #include "Shared/misc.h"
 #include "Shared/shard_key.h"
+#include "Shared/threading.h"
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/range/adaptor/reversed.hpp>
@@ -58,6 +61,12 @@ size_t g_estimator_failure_max_groupby_size{256000000};
 double g_ndv_groups_estimator_multiplier{2.0};
 bool g_columnar_large_projections{true};
 size_t g_columnar_large_projections_threshold{1000000};
+bool g_columnar_intermediate_projections{false};
+size_t g_columnar_intermediate_projections_threshold{100000};
+bool g_enable_concurrent_subqueries{false};
+size_t g_max_concurrent_subqueries{4};
+bool g_enable_group_by_spill{false};
+size_t g_group_by_spill_partition_count{8};
 
 extern bool g_enable_watchdog;
 extern size_t g_watchdog_none_encoded_string_translation_limit;
@@ -65,6 +74,7 @@ extern size_t g_preflight_count_query_threshold;
 extern bool g_enable_bump_allocator;
 extern size_t g_default_max_groups_buffer_entry_guess;
 extern bool g_enable_system_tables;
+extern size_t g_max_cpu_group_by_buffer_size;
 
 namespace {
 
@@ -726,31 +736,155 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
   timer_setup.stop();
 
   // Dispatch the subqueries first
+  executeSubqueries(co, eo);
+  return executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
+}
+
+namespace {
+
+// Helper executors for concurrent subqueries get ids derived from the id of the
+// executor running the parent query, so that concurrent queries never share one.
+Executor::ExecutorId get_subquery_executor_id(
+    const Executor::ExecutorId parent_executor_id,
+    const size_t slot) {
+  constexpr Executor::ExecutorId kSubqueryExecutorIdBase{Executor::ExecutorId(1) << 20};
+  CHECK_GT(slot, size_t(0));
+  CHECK_LT(slot, g_max_concurrent_subqueries);
+  return kSubqueryExecutorIdBase + parent_executor_id * g_max_concurrent_subqueries +
+         slot;
+}
+
+}  // namespace
+
+void RelAlgExecutor::executeSubquery(RexSubQuery* subquery,
+                                     Executor* executor,
+                                     const CompilationOptions& co,
+                                     const ExecutionOptions& eo) {
+  const auto subquery_ra = subquery->getRelAlg();
+  CHECK(subquery_ra);
+  // Execute the subquery and cache the result.
+  RelAlgExecutor subquery_executor(executor, query_state_);
+  // Propagate global and local query hint if necessary
   const auto global_hints = getGlobalQueryHint();
+  const auto local_hints = getParsedQueryHint(subquery_ra);
+  if (global_hints || local_hints) {
+    const auto subquery_rel_alg_dag = subquery_executor.getRelAlgDag();
+    if (global_hints) {
+      subquery_rel_alg_dag->setGlobalQueryHints(*global_hints);
+    }
+    if (local_hints) {
+      subquery_rel_alg_dag->registerQueryHint(subquery_ra, *local_hints);
+    }
+  }
+  const bool uses_helper_executor = executor != executor_;
+  if (uses_helper_executor) {
+    // the parent query has only set up the caches of its own executor
+    subquery_executor.setupCaching(subquery_ra);
+  }
+  ScopeGuard cleanup_helper_executor = [&subquery_executor,
+                                        executor,
+                                        uses_helper_executor] {
+    if (uses_helper_executor) {
+      subquery_executor.cleanupPostExecution();
+      executor->clearMetaInfoCache();
+    }
+  };
+  RaExecutionSequence subquery_seq(subquery_ra, executor);
+  auto result = subquery_executor.executeRelAlgSeq(subquery_seq, co, eo, nullptr, 0);
+  subquery->setExecutionResult(std::make_shared<ExecutionResult>(result));
+}
+
+void RelAlgExecutor::executeSubqueries(const CompilationOptions& co,
+                                       const ExecutionOptions& eo) {
+  std::vector<RexSubQuery*> pending_subqueries;
   for (auto subquery : getSubqueries()) {
     const auto subquery_ra = subquery->getRelAlg();
     CHECK(subquery_ra);
-    if (subquery_ra->hasContextData()) {
-      continue;
+    if (!subquery_ra->hasContextData()) {
+      pending_subqueries.push_back(subquery.get());
+    }
+  }
+  if (g_enable_concurrent_subqueries && g_max_concurrent_subqueries > 1 && !g_cluster &&
+      pending_subqueries.size() > 1) {
+    // Subqueries without nested subqueries do not depend on each other, so they are
+    // spread over a few executors and run concurrently. The remaining ones consume
+    // the results of their nested subqueries and run afterwards, in dependency order.
+    std::vector<RexSubQuery*> independent_subqueries;
+    std::vector<RexSubQuery*> dependent_subqueries;
+    for (auto subquery : pending_subqueries) {
+      if (RexSubQueryIdCollector::getLiveRexSubQueryIds(subquery->getRelAlg()).empty()) {
+        independent_subqueries.push_back(subquery);
+      } else {
+        dependent_subqueries.push_back(subquery);
+      }
     }
-    // Execute the subquery and cache the result.
-    RelAlgExecutor subquery_executor(executor_, query_state_);
-    // Propagate global and local query hint if necessary
-    const auto local_hints = getParsedQueryHint(subquery_ra);
-    if (global_hints || local_hints) {
-      const auto subquery_rel_alg_dag = subquery_executor.getRelAlgDag();
-      if (global_hints) {
-        subquery_rel_alg_dag->setGlobalQueryHints(*global_hints);
+    if (independent_subqueries.size() > 1) {
+      const size_t slot_count =
+          std::min(independent_subqueries.size(), g_max_concurrent_subqueries);
+      SystemParameters system_parameters;
+      system_parameters.cuda_block_size = executor_->blockSize();
+      system_parameters.cuda_grid_size = executor_->gridSize();
+      system_parameters.max_gpu_slab_size = executor_->maxGpuSlabSize();
+      std::vector<std::shared_ptr<Executor>> helper_executors;
+      for (size_t slot = 1; slot < slot_count; ++slot) {
+        helper_executors.push_back(Executor::getExecutor(
+            get_subquery_executor_id(executor_->getExecutorId(), slot),
+            "",
+            "",
+            system_parameters));
       }
-      if (local_hints) {
-        subquery_rel_alg_dag->registerQueryHint(subquery_ra, *local_hints);
+      // helper executors are not attached to the query session
+      auto helper_eo = eo;
+      helper_eo.allow_runtime_query_interrupt = false;
+      // The executors share one grant of CPU slots for the whole batch and split its
+      // threads, instead of each query step requesting slots for a full-size arena.
+      size_t num_cpu_slots = static_cast<size_t>(cpu_threads());
+      std::unique_ptr<ExecutorResourceMgr_Namespace::ExecutorResourceHandle>
+          resource_handle;
+      if (g_enable_executor_resource_mgr) {
+        CHECK(Executor::executor_resource_mgr_);
+        const size_t min_cpu_slots{1};
+        resource_handle = Executor::executor_resource_mgr_->request_resources(
+            ExecutorResourceMgr_Namespace::RequestInfo(
+                ExecutorDeviceType::CPU,
+                static_cast<size_t>(0),  // priority_level
+                num_cpu_slots,           // cpu_slots
+                min_cpu_slots,           // min_cpu_slots
+                size_t(0),               // gpu_slots
+                size_t(0),               // min_gpu_slots
+                size_t(0),               // cpu_result_mem
+                size_t(0),               // min_cpu_result_mem
+                {},                      // chunks needed
+                false));                 // output_buffers_reusable_intra_thread
+        num_cpu_slots = resource_handle->get_resource_grant().cpu_slots;
       }
+      const size_t kernel_thread_limit = std::max(num_cpu_slots / slot_count, size_t(1));
+      VLOG(1) << "Executing " << independent_subqueries.size()
+              << " independent subqueries on " << slot_count << " executors with "
+              << kernel_thread_limit << " threads each";
+      threading::task_group subquery_tasks;
+      for (size_t slot = 0; slot < slot_count; ++slot) {
+        subquery_tasks.run([&, slot] {
+          const auto executor = slot ? helper_executors[slot - 1].get() : executor_;
+          executor->setKernelThreadLimit(kernel_thread_limit);
+          ScopeGuard reset_kernel_thread_limit = [executor] {
+            executor->setKernelThreadLimit(0);
+          };
+          for (size_t i = slot; i < independent_subqueries.size(); i += slot_count) {
+            executeSubquery(
+                independent_subqueries[i], executor, co, slot ? helper_eo : eo);
+          }
+        });
+      }
+      subquery_tasks.wait();
+      // executing a subquery points the executor at the subquery's temporary tables
+      executor_->temporary_tables_ = &temporary_tables_;
+      pending_subqueries = std::move(dependent_subqueries);
     }
-    RaExecutionSequence subquery_seq(subquery_ra, executor_);
-    auto result = subquery_executor.executeRelAlgSeq(subquery_seq, co, eo, nullptr, 0);
-    subquery->setExecutionResult(std::make_shared<ExecutionResult>(result));
   }
-  return executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
+  for (auto subquery : pending_subqueries) {
+    executeSubquery(subquery, executor_, co, eo);
+  }
 }
 
 AggregatedColRange RelAlgExecutor::computeColRangesCache() {
@@ -1173,6 +1307,7 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
       eo.with_watchdog && (step_idx == 0 || dynamic_cast<const RelProject*>(body));
   eo_copied.outer_fragment_indices =
       step_idx == 0 ? eo.outer_fragment_indices : std::vector<size_t>();
+  eo_copied.is_intermediate_step = step_idx + 1 < seq.size();
 
   auto target_node = body;
   auto query_plan_dag_hash = body->getQueryPlanDagHash();
@@ -2326,6 +2461,14 @@ bool is_window_execution_unit(const RelAlgExecutionUnit& ra_exe_unit) {
                      });
 }
 
+bool has_full_outer_join(const RelAlgExecutionUnit& ra_exe_unit) {
+  return std::any_of(ra_exe_unit.join_quals.begin(),
+                     ra_exe_unit.join_quals.end(),
+                     [](const JoinCondition& join_condition) {
+                       return join_condition.matched_inner_rows != nullptr;
+                     });
+}
+
 }  // namespace
 
 ExecutionResult RelAlgExecutor::executeProject(
@@ -2941,7 +3084,10 @@ ExecutionResult RelAlgExecutor::executeSimpleInsert(
     col_ids.push_back(col_id);
   }
 
-  Executor::clearExternalCaches(true, td, catalog.getDatabaseId());
+  Executor::clearExternalCachesForAppend(td, catalog.getDatabaseId());
+  ScopeGuard clear_caches_after_append = [td] {
+    Executor::clearExternalCachesAfterAppend(td);
+  };
 
   size_t start_row = 0;
   size_t rows_left = rows_number;
@@ -3421,7 +3567,11 @@ RelAlgExecutor::WorkUnit RelAlgExecutor::createSortInputWorkUnit(
 
   if (source_exe_unit.groupby_exprs.size() == 1) {
     if (!source_exe_unit.groupby_exprs.front()) {
-      sort_algorithm = SortAlgorithm::StreamingTopN;
+      // the unmatched rows of a FULL outer join are appended to the projection, and
+      // sorted together with it in executeSort
+      sort_algorithm = has_full_outer_join(source_exe_unit)
+                           ? SortAlgorithm::Default
+                           : SortAlgorithm::StreamingTopN;
     } else {
       if (speculative_topn_blacklist_.contains(source_exe_unit.groupby_exprs.front(),
                                                first_oe_is_desc(order_entries))) {
@@ -3649,6 +3799,156 @@ inline bool can_use_bump_allocator(const RelAlgExecutionUnit& ra_exe_unit,
          !eo.output_columnar_hint && ra_exe_unit.sort_info.order_entries.empty();
 }
 
+// Dictionary encoded strings must come straight from a column: ids produced by string
+// operators are transient and owned by the row set memory owner we drop on spill.
+bool is_spillable_string_expr(const Analyzer::Expr* expr) {
+  const auto& ti = expr->get_type_info();
+  return !ti.is_string() || dynamic_cast<const Analyzer::ColumnVar*>(expr);
+}
+
+// Returns the group by key used to hash partition a group by which ran out of CPU
+// memory, or nullptr if the results of the partitions cannot simply be concatenated.
+std::shared_ptr<Analyzer::Expr> get_spill_partition_key(
+    const RelAlgExecutionUnit& ra_exe_unit) {
+  if (ra_exe_unit.groupby_exprs.empty() || !ra_exe_unit.groupby_exprs.front() ||
+      ra_exe_unit.estimator || ra_exe_unit.union_all || ra_exe_unit.scan_limit ||
+      ra_exe_unit.sort_info.limit || ra_exe_unit.sort_info.offset ||
+      ra_exe_unit.sort_info.algorithm == SortAlgorithm::StreamingTopN) {
+    return nullptr;
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    const auto& ti = target_expr->get_type_info();
+    if (ti.is_varlen()) {
+      return nullptr;
+    }
+    const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+    if (!agg_expr) {
+      if (!is_spillable_string_expr(target_expr)) {
+        return nullptr;
+      }
+      continue;
+    }
+    // These aggregates keep pointers into the row set memory owner
+    const auto agg_type = agg_expr->get_aggtype();
+    if (agg_expr->get_is_distinct() || agg_type == kAPPROX_COUNT_DISTINCT ||
+        agg_type == kAPPROX_QUANTILE || agg_type == kMODE) {
+      return nullptr;
+    }
+    if (agg_expr->get_arg() && !is_spillable_string_expr(agg_expr->get_arg())) {
+      return nullptr;
+    }
+  }
+  std::shared_ptr<Analyzer::Expr> partition_key;
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    const auto& ti = groupby_expr->get_type_info();
+    if (!is_spillable_string_expr(groupby_expr.get())) {
+      return nullptr;
+    }
+    if (!partition_key && (ti.is_integer() || ti.is_dict_encoded_string())) {
+      partition_key = groupby_expr;
+    }
+  }
+  return partition_key;
+}
+
+// Builds the filter selecting the groups of the spill partitions [first_partition,
+// end_partition). Negative keys have negative remainders and land in the partition of
+// their absolute value, NULL keys land in partition zero.
+std::shared_ptr<Analyzer::Expr> make_spill_partition_qual(
+    const std::shared_ptr<Analyzer::Expr>& partition_key,
+    const size_t first_partition,
+    const size_t end_partition,
+    const size_t partition_count) {
+  CHECK_LT(first_partition, end_partition);
+  auto key = partition_key->get_type_info().is_string()
+                 ? makeExpr<Analyzer::KeyForStringExpr>(partition_key)
+                 : partition_key;
+  const bool notnull = key->get_type_info().get_notnull();
+  key = key->add_cast(SQLTypeInfo(kBIGINT, notnull));
+  const auto make_bigint = [](const int64_t val) {
+    Datum d;
+    d.bigintval = val;
+    return makeExpr<Analyzer::Constant>(kBIGINT, false, d);
+  };
+  const auto remainder =
+      makeExpr<Analyzer::BinOper>(SQLTypeInfo(kBIGINT, notnull),
+                                  false,
+                                  kMODULO,
+                                  kONE,
+                                  key,
+                                  make_bigint(static_cast<int64_t>(partition_count)));
+  const auto make_range = [&remainder, &make_bigint](const SQLOps lower_op,
+                                                     const int64_t lower,
+                                                     const SQLOps upper_op,
+                                                     const int64_t upper) {
+    return makeExpr<Analyzer::BinOper>(
+        kBOOLEAN,
+        kAND,
+        kONE,
+        makeExpr<Analyzer::BinOper>(
+            kBOOLEAN, lower_op, kONE, remainder, make_bigint(lower)),
+        makeExpr<Analyzer::BinOper>(
+            kBOOLEAN, upper_op, kONE, remainder, make_bigint(upper)));
+  };
+  const auto first_val = static_cast<int64_t>(first_partition);
+  const auto end_val = static_cast<int64_t>(end_partition);
+  std::shared_ptr<Analyzer::Expr> qual =
+      makeExpr<Analyzer::BinOper>(kBOOLEAN,
+                                  kOR,
+                                  kONE,
+                                  make_range(kGE, first_val, kLT, end_val),
+                                  make_range(kGT, -end_val, kLE, -first_val));
+  if (!first_partition && !notnull) {
+    qual = makeExpr<Analyzer::BinOper>(
+        kBOOLEAN,
+        kOR,
+        kONE,
+        qual,
+        makeExpr<Analyzer::UOper>(kBOOLEAN, kISNULL, partition_key));
+  }
+  return qual;
+}
+
+// Copies the occupied entries of a baseline hash group by buffer into a storage holding
+// just them. The entries carry their own keys and are not probed anymore.
+std::shared_ptr<ResultSet> compact_spill_partition_rows(
+    const ResultSet& rows,
+    const std::vector<TargetInfo>& targets,
+    const std::vector<int64_t>& target_init_vals,
+    const std::shared_ptr<RowSetMemoryOwner>& row_set_mem_owner,
+    const Executor* executor) {
+  const auto storage = rows.getStorage();
+  CHECK(storage);
+  const auto& query_mem_desc = rows.getQueryMemDesc();
+  CHECK(!query_mem_desc.didOutputColumnar());
+  std::vector<size_t> occupied_entries;
+  for (size_t entry_idx = 0; entry_idx < query_mem_desc.getEntryCount(); ++entry_idx) {
+    if (!storage->isEmptyEntry(entry_idx)) {
+      occupied_entries.push_back(entry_idx);
+    }
+  }
+  if (occupied_entries.empty()) {
+    return nullptr;
+  }
+  auto compact_query_mem_desc = query_mem_desc;
+  compact_query_mem_desc.setEntryCount(occupied_entries.size());
+  auto compact_rows = std::make_shared<ResultSet>(targets,
+                                                  ExecutorDeviceType::CPU,
+                                                  compact_query_mem_desc,
+                                                  row_set_mem_owner,
+                                                  executor->blockSize(),
+                                                  executor->gridSize());
+  const auto compact_storage = compact_rows->allocateStorage(target_init_vals);
+  const auto row_size = query_mem_desc.getRowSize();
+  const auto src = storage->getUnderlyingBuffer();
+  auto dst = compact_storage->getUnderlyingBuffer();
+  for (const auto entry_idx : occupied_entries) {
+    memcpy(dst, src + entry_idx * row_size, row_size);
+    dst += row_size;
+  }
+  return compact_rows;
+}
+
 }  // namespace
 
 ExecutionResult RelAlgExecutor::executeWorkUnit(
@@ -3683,7 +3983,14 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     co.allow_lazy_fetch = false;
     computeWindow(work_unit, co, eo, column_cache, queue_time_ms);
   }
-  if (!eo.just_explain && eo.find_push_down_candidates) {
+  const bool has_full_join = has_full_outer_join(work_unit.exe_unit);
+  if (has_full_join) {
+    // the matched inner rows are flagged in host memory, and the unmatched ones are
+    // appended to the result, which needs the same layout
+    co.device_type = ExecutorDeviceType::CPU;
+    co.allow_lazy_fetch = false;
+  }
+  if (!eo.just_explain && eo.find_push_down_candidates && !has_full_join) {
     // find potential candidates:
     VLOG(1) << "Try to find filter predicate push-down candidate.";
     auto selected_filters = selectFiltersToBePushedDown(work_unit, co, eo);
@@ -3720,6 +4027,24 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
 
   auto ra_exe_unit = decide_approx_count_distinct_implementation(
       work_unit.exe_unit, table_infos, executor_, co.device_type, target_exprs_owned_);
+  if (has_full_join) {
+    for (size_t level_idx = 0; level_idx < ra_exe_unit.join_quals.size(); ++level_idx) {
+      const auto& matched_inner_rows =
+          ra_exe_unit.join_quals[level_idx].matched_inner_rows;
+      if (matched_inner_rows) {
+        // one flag per row of the inner table, whose fragments the join reads as one
+        CHECK_LT(level_idx + 1, table_infos.size());
+        size_t inner_row_count{0};
+        for (const auto& fragment : table_infos[level_idx + 1].info.fragments) {
+          inner_row_count += fragment.getNumTuples();
+        }
+        matched_inner_rows->assign(inner_row_count, 0);
+      }
+    }
+    // a LIMIT can't stop the join early, the inner rows matched by the outer rows it
+    // doesn't reach would be added as unmatched
+    ra_exe_unit.scan_limit = 0;
+  }
 
   // register query hint if query_dag_ is valid
   ra_exe_unit.query_hint = RegisteredQueryHint::defaults();
@@ -3819,7 +4144,7 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
               has_limit_value && !ra_exe_unit.sort_info.order_entries.empty();
           // top-k sort query needs to get a global result before sorting, so we cannot
           // apply LIMIT value at this point
-          if (has_limit_value && !top_k_sort_query &&
+          if (has_limit_value && !top_k_sort_query && !has_full_join &&
               ra_exe_unit.scan_limit > ra_exe_unit.sort_info.limit.value()) {
             ra_exe_unit.scan_limit = ra_exe_unit.sort_info.limit.value();
             VLOG(1) << "Override scan limit to LIMIT value: " << ra_exe_unit.scan_limit;
@@ -3839,6 +4164,16 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
               << g_columnar_large_projections_threshold
               << " or some target uses FlatBuffer memory layout.";
       eo.output_columnar_hint = true;
+    } else if (!eo.output_columnar_hint && eo.is_intermediate_step &&
+               g_columnar_intermediate_projections && !g_cluster &&
+               ra_exe_unit.scan_limit >= g_columnar_intermediate_projections_threshold) {
+      // the next step consumes this result as its input table, and a columnar
+      // projection can be handed over column by column (or zero-copy) instead of
+      // being converted row by row
+      VLOG(1) << "Using columnar layout for intermediate projection step as output "
+              << "size of " << ra_exe_unit.scan_limit << " rows exceeds threshold of "
+              << g_columnar_intermediate_projections_threshold;
+      eo.output_columnar_hint = true;
     }
   } else {
     eo.output_columnar_hint = false;
@@ -3874,7 +4209,10 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
       if (!has_ndv_estimation && e.getErrorCode() < 0) {
         throw CardinalityEstimationRequired(/*range=*/0);
       }
-      handlePersistentError(e.getErrorCode());
+      if (e.getErrorCode() != int32_t(ErrorCode::OUT_OF_CPU_MEM) ||
+          !g_enable_group_by_spill || !get_spill_partition_key(ra_exe_unit)) {
+        handlePersistentError(e.getErrorCode());
+      }
       return handleOutOfMemoryRetry(
           {ra_exe_unit, work_unit.body, local_groups_buffer_entry_guess},
           column_cache,
@@ -3957,6 +4295,10 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   }
 
+  if (has_full_join && !eo.just_explain && !eo.just_validate) {
+    addUnmatchedInnerRows(result, ra_exe_unit, co, eo, column_cache);
+  }
+
   result.setQueueTime(queue_time_ms);
   if (render_info) {
     build_render_targets(*render_info, work_unit.exe_unit.target_exprs, targets_meta);
@@ -4031,6 +4373,138 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
   return result;
 }
 
+namespace {
+
+// Binds the expressions of a FULL outer join to its inner table, with nulls for the
+// columns of the outer table.
+class NullExtendOuterTableVisitor : public DeepCopyVisitor {
+ protected:
+  std::shared_ptr<Analyzer::Expr> visitColumnVar(
+      const Analyzer::ColumnVar* col_var) const override {
+    if (col_var->get_rte_idx() == 0) {
+      return makeExpr<Analyzer::Constant>(col_var->get_type_info(), true, Datum{0});
+    }
+    CHECK_EQ(col_var->get_rte_idx(), 1);
+    return makeExpr<Analyzer::ColumnVar>(
+        col_var->get_type_info(), col_var->getColumnKey(), 0);
+  }
+};
+
+}  // namespace
+
+// A FULL outer join runs as a LEFT join which flags the inner rows it matches. The
+// unmatched inner rows then go through the same targets and filters, with nulls for the
+// outer table, and are appended to the result of the join.
+void RelAlgExecutor::addUnmatchedInnerRows(ExecutionResult& result,
+                                           const RelAlgExecutionUnit& ra_exe_unit,
+                                           const CompilationOptions& co,
+                                           const ExecutionOptions& eo,
+                                           ColumnCacheMap& column_cache) {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK_EQ(ra_exe_unit.input_descs.size(), size_t(2));
+  CHECK_EQ(ra_exe_unit.join_quals.size(), size_t(1));
+  const auto& matched_inner_rows = ra_exe_unit.join_quals.front().matched_inner_rows;
+  CHECK(matched_inner_rows);
+  std::vector<int64_t> unmatched_inner_rows;
+  for (size_t row_idx = 0; row_idx < matched_inner_rows->size(); ++row_idx) {
+    if (!(*matched_inner_rows)[row_idx]) {
+      unmatched_inner_rows.push_back(row_idx);
+    }
+  }
+  VLOG(1) << "FULL outer join: " << unmatched_inner_rows.size() << " of "
+          << matched_inner_rows->size() << " inner rows without a match";
+  if (unmatched_inner_rows.empty()) {
+    return;
+  }
+  const auto& inner_table_key = ra_exe_unit.input_descs[1].getTableKey();
+  std::vector<InputDescriptor> input_descs{
+      InputDescriptor(inner_table_key.db_id, inner_table_key.table_id, 0)};
+  std::list<std::shared_ptr<const InputColDescriptor>> input_col_descs;
+  for (const auto& input_col_desc : ra_exe_unit.input_col_descs) {
+    if (input_col_desc->getScanDesc().getNestLevel() == 1) {
+      input_col_descs.push_back(
+          std::make_shared<const InputColDescriptor>(input_col_desc->getColId(),
+                                                     inner_table_key.table_id,
+                                                     inner_table_key.db_id,
+                                                     0));
+    }
+  }
+  // the join identifies an inner row by its position in the inner table, which is the
+  // rowid of a physical table and the offset in the single fragment of a result
+  std::shared_ptr<Analyzer::Expr> inner_row_id;
+  if (inner_table_key.table_id > 0) {
+    const auto catalog =
+        Catalog_Namespace::SysCatalog::instance().getCatalog(inner_table_key.db_id);
+    CHECK(catalog);
+    const auto rowid_cd =
+        catalog->getMetadataForColumn(inner_table_key.table_id, "rowid");
+    CHECK(rowid_cd);
+    inner_row_id = makeExpr<Analyzer::ColumnVar>(
+        rowid_cd->columnType,
+        shared::ColumnKey{
+            inner_table_key.db_id, inner_table_key.table_id, rowid_cd->columnId},
+        0);
+    if (std::none_of(input_col_descs.begin(),
+                     input_col_descs.end(),
+                     [rowid_cd](const auto& input_col_desc) {
+                       return input_col_desc->getColId() == rowid_cd->columnId;
+                     })) {
+      input_col_descs.push_back(std::make_shared<const InputColDescriptor>(
+          rowid_cd->columnId, inner_table_key.table_id, inner_table_key.db_id, 0));
+    }
+  } else {
+    inner_row_id = makeExpr<Analyzer::OffsetInFragment>();
+  }
+  NullExtendOuterTableVisitor null_extend_outer_table;
+  std::list<std::shared_ptr<Analyzer::Expr>> quals{makeExpr<Analyzer::InIntegerSet>(
+      inner_row_id, unmatched_inner_rows, /*not_null=*/true)};
+  for (const auto& qual : ra_exe_unit.simple_quals) {
+    quals.push_back(null_extend_outer_table.visit(qual.get()));
+  }
+  for (const auto& qual : ra_exe_unit.quals) {
+    quals.push_back(null_extend_outer_table.visit(qual.get()));
+  }
+  std::vector<Analyzer::Expr*> target_exprs;
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    target_exprs_owned_.push_back(null_extend_outer_table.visit(target_expr));
+    target_exprs.push_back(target_exprs_owned_.back().get());
+  }
+  RelAlgExecutionUnit unmatched_exe_unit{input_descs,
+                                         input_col_descs,
+                                         {},
+                                         quals,
+                                         {},
+                                         ra_exe_unit.groupby_exprs,
+                                         target_exprs,
+                                         ra_exe_unit.target_exprs_original_type_infos,
+                                         nullptr,
+                                         SortInfo(),
+                                         unmatched_inner_rows.size(),
+                                         ra_exe_unit.query_hint};
+  const auto table_infos = get_table_infos(input_descs, executor_);
+  size_t max_groups_buffer_entry_guess{unmatched_inner_rows.size()};
+  auto unmatched_rows = executor_->executeWorkUnit(max_groups_buffer_entry_guess,
+                                                   /*is_agg=*/false,
+                                                   table_infos,
+                                                   unmatched_exe_unit,
+                                                   co,
+                                                   eo,
+                                                   nullptr,
+                                                   /*has_cardinality_estimation=*/true,
+                                                   column_cache);
+  CHECK(unmatched_rows);
+  auto rows = result.getRows();
+  if (rows->definitelyHasNoRows()) {
+    result = ExecutionResult(unmatched_rows, result.getTargetsMeta());
+  } else if (!unmatched_rows->definitelyHasNoRows()) {
+    CHECK_EQ(rows->getQueryMemDesc().didOutputColumnar(),
+             unmatched_rows->getQueryMemDesc().didOutputColumnar());
+    CHECK_EQ(rows->getQueryMemDesc().getRowSize(),
+             unmatched_rows->getQueryMemDesc().getRowSize());
+    rows->append(*unmatched_rows);
+  }
+}
+
 bool RelAlgExecutor::hasDeletedRowInQuery(
     std::vector<InputTableInfo> const& input_tables_info) const {
   return std::any_of(
@@ -4193,6 +4667,43 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   eo_no_multifrag.setNoExplainExecutionOptions(true);
   eo_no_multifrag.allow_multifrag = false;
   eo_no_multifrag.find_push_down_candidates = false;
+  const auto co_cpu = CompilationOptions::makeCpuOnly(co);
+
+  // Running out of CPU memory again is certain without a smaller working set, so a group
+  // by is split into hash partitions of its groups which are run a few at a time instead.
+  const auto execute_with_spill = [&](const RelAlgExecutionUnit& ra_exe_unit,
+                                      const int32_t error_code) -> ExecutionResult {
+    const auto partition_key =
+        g_enable_group_by_spill ? get_spill_partition_key(ra_exe_unit) : nullptr;
+    if (!partition_key) {
+      handlePersistentError(error_code);
+    }
+    LOG(WARNING) << "Group by query ran out of CPU memory, retrying in "
+                 << g_group_by_spill_partition_count << " hash partitions.";
+    ExecutionResult spill_result;
+    try {
+      spill_result = executeWorkUnitWithSpill(ra_exe_unit,
+                                              partition_key,
+                                              max_groups_buffer_entry_guess,
+                                              column_cache,
+                                              targets_meta,
+                                              is_agg,
+                                              co_cpu,
+                                              eo_no_multifrag);
+    } catch (const QueryExecutionError& spill_e) {
+      handlePersistentError(spill_e.getErrorCode());
+    }
+    spill_result.setQueueTime(queue_time_ms);
+    return spill_result;
+  };
+  if (e.getErrorCode() == int32_t(ErrorCode::OUT_OF_CPU_MEM) && g_enable_group_by_spill &&
+      get_spill_partition_key(ra_exe_unit_in)) {
+    if (render_info) {
+      render_info->forceNonInSitu();
+    }
+    return execute_with_spill(ra_exe_unit_in, e.getErrorCode());
+  }
+
   if (e.wasMultifragKernelLaunch()) {
     try {
       // Attempt to retry using the kernel per fragment path. The smaller input size
@@ -4222,7 +4733,6 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
     render_info->forceNonInSitu();
   }
 
-  const auto co_cpu = CompilationOptions::makeCpuOnly(co);
   if (e.getErrorCode() < 0) {
     // Only reset the group buffer entry guess if we ran out of slots, which
     // suggests a highly pathological input which prevented a good estimation of distinct
@@ -4265,6 +4775,8 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
                         "groups buffer entry "
                         "guess equal to "
                      << max_groups_buffer_entry_guess;
+      } else if (new_e.getErrorCode() == int32_t(ErrorCode::OUT_OF_CPU_MEM)) {
+        return execute_with_spill(ra_exe_unit, new_e.getErrorCode());
       } else {
         handlePersistentError(new_e.getErrorCode());
       }
@@ -4276,6 +4788,153 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   return result;
 }
 
+ExecutionResult RelAlgExecutor::executeWorkUnitWithSpill(
+    const RelAlgExecutionUnit& ra_exe_unit_in,
+    const std::shared_ptr<Analyzer::Expr>& partition_key,
+    const size_t max_groups_buffer_entry_guess,
+    ColumnCacheMap& column_cache,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const bool is_agg,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo) {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(co.device_type == ExecutorDeviceType::CPU);
+  const size_t partition_count = std::max(g_group_by_spill_partition_count, size_t(2));
+
+  // Every pass gets a memory owner of its own, released once the groups it found are
+  // compacted into the result, so only the group by buffer of a single pass is resident
+  // while executing.
+  const auto query_row_set_mem_owner = executor_->row_set_mem_owner_;
+  CHECK(query_row_set_mem_owner);
+  ScopeGuard restore_row_set_mem_owner = [this, &query_row_set_mem_owner] {
+    executor_->row_set_mem_owner_ = query_row_set_mem_owner;
+  };
+
+  const auto table_infos = get_table_infos(ra_exe_unit_in, executor_);
+  auto eo_rowwise = eo;
+  eo_rowwise.output_columnar_hint = false;
+  const auto partition_entry_guess =
+      max_groups_buffer_entry_guess
+          ? std::max(max_groups_buffer_entry_guess / partition_count, size_t(1))
+          : size_t(0);
+  std::optional<QueryMemoryDescriptor> query_mem_desc;
+  std::vector<TargetInfo> targets;
+  std::vector<int64_t> target_init_vals;
+  std::shared_ptr<ResultSet> rows;
+  size_t partitions_per_pass{1};
+  size_t pass_count{0};
+  for (size_t first_partition = 0; first_partition < partition_count;) {
+    const auto end_partition =
+        std::min(first_partition + partitions_per_pass, partition_count);
+    const auto pass_partition_count = end_partition - first_partition;
+    auto ra_exe_unit = ra_exe_unit_in;
+    ra_exe_unit.simple_quals.push_back(make_spill_partition_qual(
+        partition_key, first_partition, end_partition, partition_count));
+    ra_exe_unit.query_plan_dag_hash = EMPTY_HASHED_PLAN_DAG_KEY;
+    executor_->row_set_mem_owner_ = std::make_shared<RowSetMemoryOwner>(
+        Executor::getArenaBlockSize(), executor_->executor_id_);
+    executor_->row_set_mem_owner_->setDictionaryGenerations(
+        query_row_set_mem_owner->getStringDictionaryGenerations());
+    ResultSetPtr pass_rows;
+    for (auto entry_guess = partition_entry_guess * pass_partition_count;;) {
+      try {
+        auto groups_buffer_entry_guess = entry_guess;
+        pass_rows = executor_->executeWorkUnit(groups_buffer_entry_guess,
+                                               is_agg,
+                                               table_infos,
+                                               ra_exe_unit,
+                                               co,
+                                               eo_rowwise,
+                                               nullptr,
+                                               true,
+                                               column_cache);
+        break;
+      } catch (const QueryExecutionError& e) {
+        if (e.getErrorCode() == int32_t(ErrorCode::OUT_OF_CPU_MEM) &&
+            pass_partition_count > 1) {
+          // the groups of the partitions taken together did not fit after all
+          break;
+        }
+        // A skewed partition can hold more groups than its share of the entry guess
+        if (e.getErrorCode() >= 0 || !entry_guess ||
+            entry_guess >= max_groups_buffer_entry_guess) {
+          throw;
+        }
+        entry_guess *= 2;
+      }
+    }
+    if (!pass_rows) {
+      partitions_per_pass = std::max(pass_partition_count / 2, size_t(1));
+      continue;
+    }
+    ++pass_count;
+    first_partition = end_partition;
+    const auto storage = pass_rows->getStorage();
+    if (!storage) {
+      continue;
+    }
+    // Baseline hash entries carry their own keys, so the groups of a pass can be
+    // compacted without their hash layout. Perfect hash entries derive their keys from
+    // the key range.
+    const auto& rows_qmd = pass_rows->getQueryMemDesc();
+    if (rows_qmd.getQueryDescriptionType() != QueryDescriptionType::GroupByBaselineHash ||
+        rows_qmd.didOutputColumnar() ||
+        (query_mem_desc && (rows_qmd.getRowSize() != query_mem_desc->getRowSize() ||
+                            rows_qmd.getEffectiveKeyWidth() !=
+                                query_mem_desc->getEffectiveKeyWidth()))) {
+      VLOG(1) << "Cannot spill group by with query memory descriptor "
+              << rows_qmd.toString();
+      throw QueryExecutionError(ErrorCode::OUT_OF_CPU_MEM);
+    }
+    if (!query_mem_desc) {
+      query_mem_desc = rows_qmd;
+      targets = pass_rows->getTargetInfos();
+      target_init_vals = pass_rows->getTargetInitVals();
+    }
+    const auto pass_buffer_size = rows_qmd.getBufferSizeBytes(ExecutorDeviceType::CPU);
+    // The partitions hold disjoint sets of groups, so the groups of every pass are a
+    // complete result of their own. Each pass is compacted into a storage of its own,
+    // sized for the groups it found rather than its hash buffer, and the storages are
+    // chained in one result set rather than merged into a single buffer.
+    auto compact_rows = compact_spill_partition_rows(
+        *pass_rows, targets, target_init_vals, query_row_set_mem_owner, executor_);
+    pass_rows.reset();
+    if (compact_rows) {
+      if (rows) {
+        rows->append(*compact_rows);
+      } else {
+        rows = compact_rows;
+      }
+    }
+    if (g_max_cpu_group_by_buffer_size && pass_buffer_size) {
+      // Every pass re-scans the input, so the next ones take as many partitions as the
+      // group by buffer budget allows, judging by the buffer this pass needed
+      const auto partition_buffer_size =
+          std::max(pass_buffer_size / pass_partition_count, size_t(1));
+      partitions_per_pass =
+          std::max(g_max_cpu_group_by_buffer_size / partition_buffer_size, size_t(1));
+    }
+  }
+  executor_->row_set_mem_owner_ = query_row_set_mem_owner;
+  if (!query_mem_desc) {
+    throw QueryExecutionError(ErrorCode::OUT_OF_CPU_MEM);
+  }
+  if (!rows) {
+    auto empty_query_mem_desc = *query_mem_desc;
+    empty_query_mem_desc.setEntryCount(0);
+    rows = std::make_shared<ResultSet>(targets,
+                                       ExecutorDeviceType::CPU,
+                                       empty_query_mem_desc,
+                                       query_row_set_mem_owner,
+                                       executor_->blockSize(),
+                                       executor_->gridSize());
+  }
+  rows->setSpillPassCount(pass_count);
+  LOG(INFO) << "Group by ran in " << pass_count << " passes over " << partition_count
+            << " hash partitions of its groups.";
+  return {rows, targets_meta};
+}
+
 void RelAlgExecutor::handlePersistentError(const int32_t error_code) {
   LOG(ERROR) << "Query execution failed with error "
              << getErrorMessageFromCode(error_code);
@@ -4440,10 +5099,11 @@ std::vector<JoinType> left_deep_join_types(const RelLeftDeepInnerJoin* left_deep
   std::vector<JoinType> join_types(left_deep_join->inputCount() - 1, JoinType::INNER);
   for (size_t nesting_level = 1; nesting_level <= left_deep_join->inputCount() - 1;
        ++nesting_level) {
+    auto cur_level_join_type = left_deep_join->getJoinType(nesting_level);
     if (left_deep_join->getOuterCondition(nesting_level)) {
-      join_types[nesting_level - 1] = JoinType::LEFT;
+      join_types[nesting_level - 1] =
+          cur_level_join_type == JoinType::FULL ? JoinType::FULL : JoinType::LEFT;
     }
-    auto cur_level_join_type = left_deep_join->getJoinType(nesting_level);
     if (cur_level_join_type == JoinType::SEMI || cur_level_join_type == JoinType::ANTI) {
       join_types[nesting_level - 1] = cur_level_join_type;
     }
@@ -4538,6 +5198,8 @@ RelAlgExecutor::WorkUnit RelAlgExecutor::createCompoundWorkUnit(
         left_deep_join, input_descs, input_to_nest_level, eo.just_explain);
     if (eo.table_reordering &&
         std::find(join_types.begin(), join_types.end(), JoinType::LEFT) ==
+            join_types.end() &&
+        std::find(join_types.begin(), join_types.end(), JoinType::FULL) ==
             join_types.end()) {
       input_permutation = do_table_reordering(input_descs,
                                               input_col_descs,
@@ -4785,8 +5447,13 @@ JoinQualsPerNestingLevel RelAlgExecutor::translateLeftDeepJoinFilter(
       result[rte_idx - 1].quals =
           makeJoinQuals(outer_condition, join_types, input_to_nest_level, just_explain);
       CHECK_LE(rte_idx, join_types.size());
-      CHECK(join_types[rte_idx - 1] == JoinType::LEFT);
+      CHECK(join_types[rte_idx - 1] == JoinType::LEFT ||
+            join_types[rte_idx - 1] == JoinType::FULL);
       result[rte_idx - 1].type = JoinType::LEFT;
+      if (join_types[rte_idx - 1] == JoinType::FULL) {
+        // sized for the inner table when the work unit runs
+        result[rte_idx - 1].matched_inner_rows = std::make_shared<std::vector<int8_t>>();
+      }
       continue;
     }
     for (const auto& qual : join_condition_quals) {
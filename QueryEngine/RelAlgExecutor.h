@@ -219,6 +219,13 @@ class RelAlgExecutor : private StorageIOFacility {
                                             const bool explain_verbose,
                                             RenderInfo* render_info);
 
+  void executeSubqueries(const CompilationOptions& co, const ExecutionOptions& eo);
+
+  void executeSubquery(RexSubQuery* subquery,
+                       Executor* executor,
+                       const CompilationOptions& co,
+                       const ExecutionOptions& eo);
+
   void executeRelAlgStep(const RaExecutionSequence& seq,
                          const size_t step_idx,
                          const CompilationOptions&,
@@ -313,6 +320,13 @@ class RelAlgExecutor : private StorageIOFacility {
       const int64_t queue_time_ms,
       const std::optional<size_t> previous_count = std::nullopt);
 
+  // Adds the inner rows a FULL outer join hasn't matched to the result of the join.
+  void addUnmatchedInnerRows(ExecutionResult& result,
+                             const RelAlgExecutionUnit& ra_exe_unit,
+                             const CompilationOptions& co,
+                             const ExecutionOptions& eo,
+                             ColumnCacheMap& column_cache);
+
   // Computes the window function results to be used by the query.
   void computeWindow(const WorkUnit& work_unit,
                      const CompilationOptions& co,
@@ -367,6 +381,18 @@ class RelAlgExecutor : private StorageIOFacility {
                                          const QueryExecutionError& e,
                                          const int64_t queue_time_ms);
 
+  // Runs a group by which ran out of CPU memory one set of hash partitions of its groups
+  // at a time, compacting the groups of every pass before moving on to the next.
+  ExecutionResult executeWorkUnitWithSpill(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::shared_ptr<Analyzer::Expr>& partition_key,
+      const size_t max_groups_buffer_entry_guess,
+      ColumnCacheMap& column_cache,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const bool is_agg,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo);
+
   // Allows an out of memory error through if CPU retry is enabled. Otherwise, throws an
   // appropriate exception corresponding to the query error code.
   static void handlePersistentError(const int32_t error_code);
@@ -500,6 +500,20 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateScalarSubquery(
   return makeExpr<Analyzer::Constant>(ti, is_null_const, d);
 }
 
+namespace {
+
+// The inner columns of a LEFT join, and the columns of both sides of a FULL join, are
+// null for the rows without a match.
+bool is_null_extended_input(const std::vector<JoinType>& join_types, const int rte_idx) {
+  if (std::find(join_types.begin(), join_types.end(), JoinType::FULL) !=
+      join_types.end()) {
+    return true;
+  }
+  return rte_idx > 0 && join_types[rte_idx - 1] == JoinType::LEFT;
+}
+
+}  // namespace
+
 std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateInput(
     const RexInput* rex_input) const {
   const auto source = rex_input->getSourceNode();
@@ -530,7 +544,7 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateInput(
       col_ti.set_size(8);
     }
     CHECK_LE(static_cast<size_t>(rte_idx), join_types_.size());
-    if (rte_idx > 0 && join_types_[rte_idx - 1] == JoinType::LEFT) {
+    if (is_null_extended_input(join_types_, rte_idx)) {
       col_ti.set_notnull(false);
     }
     return std::make_shared<Analyzer::ColumnVar>(
@@ -547,7 +561,7 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateInput(
 
   if (join_types_.size() > 0) {
     CHECK_LE(static_cast<size_t>(rte_idx), join_types_.size());
-    if (rte_idx > 0 && join_types_[rte_idx - 1] == JoinType::LEFT) {
+    if (is_null_extended_input(join_types_, rte_idx)) {
       col_ti.set_notnull(false);
     }
   }
@@ -53,7 +53,8 @@ RelLeftDeepInnerJoin::RelLeftDeepInnerJoin(
           }
           break;
         }
-        case JoinType::LEFT: {
+        case JoinType::LEFT:
+        case JoinType::FULL: {
           if (original_join->getCondition()) {
             outer_conditions_per_level_[nesting_level].reset(
                 original_join->getAndReleaseCondition());
@@ -49,6 +49,8 @@
 size_t g_parallel_top_min = 100e3;
 size_t g_parallel_top_max = 20e6;  // In effect only with g_enable_watchdog.
 size_t g_streaming_topn_max = 100e3;
+bool g_enable_parallel_sort{true};
+size_t g_parallel_sort_max_buffer_size{2000000000};
 constexpr int64_t uninitialized_cached_row_count{-1};
 
 void ResultSet::keepFirstN(const size_t n) {
@@ -817,6 +819,19 @@ void ResultSet::sort(const std::list<Analyzer::OrderEntry>& order_entries,
     }
     parallelTop(order_entries, top_n, executor);
   } else {
+    if (top_n == 0 && g_enable_parallel_sort && g_parallel_top_min < entryCount() &&
+        canUseParallelSort(order_entries)) {
+      // Comparing normalized keys is cheap enough to allow as many rows as parallelTop().
+      if (g_enable_watchdog &&
+          std::max(size_t(Executor::baseline_threshold), g_parallel_top_max) <
+              entryCount()) {
+        throw WatchdogException("Sorting the result would be too slow");
+      }
+      if (parallelSort(order_entries)) {
+        return;
+      }
+      LOG(WARNING) << "Out of CPU memory for the sort keys, sorting without them";
+    }
     if (g_enable_watchdog && Executor::baseline_threshold < entryCount()) {
       throw WatchdogException("Sorting the result would be too slow");
     }
@@ -923,6 +938,215 @@ void ResultSet::parallelTop(const std::list<Analyzer::OrderEntry>& order_entries
   permutation_.shrink_to_fit();
 }
 
+namespace {
+
+// Map a value to an unsigned integer of the same order, so that keys of any type compare
+// as unsigned integers.
+inline uint64_t sort_key_from_int(const int64_t val) {
+  return static_cast<uint64_t>(val) ^ (uint64_t(1) << 63);
+}
+
+inline uint64_t sort_key_from_double(const double val) {
+  const auto bits = *reinterpret_cast<const uint64_t*>(may_alias_ptr(&val));
+  return (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+// Each order entry contributes a null rank followed by the value.
+constexpr size_t kSortKeyWordsPerEntry{2};
+
+}  // namespace
+
+bool ResultSet::canUseParallelSort(
+    const std::list<Analyzer::OrderEntry>& order_entries) const {
+  for (const auto& order_entry : order_entries) {
+    const auto& agg_info = targets_[order_entry.tle_no - 1];
+    if (is_distinct_target(agg_info) || agg_info.agg_kind == kAPPROX_QUANTILE ||
+        agg_info.agg_kind == kMODE) {
+      return false;
+    }
+    // Strings are ordered by their contents, not by their dictionary ids.
+    const auto entry_ti = get_compact_type(agg_info);
+    if (!entry_ti.is_integer() && !entry_ti.is_decimal() && !entry_ti.is_boolean() &&
+        !entry_ti.is_time() && !entry_ti.is_fp()) {
+      return false;
+    }
+  }
+  // The sort keys, the sorted positions and the merge buffer are all allocated up front,
+  // so stay within a CPU memory budget rather than relying on std::bad_alloc.
+  const size_t key_words = kSortKeyWordsPerEntry * order_entries.size();
+  const size_t entry_bytes = key_words * sizeof(uint64_t) + 2 * sizeof(PermutationIdx);
+  if (entryCount() > g_parallel_sort_max_buffer_size / entry_bytes) {
+    VLOG(1) << "Parallel sort needs more than " << g_parallel_sort_max_buffer_size
+            << " bytes for " << entryCount() << " entries, sorting without it";
+    return false;
+  }
+  return true;
+}
+
+template <typename BUFFER_ITERATOR_TYPE>
+void ResultSet::fillSortKeys(const std::list<Analyzer::OrderEntry>& order_entries,
+                             const PermutationView permutation,
+                             const size_t begin,
+                             const size_t end,
+                             uint64_t* keys) const {
+  const BUFFER_ITERATOR_TYPE buffer_itr(this);
+  const size_t key_width = kSortKeyWordsPerEntry * order_entries.size();
+  for (size_t i = begin; i < end; ++i) {
+    const auto storage_lookup_result = findStorage(permutation[i]);
+    const auto storage = storage_lookup_result.storage_ptr;
+    const auto entry_idx = storage_lookup_result.fixedup_entry_idx;
+    auto key = keys + i * key_width;
+    for (const auto& order_entry : order_entries) {
+      const auto& agg_info = storage->targets_[order_entry.tle_no - 1];
+      const auto entry_ti = get_compact_type(agg_info);
+      const bool float_argument_input =
+          isFloatArgumentInput(agg_info, order_entry.tle_no - 1);
+      const auto val = buffer_itr.getColumnInternal(storage->buff_,
+                                                    entry_idx,
+                                                    order_entry.tle_no - 1,
+                                                    storage_lookup_result);
+      if (isNull(entry_ti, val, float_argument_input)) {
+        key[0] = order_entry.nulls_first ? 0 : 1;
+        key[1] = 0;
+      } else {
+        uint64_t val_key;
+        if (val.isPair()) {
+          val_key = sort_key_from_double(
+              pair_to_double({val.i1, val.i2}, entry_ti, float_argument_input));
+        } else {
+          CHECK(val.isInt());
+          if (entry_ti.is_fp()) {
+            val_key = sort_key_from_double(
+                float_argument_input
+                    ? *reinterpret_cast<const float*>(may_alias_ptr(&val.i1))
+                    : *reinterpret_cast<const double*>(may_alias_ptr(&val.i1)));
+          } else {
+            val_key = sort_key_from_int(val.i1);
+          }
+        }
+        key[0] = order_entry.nulls_first ? 1 : 0;
+        key[1] = order_entry.is_desc ? ~val_key : val_key;
+      }
+      key += kSortKeyWordsPerEntry;
+    }
+  }
+}
+
+bool ResultSet::parallelSort(const std::list<Analyzer::OrderEntry>& order_entries) {
+  auto timer = DEBUG_TIMER(__func__);
+  const size_t nthreads = cpu_threads();
+
+  // Collect the non-empty entries of disjoint subranges, as in parallelTop().
+  permutation_.resize(query_mem_desc_.getEntryCount());
+  std::vector<PermutationView> permutation_views(nthreads);
+  threading::task_group init_threads;
+  for (auto interval : makeIntervals<PermutationIdx>(0, permutation_.size(), nthreads)) {
+    init_threads.run([this, &permutation_views, interval] {
+      PermutationView pv(permutation_.data() + interval.begin, 0, interval.size());
+      permutation_views[interval.index] =
+          initPermutationBuffer(pv, interval.begin, interval.end);
+    });
+  }
+  init_threads.wait();
+  auto end = permutation_.begin() + permutation_views.front().size();
+  for (size_t i = 1; i < nthreads; ++i) {
+    std::copy(permutation_views[i].begin(), permutation_views[i].end(), end);
+    end += permutation_views[i].size();
+  }
+  permutation_.resize(end - permutation_.begin());
+  const size_t entry_count = permutation_.size();
+
+  // The rows are sorted by comparing fixed-width keys word by word, instead of going
+  // through the generic comparator which reads and decodes both rows for each compare.
+  const size_t key_width = kSortKeyWordsPerEntry * order_entries.size();
+  std::vector<uint64_t> keys;
+  std::vector<PermutationIdx> positions;
+  std::vector<PermutationIdx> merged;
+  try {
+    keys.resize(entry_count * key_width);
+    positions.resize(entry_count);
+    merged.resize(entry_count);
+  } catch (const std::bad_alloc&) {
+    permutation_.clear();
+    permutation_.shrink_to_fit();
+    return false;
+  }
+  const PermutationView pv(permutation_.data(), entry_count, entry_count);
+  const auto intervals = makeIntervals<size_t>(0, entry_count, nthreads);
+  threading::task_group key_threads;
+  for (auto interval : intervals) {
+    key_threads.run([this,
+                     &order_entries,
+                     &keys,
+                     pv,
+                     parent_thread_local_ids = logger::thread_local_ids(),
+                     interval] {
+      logger::LocalIdsScopeGuard lisg = parent_thread_local_ids.setNewThreadId();
+      if (query_mem_desc_.didOutputColumnar()) {
+        fillSortKeys<ColumnWiseTargetAccessor>(
+            order_entries, pv, interval.begin, interval.end, keys.data());
+      } else {
+        fillSortKeys<RowWiseTargetAccessor>(
+            order_entries, pv, interval.begin, interval.end, keys.data());
+      }
+    });
+  }
+  key_threads.wait();
+
+  const auto compare = [&keys, key_width](const PermutationIdx lhs,
+                                          const PermutationIdx rhs) {
+    const auto lhs_key = keys.data() + lhs * key_width;
+    const auto rhs_key = keys.data() + rhs * key_width;
+    return std::lexicographical_compare(
+        lhs_key, lhs_key + key_width, rhs_key, rhs_key + key_width);
+  };
+
+  // Sort one run per thread, then merge pairs of adjacent runs in parallel until a
+  // single run is left.
+  std::iota(positions.begin(), positions.end(), PermutationIdx(0));
+  std::vector<size_t> run_bounds;
+  threading::task_group sort_threads;
+  for (auto interval : intervals) {
+    run_bounds.push_back(interval.begin);
+    sort_threads.run([&positions, &compare, interval] {
+      std::sort(
+          positions.begin() + interval.begin, positions.begin() + interval.end, compare);
+    });
+  }
+  run_bounds.push_back(entry_count);
+  sort_threads.wait();
+  while (run_bounds.size() > 2) {
+    const size_t run_count = run_bounds.size() - 1;
+    std::vector<size_t> merged_run_bounds;
+    threading::task_group merge_threads;
+    for (size_t i = 0; i < run_count; i += 2) {
+      const auto run_begin = run_bounds[i];
+      const auto run_mid = run_bounds[i + 1];
+      const auto run_end = run_bounds[std::min(i + 2, run_count)];
+      merged_run_bounds.push_back(run_begin);
+      merge_threads.run([&positions, &merged, &compare, run_begin, run_mid, run_end] {
+        std::merge(positions.begin() + run_begin,
+                   positions.begin() + run_mid,
+                   positions.begin() + run_mid,
+                   positions.begin() + run_end,
+                   merged.begin() + run_begin,
+                   compare);
+      });
+    }
+    merged_run_bounds.push_back(entry_count);
+    merge_threads.wait();
+    positions.swap(merged);
+    run_bounds.swap(merged_run_bounds);
+  }
+
+  for (size_t i = 0; i < entry_count; ++i) {
+    merged[i] = permutation_[positions[i]];
+  }
+  permutation_.swap(merged);
+  permutation_.shrink_to_fit();
+  return true;
+}
+
 std::pair<size_t, size_t> ResultSet::getStorageIndex(const size_t entry_idx) const {
   size_t fixedup_entry_idx = entry_idx;
   auto entry_count = storage_->query_mem_desc_.getEntryCount();
@@ -1161,22 +1385,8 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
     const auto lhs_entry_ti = get_compact_type(lhs_agg_info);
     const auto rhs_entry_ti = get_compact_type(rhs_agg_info);
     // When lhs vs rhs doesn't matter, the lhs is used. For example:
-    bool float_argument_input = takes_float_argument(lhs_agg_info);
-    // Need to determine if the float value has been stored as float
-    // or if it has been compacted to a different (often larger 8 bytes)
-    // in distributed case the floats are actually 4 bytes
-    // TODO the above takes_float_argument() is widely used wonder if this problem
-    // exists elsewhere
-    if (lhs_entry_ti.get_type() == kFLOAT) {
-      const auto is_col_lazy =
-          !result_set_->lazy_fetch_info_.empty() &&
-          result_set_->lazy_fetch_info_[order_entry.tle_no - 1].is_lazily_fetched;
-      if (result_set_->query_mem_desc_.getPaddedSlotWidthBytes(order_entry.tle_no - 1) ==
-          sizeof(float)) {
-        float_argument_input =
-            result_set_->query_mem_desc_.didOutputColumnar() ? !is_col_lazy : true;
-      }
-    }
+    const bool float_argument_input =
+        result_set_->isFloatArgumentInput(lhs_agg_info, order_entry.tle_no - 1);
 
     if (UNLIKELY(is_distinct_target(lhs_agg_info))) {
       CHECK_LT(materialized_count_distinct_buffer_idx,
@@ -1309,6 +1519,24 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
   return false;
 }
 
+bool ResultSet::isFloatArgumentInput(const TargetInfo& agg_info,
+                                     const size_t target_idx) const {
+  bool float_argument_input = takes_float_argument(agg_info);
+  // Need to determine if the float value has been stored as float
+  // or if it has been compacted to a different (often larger 8 bytes)
+  // in distributed case the floats are actually 4 bytes
+  // TODO the above takes_float_argument() is widely used wonder if this problem
+  // exists elsewhere
+  if (get_compact_type(agg_info).get_type() == kFLOAT) {
+    const auto is_col_lazy =
+        !lazy_fetch_info_.empty() && lazy_fetch_info_[target_idx].is_lazily_fetched;
+    if (query_mem_desc_.getPaddedSlotWidthBytes(target_idx) == sizeof(float)) {
+      float_argument_input = query_mem_desc_.didOutputColumnar() ? !is_col_lazy : true;
+    }
+  }
+  return float_argument_input;
+}
+
 // Partial sort permutation into top(least by compare) n elements.
 // If permutation.size() <= n then sort entire permutation by compare.
 // Return PermutationView with new size() = min(n, permutation.size()).
@@ -1489,10 +1717,13 @@ bool ResultSet::isDirectColumnarConversionPossible() const {
   } else {
     CHECK(!(query_mem_desc_.getQueryDescriptionType() ==
             QueryDescriptionType::TableFunction));
-    return permutation_.empty() && (query_mem_desc_.getQueryDescriptionType() ==
-                                        QueryDescriptionType::GroupByPerfectHash ||
-                                    query_mem_desc_.getQueryDescriptionType() ==
-                                        QueryDescriptionType::GroupByBaselineHash);
+    // the direct conversion of row-wise group by buffers only reads the main storage,
+    // see RelAlgExecutor::executeWorkUnitWithSpill for row-wise appended storages
+    return permutation_.empty() && appended_storage_.empty() &&
+           (query_mem_desc_.getQueryDescriptionType() ==
+                QueryDescriptionType::GroupByPerfectHash ||
+            query_mem_desc_.getQueryDescriptionType() ==
+                QueryDescriptionType::GroupByBaselineHash);
   }
 }
 
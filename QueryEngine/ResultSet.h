@@ -381,6 +381,13 @@ class ResultSet {
   int64_t getQueueTime() const;
   int64_t getRenderTime() const;
 
+  // Passes over the input which computed this result one set of hash partitions of its
+  // groups at a time, see RelAlgExecutor::executeWorkUnitWithSpill
+  void setSpillPassCount(const size_t spill_pass_count) {
+    spill_pass_count_ = spill_pass_count;
+  }
+  size_t getSpillPassCount() const { return spill_pass_count_; }
+
   void moveToBegin() const;
 
   bool isTruncated() const;
@@ -906,6 +913,22 @@ class ResultSet {
                    const size_t top_n,
                    const Executor* executor);
 
+  // Full sort on fixed-width binary-comparable keys, for order entries on numeric
+  // targets only. Returns false, leaving permutation_ empty, if the keys don't fit in
+  // memory.
+  bool canUseParallelSort(const std::list<Analyzer::OrderEntry>& order_entries) const;
+  bool parallelSort(const std::list<Analyzer::OrderEntry>& order_entries);
+
+  template <typename BUFFER_ITERATOR_TYPE>
+  void fillSortKeys(const std::list<Analyzer::OrderEntry>& order_entries,
+                    const PermutationView permutation,
+                    const size_t begin,
+                    const size_t end,
+                    uint64_t* keys) const;
+
+  // Whether the value of a floating point target is read from the buffer as a float.
+  bool isFloatArgumentInput(const TargetInfo& agg_info, const size_t target_idx) const;
+
   void baselineSort(const std::list<Analyzer::OrderEntry>& order_entries,
                     const size_t top_n,
                     const ExecutorDeviceType device_type,
@@ -957,6 +980,7 @@ class ResultSet {
   unsigned block_size_{0};
   unsigned grid_size_{0};
   QueryExecutionTimings timings_;
+  size_t spill_pass_count_{0};
 
   std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_;
   std::vector<std::shared_ptr<std::list<ChunkIter>>> chunk_iters_;
@@ -1034,6 +1058,24 @@ class ResultSetManager {
  public:
   ResultSet* reduce(std::vector<ResultSet*>&, const size_t executor_id);
 
+  // Pairwise tree reduction which reduces the pairs of every level concurrently. Baseline
+  // hash result sets are reduced into new result sets sized for the groups of both sides
+  // of a pair, other layouts into the left side in place.
+  static std::shared_ptr<ResultSet> reduceTree(
+      const std::vector<std::shared_ptr<ResultSet>>& result_sets,
+      const ReductionCode& reduction_code,
+      const size_t executor_id);
+
+  // Two-phase radix partitioned reduction of row-wise baseline hash result sets. The
+  // entries of all result sets are first scattered into partitions by the range of the
+  // reduced buffer their key hashes to, then each partition is reduced by one thread.
+  // Every group is thus only touched by a single thread, within a cache-sized range of
+  // the reduced buffer, and the result sets are not merged into a first one.
+  static std::shared_ptr<ResultSet> reducePartitioned(
+      const std::vector<std::shared_ptr<ResultSet>>& result_sets,
+      const ReductionCode& reduction_code,
+      const size_t executor_id);
+
   std::shared_ptr<ResultSet> getOwnResultSet();
 
   void rewriteVarlenAggregates(ResultSet*);
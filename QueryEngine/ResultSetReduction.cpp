@@ -27,13 +27,16 @@
 #include "ResultSetReductionJIT.h"
 #include "RuntimeFunctions.h"
 #include "Shared/SqlTypesLayout.h"
+#include "Shared/checked_alloc.h"
 #include "Shared/likely.h"
 #include "Shared/thread_count.h"
+#include "Shared/threading.h"
 
 #include <llvm/ExecutionEngine/GenericValue.h>
 
 #include <algorithm>
 #include <future>
+#include <limits>
 #include <numeric>
 
 extern bool g_enable_dynamic_watchdog;
@@ -1129,6 +1132,263 @@ ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets,
   return result_rs;
 }
 
+std::shared_ptr<ResultSet> ResultSetManager::reduceTree(
+    const std::vector<std::shared_ptr<ResultSet>>& result_sets,
+    const ReductionCode& reduction_code,
+    const size_t executor_id) {
+  CHECK(!result_sets.empty());
+  auto reduce_pair = [&reduction_code, executor_id](std::shared_ptr<ResultSet> lhs,
+                                                    const ResultSet& rhs) {
+    CHECK(lhs->storage_);
+    CHECK(rhs.storage_);
+    CHECK(rhs.serialized_varlen_buffer_.empty());
+    if (lhs->query_mem_desc_.getQueryDescriptionType() ==
+        QueryDescriptionType::GroupByBaselineHash) {
+      auto query_mem_desc = lhs->query_mem_desc_;
+      query_mem_desc.setEntryCount(query_mem_desc.getEntryCount() +
+                                   rhs.query_mem_desc_.getEntryCount());
+      auto widened_rs = std::make_shared<ResultSet>(lhs->targets_,
+                                                    ExecutorDeviceType::CPU,
+                                                    query_mem_desc,
+                                                    lhs->row_set_mem_owner_,
+                                                    lhs->block_size_,
+                                                    lhs->grid_size_);
+      // The widened result set owns its buffer rather than taking it from the arena of
+      // the row set memory owner, so that the buffer of every level but the last one is
+      // freed once the next level has been reduced from it
+      auto widened_buff = static_cast<int8_t*>(
+          checked_malloc(query_mem_desc.getBufferSizeBytes(ExecutorDeviceType::CPU)));
+      widened_rs->storage_.reset(new ResultSetStorage(
+          lhs->targets_, query_mem_desc, widened_buff, /*buff_is_provided=*/false));
+      widened_rs->storage_->target_init_vals_ = lhs->storage_->target_init_vals_;
+      auto widened_storage = widened_rs->storage_.get();
+      widened_rs->initializeStorage();
+      switch (query_mem_desc.getEffectiveKeyWidth()) {
+        case 4:
+          lhs->storage_->moveEntriesToBuffer<int32_t>(
+              widened_storage->getUnderlyingBuffer(), query_mem_desc.getEntryCount());
+          break;
+        case 8:
+          lhs->storage_->moveEntriesToBuffer<int64_t>(
+              widened_storage->getUnderlyingBuffer(), query_mem_desc.getEntryCount());
+          break;
+        default:
+          CHECK(false);
+      }
+      lhs = std::move(widened_rs);
+    }
+    lhs->storage_->reduce(*rhs.storage_, {}, reduction_code, executor_id);
+    return lhs;
+  };
+
+  auto level_result_sets = result_sets;
+  while (level_result_sets.size() > 1) {
+    const size_t pair_count = level_result_sets.size() / 2;
+    std::vector<std::shared_ptr<ResultSet>> next_level_result_sets(
+        pair_count + level_result_sets.size() % 2);
+    threading::parallel_for(
+        threading::blocked_range<size_t>(0, pair_count),
+        [&](const threading::blocked_range<size_t>& pair_range) {
+          for (size_t pair_idx = pair_range.begin(); pair_idx != pair_range.end();
+               ++pair_idx) {
+            next_level_result_sets[pair_idx] =
+                reduce_pair(level_result_sets[2 * pair_idx],
+                            *level_result_sets[2 * pair_idx + 1]);
+            // drop the inputs as soon as they're reduced, which frees the buffers
+            // widened by the previous level
+            level_result_sets[2 * pair_idx].reset();
+            level_result_sets[2 * pair_idx + 1].reset();
+          }
+        });
+    if (level_result_sets.size() % 2) {
+      next_level_result_sets.back() = std::move(level_result_sets.back());
+    }
+    level_result_sets = std::move(next_level_result_sets);
+  }
+  return level_result_sets.front();
+}
+
+namespace {
+
+// Bytes of the reduced buffer owned by a partition of the partitioned reduction, sized
+// to stay in the per-core caches while the partition is reduced
+constexpr size_t kReductionPartitionBytes{1 << 20};
+// Minimum entries of a result set whose partitions are computed by a single task; the
+// chunks grow with the input so the per chunk partition counts stay bounded by the
+// thread count times the partition count
+constexpr size_t kReductionScatterChunkEntries{1 << 16};
+
+}  // namespace
+
+std::shared_ptr<ResultSet> ResultSetManager::reducePartitioned(
+    const std::vector<std::shared_ptr<ResultSet>>& result_sets,
+    const ReductionCode& reduction_code,
+    const size_t executor_id) {
+  CHECK(!result_sets.empty());
+  const auto& first_rs = result_sets.front();
+  CHECK(first_rs->storage_);
+  CHECK(first_rs->query_mem_desc_.getQueryDescriptionType() ==
+        QueryDescriptionType::GroupByBaselineHash);
+  CHECK(!first_rs->query_mem_desc_.didOutputColumnar());
+  auto query_mem_desc = first_rs->query_mem_desc_;
+  const auto total_entry_count =
+      std::accumulate(result_sets.begin(),
+                      result_sets.end(),
+                      size_t(0),
+                      [](const size_t init, const std::shared_ptr<ResultSet>& rs) {
+                        return init + rs->query_mem_desc_.getEntryCount();
+                      });
+  query_mem_desc.setEntryCount(total_entry_count);
+  auto reduced_rs = std::make_shared<ResultSet>(first_rs->targets_,
+                                                ExecutorDeviceType::CPU,
+                                                query_mem_desc,
+                                                first_rs->row_set_mem_owner_,
+                                                first_rs->block_size_,
+                                                first_rs->grid_size_);
+  auto reduced_storage =
+      reduced_rs->allocateStorage(first_rs->storage_->target_init_vals_);
+  reduced_rs->initializeStorage();
+  auto reduced_buff = reduced_storage->getUnderlyingBuffer();
+  const auto& reduced_query_mem_desc = reduced_rs->query_mem_desc_;
+
+  const size_t row_bytes = get_row_bytes(query_mem_desc);
+  const size_t partition_count = std::min(
+      total_entry_count,
+      std::max(static_cast<size_t>(cpu_threads()),
+               (total_entry_count * row_bytes + kReductionPartitionBytes - 1) /
+                   kReductionPartitionBytes));
+  const auto key_count = query_mem_desc.getGroupbyColCount();
+  const auto key_width = query_mem_desc.getEffectiveKeyWidth();
+
+  // A group's partition is the range of the reduced buffer its hash probe starts in
+  struct ScatterChunk {
+    size_t rs_idx;
+    size_t start_entry;
+    size_t end_entry;
+  };
+  const size_t chunk_entries =
+      std::max(kReductionScatterChunkEntries,
+               (total_entry_count + cpu_threads() - 1) / cpu_threads());
+  std::vector<ScatterChunk> chunks;
+  std::vector<std::vector<uint32_t>> entry_partitions(result_sets.size());
+  for (size_t rs_idx = 0; rs_idx < result_sets.size(); ++rs_idx) {
+    const auto& rs = result_sets[rs_idx];
+    CHECK(rs->storage_);
+    CHECK(rs->serialized_varlen_buffer_.empty());
+    CHECK_EQ(get_row_bytes(rs->query_mem_desc_), row_bytes);
+    const auto entry_count = rs->query_mem_desc_.getEntryCount();
+    entry_partitions[rs_idx].resize(entry_count);
+    for (size_t start = 0; start < entry_count; start += chunk_entries) {
+      chunks.push_back(
+          ScatterChunk{rs_idx, start, std::min(start + chunk_entries, entry_count)});
+    }
+  }
+  constexpr auto kNoPartition = std::numeric_limits<uint32_t>::max();
+  std::vector<size_t> chunk_partition_counts(chunks.size() * partition_count, 0);
+  threading::parallel_for(
+      threading::blocked_range<size_t>(0, chunks.size()),
+      [&](const threading::blocked_range<size_t>& chunk_range) {
+        for (size_t chunk_idx = chunk_range.begin(); chunk_idx != chunk_range.end();
+             ++chunk_idx) {
+          const auto& chunk = chunks[chunk_idx];
+          const auto rs_buff = result_sets[chunk.rs_idx]->storage_->buff_;
+          auto& partitions = entry_partitions[chunk.rs_idx];
+          auto counts = &chunk_partition_counts[chunk_idx * partition_count];
+          for (size_t entry_idx = chunk.start_entry; entry_idx < chunk.end_entry;
+               ++entry_idx) {
+            const auto key =
+                reinterpret_cast<const int64_t*>(rs_buff + entry_idx * row_bytes);
+            const bool is_empty =
+                key_width == 4
+                    ? *reinterpret_cast<const int32_t*>(key) == get_empty_key<int32_t>()
+                    : *key == get_empty_key<int64_t>();
+            if (is_empty) {
+              partitions[entry_idx] = kNoPartition;
+              continue;
+            }
+            const size_t h = key_hash(key, key_count, key_width) % total_entry_count;
+            const auto partition = h * partition_count / total_entry_count;
+            partitions[entry_idx] = partition;
+            ++counts[partition];
+          }
+        }
+      });
+
+  // Lay the entries out partition by partition, in result set and entry order within a
+  // partition, and turn the per chunk counts into the chunks' write offsets
+  std::vector<size_t> partition_offsets(partition_count + 1, 0);
+  size_t offset = 0;
+  for (size_t partition = 0; partition < partition_count; ++partition) {
+    partition_offsets[partition] = offset;
+    for (size_t chunk_idx = 0; chunk_idx < chunks.size(); ++chunk_idx) {
+      auto& count = chunk_partition_counts[chunk_idx * partition_count + partition];
+      const auto chunk_count = count;
+      count = offset;
+      offset += chunk_count;
+    }
+  }
+  partition_offsets[partition_count] = offset;
+  std::vector<std::pair<uint32_t, uint32_t>> partitioned_entries(offset);
+  threading::parallel_for(
+      threading::blocked_range<size_t>(0, chunks.size()),
+      [&](const threading::blocked_range<size_t>& chunk_range) {
+        for (size_t chunk_idx = chunk_range.begin(); chunk_idx != chunk_range.end();
+             ++chunk_idx) {
+          const auto& chunk = chunks[chunk_idx];
+          const auto& partitions = entry_partitions[chunk.rs_idx];
+          auto offsets = &chunk_partition_counts[chunk_idx * partition_count];
+          for (size_t entry_idx = chunk.start_entry; entry_idx < chunk.end_entry;
+               ++entry_idx) {
+            const auto partition = partitions[entry_idx];
+            if (partition != kNoPartition) {
+              partitioned_entries[offsets[partition]++] = {
+                  static_cast<uint32_t>(chunk.rs_idx), static_cast<uint32_t>(entry_idx)};
+            }
+          }
+        }
+      });
+  entry_partitions.clear();
+
+  // Gather the entries a partition takes from each result set into a dense scratch
+  // buffer, so the reduction code runs once per result set and partition
+  CHECK_EQ(row_bytes % sizeof(int64_t), size_t(0));
+  const size_t row_quads = row_bytes / sizeof(int64_t);
+  threading::parallel_for(
+      threading::blocked_range<size_t>(0, partition_count),
+      [&](const threading::blocked_range<size_t>& partition_range) {
+        std::vector<int64_t> gathered_rows;
+        for (size_t partition = partition_range.begin();
+             partition != partition_range.end();
+             ++partition) {
+          auto i = partition_offsets[partition];
+          const auto partition_end = partition_offsets[partition + 1];
+          while (i < partition_end) {
+            const auto rs_idx = partitioned_entries[i].first;
+            const auto& rs = result_sets[rs_idx];
+            const auto rs_buff = rs->storage_->buff_;
+            gathered_rows.clear();
+            for (; i < partition_end && partitioned_entries[i].first == rs_idx; ++i) {
+              const auto row_ptr = reinterpret_cast<const int64_t*>(
+                  rs_buff + partitioned_entries[i].second * row_bytes);
+              gathered_rows.insert(gathered_rows.end(), row_ptr, row_ptr + row_quads);
+            }
+            const auto gathered_count = gathered_rows.size() / row_quads;
+            run_reduction_code(executor_id,
+                               reduction_code,
+                               reduced_buff,
+                               reinterpret_cast<const int8_t*>(gathered_rows.data()),
+                               0,
+                               gathered_count,
+                               gathered_count,
+                               &reduced_query_mem_desc,
+                               &rs->query_mem_desc_,
+                               nullptr);
+          }
+        }
+      });
+  return reduced_rs;
+}
+
 std::shared_ptr<ResultSet> ResultSetManager::getOwnResultSet() {
   return rs_;
 }
@@ -19,6 +19,10 @@
 #include "Shared/checked_alloc.h"
 #include "TopKSort.h"
 
+#include <algorithm>
+
+bool g_enable_top_n_fragment_skipping{true};
+
 namespace streaming_top_n {
 
 size_t get_heap_size(const size_t row_size, const size_t n, const size_t thread_count) {
@@ -42,6 +46,186 @@ std::vector<int8_t> get_rows_copy_from_heaps(const int64_t* heaps,
   return rows_copy;
 }
 
+std::unique_ptr<KeyThreshold> KeyThreshold::create(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& query_infos) {
+  if (!g_enable_top_n_fragment_skipping || ra_exe_unit.union_all ||
+      ra_exe_unit.sort_info.order_entries.empty() ||
+      ra_exe_unit.sort_info.algorithm != SortAlgorithm::StreamingTopN ||
+      !ra_exe_unit.sort_info.limit.value_or(0)) {
+    return nullptr;
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    if (dynamic_cast<const Analyzer::WindowFunction*>(target_expr)) {
+      return nullptr;
+    }
+  }
+  // Rows tied on the first order key are ordered by the remaining ones, but a row
+  // ordered strictly after the bound on the first key is ordered after all top n rows.
+  const auto& order_entry = ra_exe_unit.sort_info.order_entries.front();
+  CHECK_GE(order_entry.tle_no, 1);
+  const size_t key_target_idx = order_entry.tle_no - 1;
+  CHECK_LT(key_target_idx, ra_exe_unit.target_exprs.size());
+  const auto key_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(ra_exe_unit.target_exprs[key_target_idx]);
+  CHECK(!ra_exe_unit.input_descs.empty());
+  const auto& outer_table_key = ra_exe_unit.input_descs.front().getTableKey();
+  if (!key_col || key_col->get_rte_idx() || outer_table_key.table_id <= 0 ||
+      key_col->getTableKey() != outer_table_key) {
+    return nullptr;
+  }
+  // The chunk metadata of dates isn't in the units of the projected values.
+  const auto& key_ti = key_col->get_type_info();
+  if (!key_ti.is_integer() && !key_ti.is_decimal() && !key_ti.is_fp() &&
+      !key_ti.is_any<kTIME, kTIMESTAMP>()) {
+    return nullptr;
+  }
+  for (const auto& query_info : query_infos) {
+    if (query_info.table_key == outer_table_key) {
+      return std::unique_ptr<KeyThreshold>(
+          new KeyThreshold(query_info.info.fragments,
+                           key_col->getColumnKey().column_id,
+                           key_ti,
+                           key_target_idx,
+                           ra_exe_unit.sort_info.offset +
+                               ra_exe_unit.sort_info.limit.value_or(0),
+                           order_entry.is_desc,
+                           order_entry.nulls_first));
+    }
+  }
+  return nullptr;
+}
+
+KeyThreshold::KeyThreshold(
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& outer_fragments,
+    const int column_id,
+    const SQLTypeInfo& key_ti,
+    const size_t key_target_idx,
+    const size_t n,
+    const bool is_desc,
+    const bool nulls_first)
+    : outer_fragments_(outer_fragments)
+    , column_id_(column_id)
+    , key_ti_(key_ti)
+    , key_target_idx_(key_target_idx)
+    , n_(n)
+    , is_desc_(is_desc)
+    , nulls_first_(nulls_first) {}
+
+namespace {
+
+// Returns the n-th of the keys in sort order, or std::nullopt if it is null.
+template <typename T>
+std::optional<T> get_nth_key(std::vector<std::optional<T>>& keys,
+                             const size_t n,
+                             const bool is_desc,
+                             const bool nulls_first) {
+  CHECK_GT(n, size_t(0));
+  CHECK_LE(n, keys.size());
+  const auto ordered_before = [is_desc, nulls_first](const std::optional<T>& lhs,
+                                                     const std::optional<T>& rhs) {
+    if (!lhs || !rhs) {
+      return nulls_first ? !lhs && rhs : lhs && !rhs;
+    }
+    return is_desc ? *lhs > *rhs : *lhs < *rhs;
+  };
+  std::nth_element(keys.begin(), keys.begin() + (n - 1), keys.end(), ordered_before);
+  return keys[n - 1];
+}
+
+}  // namespace
+
+void KeyThreshold::update(const ResultSet& top_rows) {
+  std::vector<bool> targets_to_skip(top_rows.colCount(), true);
+  targets_to_skip[key_target_idx_] = false;
+  std::vector<std::optional<int64_t>> int_keys;
+  std::vector<std::optional<double>> fp_keys;
+  for (size_t i = 0; i < top_rows.entryCount(); ++i) {
+    if (top_rows.isRowAtEmpty(i)) {
+      continue;
+    }
+    const auto row = top_rows.getRowAtNoTranslations(i, targets_to_skip);
+    CHECK_LT(key_target_idx_, row.size());
+    const auto scalar_tv = boost::get<ScalarTargetValue>(&row[key_target_idx_]);
+    CHECK(scalar_tv);
+    if (const auto ival = boost::get<int64_t>(scalar_tv)) {
+      int_keys.push_back(ResultSet::isNullIval(key_ti_, false, *ival)
+                             ? std::nullopt
+                             : std::make_optional(*ival));
+    } else if (const auto fval = boost::get<float>(scalar_tv)) {
+      fp_keys.push_back(*fval == NULL_FLOAT ? std::nullopt
+                                            : std::make_optional<double>(*fval));
+    } else {
+      const auto dval = boost::get<double>(scalar_tv);
+      CHECK(dval);
+      fp_keys.push_back(*dval == NULL_DOUBLE ? std::nullopt : std::make_optional(*dval));
+    }
+  }
+  // A kernel which found less than n rows proves nothing about the other fragments.
+  if (int_keys.size() + fp_keys.size() < n_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(bound_mutex_);
+  if (key_ti_.is_fp()) {
+    const auto last_key = get_nth_key(fp_keys, n_, is_desc_, nulls_first_);
+    if (last_key && (!fp_bound_ || (is_desc_ ? *last_key > *fp_bound_
+                                             : *last_key < *fp_bound_))) {
+      fp_bound_ = last_key;
+    }
+  } else {
+    const auto last_key = get_nth_key(int_keys, n_, is_desc_, nulls_first_);
+    if (last_key && (!int_bound_ || (is_desc_ ? *last_key > *int_bound_
+                                              : *last_key < *int_bound_))) {
+      int_bound_ = last_key;
+    }
+  }
+}
+
+bool KeyThreshold::canSkipFragments(const std::vector<size_t>& outer_fragment_ids) const {
+  for (const auto frag_id : outer_fragment_ids) {
+    CHECK_LT(frag_id, outer_fragments_.size());
+    if (!canSkipFragment(outer_fragments_[frag_id])) {
+      return false;
+    }
+  }
+  return !outer_fragment_ids.empty();
+}
+
+bool KeyThreshold::canSkipFragment(
+    const Fragmenter_Namespace::FragmentInfo& fragment) const {
+  const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+  const auto chunk_metadata_it = chunk_metadata_map.find(column_id_);
+  if (chunk_metadata_it == chunk_metadata_map.end()) {
+    return false;
+  }
+  const auto& chunk_stats = chunk_metadata_it->second->chunkStats;
+  // Nulls placed first are ordered before any bound.
+  if (chunk_stats.has_nulls && nulls_first_) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(bound_mutex_);
+  if (key_ti_.is_fp()) {
+    if (!fp_bound_) {
+      return false;
+    }
+    const auto chunk_min = extract_min_stat_fp_type(chunk_stats, key_ti_);
+    const auto chunk_max = extract_max_stat_fp_type(chunk_stats, key_ti_);
+    if (chunk_min > chunk_max) {
+      return false;  // invalid metadata range
+    }
+    return is_desc_ ? chunk_max < *fp_bound_ : chunk_min > *fp_bound_;
+  }
+  if (!int_bound_) {
+    return false;
+  }
+  const auto chunk_min = extract_min_stat_int_type(chunk_stats, key_ti_);
+  const auto chunk_max = extract_max_stat_int_type(chunk_stats, key_ti_);
+  if (chunk_min > chunk_max) {
+    return false;  // invalid metadata range
+  }
+  return is_desc_ ? chunk_max < *int_bound_ : chunk_min > *int_bound_;
+}
+
 }  // namespace streaming_top_n
 
 size_t get_heap_key_slot_index(const std::vector<Analyzer::Expr*>& target_exprs,
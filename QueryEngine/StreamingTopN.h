@@ -25,8 +25,21 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 
+#include "Shared/sqltypes.h"
+
+class ResultSet;
+struct InputTableInfo;
+struct RelAlgExecutionUnit;
+
+namespace Fragmenter_Namespace {
+class FragmentInfo;
+}  // namespace Fragmenter_Namespace
+
 namespace streaming_top_n {
 
 size_t get_heap_size(const size_t row_size, const size_t n, const size_t thread_count);
@@ -38,9 +51,48 @@ std::vector<int8_t> get_rows_copy_from_heaps(const int64_t* heaps,
                                              const size_t n,
                                              const size_t thread_count);
 
-}  // namespace streaming_top_n
+// Bound on the first order key of the final top n rows, shared by the kernels of a
+// projection with ORDER BY and LIMIT. A kernel which found n rows has found n rows
+// ordered no later than the n-th of them, hence rows whose first order key is ordered
+// after the tightest such bound can't make the result. Kernels skip their fragments when
+// the chunk metadata proves that all of their rows are ordered after it.
+class KeyThreshold {
+ public:
+  // Returns nullptr unless the first order entry is a numeric column of the outer table.
+  static std::unique_ptr<KeyThreshold> create(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& query_infos);
 
-struct RelAlgExecutionUnit;
+  // Tightens the bound with the rows found by a kernel.
+  void update(const ResultSet& top_rows);
+
+  bool canSkipFragments(const std::vector<size_t>& outer_fragment_ids) const;
+
+ private:
+  KeyThreshold(const std::vector<Fragmenter_Namespace::FragmentInfo>& outer_fragments,
+               const int column_id,
+               const SQLTypeInfo& key_ti,
+               const size_t key_target_idx,
+               const size_t n,
+               const bool is_desc,
+               const bool nulls_first);
+
+  bool canSkipFragment(const Fragmenter_Namespace::FragmentInfo& fragment) const;
+
+  const std::vector<Fragmenter_Namespace::FragmentInfo>& outer_fragments_;
+  const int column_id_;
+  const SQLTypeInfo key_ti_;
+  const size_t key_target_idx_;
+  const size_t n_;
+  const bool is_desc_;
+  const bool nulls_first_;
+
+  mutable std::mutex bound_mutex_;
+  std::optional<int64_t> int_bound_;
+  std::optional<double> fp_bound_;
+};
+
+}  // namespace streaming_top_n
 
 namespace Analyzer {
 class Expr;
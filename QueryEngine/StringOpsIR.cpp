@@ -584,6 +584,59 @@ llvm::Value* CodeGenerator::codegenPseudoStringOper(
       ->codegen(str_id_lv[0], expr_ti, true /* add_nullcheck */, co);
 }
 
+namespace {
+
+// The LIKE pattern shapes with a dedicated runtime matcher; the generic matcher handles
+// everything else
+enum class LikePatternShape { kGeneric, kPrefix, kSuffix, kExact, kContains };
+
+// Splits a pattern whose only wildcards are runs of '%' at its start and/or end into the
+// shape of the match and the literal text to look for, with escape characters removed
+std::pair<LikePatternShape, std::string> get_like_pattern_shape(
+    const std::string& pattern,
+    const char escape_char) {
+  if (escape_char == '%' || escape_char == '_') {
+    return {LikePatternShape::kGeneric, {}};
+  }
+  size_t start = 0;
+  while (start < pattern.size() && pattern[start] == '%') {
+    ++start;
+  }
+  std::string literal;
+  bool trailing_wildcard = false;
+  for (size_t i = start; i < pattern.size(); ++i) {
+    const auto c = pattern[i];
+    if (trailing_wildcard) {
+      if (c != '%') {
+        return {LikePatternShape::kGeneric, {}};
+      }
+    } else if (c == escape_char) {
+      if (++i == pattern.size()) {
+        return {LikePatternShape::kGeneric, {}};
+      }
+      literal.push_back(pattern[i]);
+    } else if (c == '%') {
+      trailing_wildcard = true;
+    } else if (c == '_' || c == '[' || c == ']') {
+      return {LikePatternShape::kGeneric, {}};
+    } else {
+      literal.push_back(c);
+    }
+  }
+  if (literal.empty()) {
+    return {LikePatternShape::kGeneric, {}};
+  }
+  const bool leading_wildcard = start > 0;
+  if (leading_wildcard) {
+    return {trailing_wildcard ? LikePatternShape::kContains : LikePatternShape::kSuffix,
+            literal};
+  }
+  return {trailing_wildcard ? LikePatternShape::kPrefix : LikePatternShape::kExact,
+          literal};
+}
+
+}  // namespace
+
 llvm::Value* CodeGenerator::codegen(const Analyzer::LikeExpr* expr,
                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
@@ -628,7 +681,39 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::LikeExpr* expr,
       throw QueryMustRunOnCpu();
     }
   }
-  auto like_expr_arg_lvs = codegen(expr->get_like_expr(), true, co);
+  std::string fn_name{expr->get_is_ilike() ? "string_ilike" : "string_like"};
+  std::shared_ptr<Analyzer::Constant> like_literal;
+  if (expr->get_is_simple()) {
+    fn_name += "_simple";
+  } else {
+    // Anchored patterns are matched against their literal text with a plain byte
+    // comparison instead of the generic backtracking matcher
+    auto [shape, literal] =
+        get_like_pattern_shape(*pattern->get_constval().stringval, escape_char);
+    if (shape != LikePatternShape::kGeneric) {
+      switch (shape) {
+        case LikePatternShape::kPrefix:
+          fn_name += "_prefix";
+          break;
+        case LikePatternShape::kSuffix:
+          fn_name += "_suffix";
+          break;
+        case LikePatternShape::kExact:
+          fn_name += "_exact";
+          break;
+        case LikePatternShape::kContains:
+          fn_name += "_simple";
+          break;
+        default:
+          UNREACHABLE();
+      }
+      Datum d;
+      d.stringval = new std::string(std::move(literal));
+      like_literal = makeExpr<Analyzer::Constant>(pattern->get_type_info(), false, d);
+    }
+  }
+  auto like_expr_arg_lvs =
+      codegen(like_literal ? like_literal.get() : expr->get_like_expr(), true, co);
   CHECK_EQ(size_t(3), like_expr_arg_lvs.size());
   const bool is_nullable{!expr->get_arg()->get_type_info().get_notnull()};
   std::vector<llvm::Value*> str_like_args{str_lv[1],
@@ -636,10 +721,6 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::LikeExpr* expr,
                                           like_expr_arg_lvs[1],
                                           like_expr_arg_lvs[2],
                                           cgen_state_->llInt(int8_t(escape_char))};
-  std::string fn_name{expr->get_is_ilike() ? "string_ilike" : "string_like"};
-  if (expr->get_is_simple()) {
-    fn_name += "_simple";
-  }
   if (is_nullable) {
     fn_name += "_nullable";
     str_like_args.push_back(cgen_state_->inlineIntNull(expr->get_type_info()));
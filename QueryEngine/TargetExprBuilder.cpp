@@ -575,6 +575,21 @@ void TargetExprCodegen::codegenAggregate(
             executor->cgen_state_->castToTypeIn(null_in_lv, (agg_chosen_bytes << 3));
         agg_args.push_back(null_lv);
       }
+      if (const auto agg_predicate = group_by_and_agg->agg_predicate_) {
+        CHECK(!is_group_by);
+        if (is_simple_count_target && !arg_expr) {
+          // COUNT(*) adds the predicate itself
+          CHECK(agg_fname.find(agg_base_name) == 0);
+          agg_fname.replace(0, agg_base_name.size(), "agg_count_if");
+          agg_args[1] = LL_BUILDER.CreateZExt(
+              agg_predicate, get_int_type(agg_chosen_bytes << 3, LL_CONTEXT));
+        } else {
+          // the value of a row which fails the filter is replaced by the skipped null
+          CHECK(need_skip_null);
+          CHECK_EQ(agg_args.size(), size_t(3));
+          agg_args[1] = LL_BUILDER.CreateSelect(agg_predicate, agg_args[1], agg_args[2]);
+        }
+      }
       if (target_info.agg_kind == kSUM_IF) {
         const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
         auto cond_expr_lv =
@@ -240,6 +240,8 @@ enum class JoinType {
   LEFT,
   SEMI,
   ANTI,
+  RIGHT,
+  FULL,
   WINDOW_FUNCTION,
   WINDOW_FUNCTION_FRAMING,
   INVALID
@@ -261,6 +263,10 @@ inline std::string toString(const JoinType& join_type) {
       return "SEMI";
     case JoinType::ANTI:
       return "ANTI";
+    case JoinType::RIGHT:
+      return "RIGHT";
+    case JoinType::FULL:
+      return "FULL";
     case JoinType::WINDOW_FUNCTION:
       return "WINDOW_FUNCTION";
     case JoinType::WINDOW_FUNCTION_FRAMING:
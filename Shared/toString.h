@@ -302,6 +302,10 @@ std::string toString(const T& v) {
         return "SEMI";
       case JoinType::ANTI:
         return "ANTI";
+      case JoinType::RIGHT:
+        return "RIGHT";
+      case JoinType::FULL:
+        return "FULL";
       case JoinType::WINDOW_FUNCTION:
         return "WINDOW_FUNCTION";
       case JoinType::WINDOW_FUNCTION_FRAMING:
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringDictionary/DictionaryQueryCache.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "Logger/Logger.h"
+
+namespace {
+
+// Per entry bookkeeping: the list node, the hash map node and the map's copy of the key
+constexpr size_t kEntryOverheadBytes{128};
+
+struct ValueSize {
+  size_t operator()(const std::vector<int32_t>& ids) const {
+    return ids.capacity() * sizeof(int32_t);
+  }
+  size_t operator()(const std::vector<int64_t>& ids) const {
+    return ids.capacity() * sizeof(int64_t);
+  }
+  size_t operator()(const int32_t) const { return sizeof(int32_t); }
+  size_t operator()(const std::shared_ptr<const std::vector<std::string>>& strs) const {
+    CHECK(strs);
+    size_t size = strs->capacity() * sizeof(std::string);
+    for (const auto& str : *strs) {
+      // Short strings live inside the std::string object itself
+      if (str.capacity() >= sizeof(std::string)) {
+        size += str.capacity();
+      }
+    }
+    return size;
+  }
+};
+
+size_t compute_entry_size(const std::string& key,
+                          const DictionaryQueryCache::Value& value) {
+  return kEntryOverheadBytes + 2 * key.size() + std::visit(ValueSize{}, value);
+}
+
+// Entries of the caches of all the dictionaries, in a single LRU list
+class SharedQueryCacheStore {
+ public:
+  uint64_t registerCache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto cache_id = next_cache_id_++;
+    caches_.emplace(cache_id, CacheState{});
+    return cache_id;
+  }
+
+  void unregisterCache(const uint64_t cache_id) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clearUnlocked(cache_id);
+    caches_.erase(cache_id);
+  }
+
+  std::optional<DictionaryQueryCache::Value> get(const uint64_t cache_id,
+                                                 const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& cache = getCache(cache_id);
+    const auto it = cache.entries.find(key);
+    if (it == cache.entries.end()) {
+      ++cache.miss_count;
+      return std::nullopt;
+    }
+    lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+    ++cache.hit_count;
+    return it->second->value;
+  }
+
+  bool put(const uint64_t cache_id,
+           const std::string& key,
+           DictionaryQueryCache::Value value,
+           const size_t entry_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& cache = getCache(cache_id);
+    if (const auto it = cache.entries.find(key); it != cache.entries.end()) {
+      eraseUnlocked(cache, it->second);
+    }
+    const auto max_size_in_bytes = g_stringdict_query_cache_size;
+    if (entry_size > max_size_in_bytes) {
+      return false;
+    }
+    while (!lru_list_.empty() && size_in_bytes_ + entry_size > max_size_in_bytes) {
+      const auto lru_entry = std::prev(lru_list_.end());
+      auto& lru_cache = getCache(lru_entry->cache_id);
+      ++lru_cache.eviction_count;
+      eraseUnlocked(lru_cache, lru_entry);
+    }
+    CHECK_LE(size_in_bytes_ + entry_size, max_size_in_bytes);
+    lru_list_.push_front(Entry{cache_id, key, std::move(value), entry_size});
+    cache.entries.emplace(key, lru_list_.begin());
+    cache.size_in_bytes += entry_size;
+    size_in_bytes_ += entry_size;
+    return true;
+  }
+
+  void clear(const uint64_t cache_id) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clearUnlocked(cache_id);
+  }
+
+  DictionaryQueryCache::Stats getStats(const uint64_t cache_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& cache = getCache(cache_id);
+    DictionaryQueryCache::Stats stats;
+    stats.entry_count = cache.entries.size();
+    stats.size_in_bytes = cache.size_in_bytes;
+    stats.max_size_in_bytes = g_stringdict_query_cache_size;
+    stats.hit_count = cache.hit_count;
+    stats.miss_count = cache.miss_count;
+    stats.eviction_count = cache.eviction_count;
+    return stats;
+  }
+
+  size_t getSizeInBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_in_bytes_;
+  }
+
+ private:
+  struct Entry {
+    uint64_t cache_id;
+    std::string key;
+    DictionaryQueryCache::Value value;
+    size_t size_in_bytes;
+  };
+  using EntryIterator = std::list<Entry>::iterator;
+
+  struct CacheState {
+    std::unordered_map<std::string, EntryIterator> entries;
+    size_t size_in_bytes{0};
+    size_t hit_count{0};
+    size_t miss_count{0};
+    size_t eviction_count{0};
+  };
+
+  CacheState& getCache(const uint64_t cache_id) {
+    const auto it = caches_.find(cache_id);
+    CHECK(it != caches_.end());
+    return it->second;
+  }
+
+  void eraseUnlocked(CacheState& cache, const EntryIterator entry) noexcept {
+    cache.size_in_bytes -= entry->size_in_bytes;
+    size_in_bytes_ -= entry->size_in_bytes;
+    cache.entries.erase(entry->key);
+    lru_list_.erase(entry);
+  }
+
+  void clearUnlocked(const uint64_t cache_id) noexcept {
+    const auto it = caches_.find(cache_id);
+    if (it == caches_.end()) {
+      return;
+    }
+    auto& cache = it->second;
+    for (const auto& [key, entry] : cache.entries) {
+      size_in_bytes_ -= entry->size_in_bytes;
+      lru_list_.erase(entry);
+    }
+    cache.entries.clear();
+    cache.size_in_bytes = 0;
+  }
+
+  std::mutex mutex_;
+  // Most recently used entries first
+  std::list<Entry> lru_list_;
+  std::unordered_map<uint64_t, CacheState> caches_;
+  size_t size_in_bytes_{0};
+  uint64_t next_cache_id_{0};
+};
+
+// Never destroyed, since dictionaries owned by static objects may outlive it otherwise
+SharedQueryCacheStore& get_shared_store() {
+  static auto store = new SharedQueryCacheStore();
+  return *store;
+}
+
+}  // namespace
+
+DictionaryQueryCache::DictionaryQueryCache()
+    : cache_id_(get_shared_store().registerCache()) {}
+
+DictionaryQueryCache::~DictionaryQueryCache() {
+  get_shared_store().unregisterCache(cache_id_);
+}
+
+std::optional<DictionaryQueryCache::Value> DictionaryQueryCache::getValue(
+    const std::string& key) {
+  return get_shared_store().get(cache_id_, key);
+}
+
+bool DictionaryQueryCache::put(const std::string& key, Value value) {
+  const auto entry_size = compute_entry_size(key, value);
+  return get_shared_store().put(cache_id_, key, std::move(value), entry_size);
+}
+
+void DictionaryQueryCache::clear() noexcept {
+  get_shared_store().clear(cache_id_);
+}
+
+size_t DictionaryQueryCache::getSizeInBytes() const {
+  return getStats().size_in_bytes;
+}
+
+DictionaryQueryCache::Stats DictionaryQueryCache::getStats() const {
+  return get_shared_store().getStats(cache_id_);
+}
+
+size_t DictionaryQueryCache::getTotalSizeInBytes() {
+  return get_shared_store().getSizeInBytes();
+}
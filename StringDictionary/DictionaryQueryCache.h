@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    DictionaryQueryCache.h
+ * @brief   Byte-budgeted LRU cache for the results of string dictionary scans.
+ *
+ * Holds the string id lists produced by LIKE, REGEXP and equality lookups as well as
+ * full string copies, so repeated predicates over the same dictionary do not rescan
+ * its payload. The caches of all the dictionaries share a single LRU list and the byte
+ * budget set by g_stringdict_query_cache_size: every entry is charged its key and result
+ * size, the least recently used entries of any dictionary are evicted once the budget is
+ * exceeded, and results larger than the whole budget are not cached at all.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+extern size_t g_stringdict_query_cache_size;
+
+class DictionaryQueryCache {
+ public:
+  using Value = std::variant<std::vector<int32_t>,
+                             std::vector<int64_t>,
+                             int32_t,
+                             std::shared_ptr<const std::vector<std::string>>>;
+
+  struct Stats {
+    size_t entry_count{0};
+    size_t size_in_bytes{0};
+    size_t max_size_in_bytes{0};
+    size_t hit_count{0};
+    size_t miss_count{0};
+    size_t eviction_count{0};
+  };
+
+  DictionaryQueryCache();
+  ~DictionaryQueryCache();
+
+  DictionaryQueryCache(const DictionaryQueryCache&) = delete;
+  DictionaryQueryCache& operator=(const DictionaryQueryCache&) = delete;
+
+  // Returns a copy of the cached result, or std::nullopt on a miss
+  template <typename T>
+  std::optional<T> get(const std::string& key) {
+    auto value = getValue(key);
+    if (!value) {
+      return std::nullopt;
+    }
+    return std::get<T>(std::move(*value));
+  }
+
+  // Returns false if the entry does not fit in the cache
+  bool put(const std::string& key, Value value);
+
+  // Drops the entries of this dictionary only
+  void clear() noexcept;
+
+  size_t getSizeInBytes() const;
+  // max_size_in_bytes is the budget shared with the caches of the other dictionaries
+  Stats getStats() const;
+
+  // Bytes held by the caches of all the dictionaries
+  static size_t getTotalSizeInBytes();
+
+ private:
+  std::optional<Value> getValue(const std::string& key);
+
+  const uint64_t cache_id_;
+};
@@ -111,9 +111,37 @@ struct ThreadInfo {
   }
 };
 
+// Keys of the query cache, prefixed by the kind of lookup so that all of them can share
+// one LRU
+template <typename T>
+std::string like_cache_key(const std::string& pattern,
+                           const bool icase,
+                           const bool is_simple,
+                           const char escape) {
+  return std::string{sizeof(T) == sizeof(int32_t) ? 'L' : 'l',
+                     icase ? 'i' : 's',
+                     is_simple ? 's' : 'p',
+                     escape} +
+         pattern;
+}
+
+std::string regex_cache_key(const std::string& pattern, const char escape) {
+  return std::string{'R', escape} + pattern;
+}
+
+std::string equal_cache_key(const std::string& pattern) {
+  return 'E' + pattern;
+}
+
+std::string strings_cache_key() {
+  return "S";
+}
+
 }  // namespace
 
 bool g_enable_stringdict_parallel{false};
+bool g_enable_stringdict_compression{false};
+size_t g_stringdict_query_cache_size{256 * 1024 * 1024};
 constexpr int32_t StringDictionary::INVALID_STR_ID;
 constexpr size_t StringDictionary::MAX_STRLEN;
 constexpr size_t StringDictionary::MAX_STRCOUNT;
@@ -138,12 +166,7 @@ StringDictionary::StringDictionary(const shared::StringDictKey& dict_key,
     , offset_file_size_(0)
     , payload_file_size_(0)
     , payload_file_off_(0)
-    , like_cache_size_(0)
-    , regex_cache_size_(0)
-    , equal_cache_size_(0)
-    , compare_cache_size_(0)
-    , strings_cache_(nullptr)
-    , strings_cache_size_(0) {
+    , compare_cache_size_(0) {
   if (!isTemp && folder.empty()) {
     return;
   }
@@ -155,6 +178,9 @@ StringDictionary::StringDictionary(const shared::StringDictKey& dict_key,
     offsets_path_ = (storage_path / boost::filesystem::path("DictOffsets")).string();
     const auto payload_path =
         (storage_path / boost::filesystem::path("DictPayload")).string();
+    symbols_path_ =
+        (storage_path / boost::filesystem::path(StringPayloadCompressor::kSymbolsFileName))
+            .string();
     payload_fd_ = checked_open(payload_path.c_str(), recover);
     offset_fd_ = checked_open(offsets_path_.c_str(), recover);
     payload_file_size_ = heavyai::file_size(payload_fd_);
@@ -173,6 +199,7 @@ StringDictionary::StringDictionary(const shared::StringDictKey& dict_key,
         reinterpret_cast<char*>(heavyai::checked_mmap(payload_fd_, payload_file_size_));
     offset_map_ = reinterpret_cast<StringIdxEntry*>(
         heavyai::checked_mmap(offset_fd_, offset_file_size_));
+    initPayloadCompressor(storage_is_empty || getStringFromStorage(0).canary);
     if (recover) {
       const size_t bytes = heavyai::file_size(offset_fd_);
       if (bytes % sizeof(StringIdxEntry) != 0) {
@@ -291,8 +318,9 @@ void StringDictionary::eachStringSerially(int64_t const generation,
     size_t const n = std::min(static_cast<size_t>(generation), str_count_);
     CHECK_LE(n, static_cast<size_t>(std::numeric_limits<int32_t>::max()) + 1);
     std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
+    std::string decode_buffer;
     for (unsigned id = 0; id < n; ++id) {
-      serial_callback(getStringFromStorageFast(static_cast<int>(id)), id);
+      serial_callback(decodeStringFromStorage(static_cast<int>(id), decode_buffer), id);
     }
   }
 }
@@ -356,7 +384,6 @@ StringDictionary::StringDictionary(const LeafHostInfo& host,
     : dict_key_(dict_key)
     , folder_("DB_" + std::to_string(dict_key.db_id) + "_DICT_" +
               std::to_string(dict_key.dict_id))
-    , strings_cache_(nullptr)
     , client_(new StringDictionaryClient(host, {dict_key.db_id, dict_key.dict_id}, true))
     , client_no_timeout_(
           new StringDictionaryClient(host, {dict_key.db_id, dict_key.dict_id}, false)) {}
@@ -508,6 +535,21 @@ template <class T, class String>
 size_t StringDictionary::getBulk(const std::vector<String>& string_vec,
                                  T* encoded_vec,
                                  const int64_t generation) const {
+  if (string_vec.empty()) {
+    return 0;
+  }
+  std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
+  if (payload_compressor_) {
+    // Encode under the read lock so the symbol table cannot be trained underneath us
+    return getBulkUnlocked(encodePayloadStrings(string_vec), encoded_vec, generation);
+  }
+  return getBulkUnlocked(string_vec, encoded_vec, generation);
+}
+
+template <class T, class String>
+size_t StringDictionary::getBulkUnlocked(const std::vector<String>& string_vec,
+                                         T* encoded_vec,
+                                         const int64_t generation) const {
   constexpr int64_t target_strings_per_thread{1000};
   const int64_t num_lookup_strings = string_vec.size();
   if (num_lookup_strings == 0) {
@@ -521,8 +563,7 @@ size_t StringDictionary::getBulk(const std::vector<String>& string_vec,
 
   std::vector<size_t> num_strings_not_found_per_thread(thread_info.num_threads, 0UL);
 
-  std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
-  const int64_t num_dict_strings = generation >= 0 ? generation : storageEntryCount();
+  const int64_t num_dict_strings = generation >= 0 ? generation : str_count_;
   const bool dictionary_is_empty = (num_dict_strings == 0);
   if (dictionary_is_empty) {
     tbb::parallel_for(tbb::blocked_range<int64_t>(0, num_lookup_strings),
@@ -554,7 +595,7 @@ size_t StringDictionary::getBulk(const std::vector<String>& string_vec,
               encoded_vec[string_idx] = inline_int_null_value<T>();
               continue;
             }
-            if (input_string.size() > StringDictionary::MAX_STRLEN) {
+            if (input_string.size() > maxStoredStringLength()) {
               throw_string_too_long_error(input_string, dict_key_);
             }
             const string_dict_hash_t input_string_hash = hash_string(input_string);
@@ -596,6 +637,17 @@ template size_t StringDictionary::getBulk(const std::vector<std::string>& string
 template <class T, class String>
 void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
                                     T* output_string_ids) {
+  if (preparePayloadCompressor(&input_strings)) {
+    getOrAddBulkStored(encodePayloadStrings(input_strings), output_string_ids);
+    return;
+  }
+  getOrAddBulkStored(input_strings, output_string_ids);
+}
+
+// Expects input_strings to already be in their stored (possibly encoded) form
+template <class T, class String>
+void StringDictionary::getOrAddBulkStored(const std::vector<String>& input_strings,
+                                          T* output_string_ids) {
   if (g_enable_stringdict_parallel) {
     getOrAddBulkParallel(input_strings, output_string_ids);
     return;
@@ -610,7 +662,7 @@ void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
       output_string_ids[idx++] = inline_int_null_value<T>();
       continue;
     }
-    CHECK(input_string.size() <= MAX_STRLEN);
+    CHECK(input_string.size() <= maxStoredStringLength());
 
     const string_dict_hash_t input_string_hash = hash_string(input_string);
     uint32_t hash_bucket =
@@ -674,7 +726,7 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
       continue;
     }
     // TODO: Recover gracefully if an input string is too long
-    CHECK(input_string.size() <= MAX_STRLEN);
+    CHECK(input_string.size() <= maxStoredStringLength());
 
     if (fillRateIsHigh(shadow_str_count)) {
       // resize when more than 50% is full
@@ -763,7 +815,12 @@ int32_t StringDictionary::getIdOfString(const String& str) const {
 template int32_t StringDictionary::getIdOfString(const std::string&) const;
 template int32_t StringDictionary::getIdOfString(const std::string_view&) const;
 
-int32_t StringDictionary::getUnlocked(const std::string_view sv) const noexcept {
+int32_t StringDictionary::getUnlocked(const std::string_view raw_sv) const noexcept {
+  std::string encoded_str;
+  if (payload_compressor_) {
+    payload_compressor_->encode(raw_sv, encoded_str);
+  }
+  const std::string_view sv = payload_compressor_ ? encoded_str : raw_sv;
   const string_dict_hash_t hash = hash_string(sv);
   auto str_id = string_id_string_dict_hash_table_[computeBucket(
       hash, sv, string_id_string_dict_hash_table_)];
@@ -875,18 +932,14 @@ std::vector<int32_t> StringDictionary::getLike<int32_t>(const std::string& patte
   if (isClient()) {
     return client_->get_like_i32(pattern, icase, is_simple, escape, generation);
   }
-  const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape);
-  const auto it = like_i32_cache_.find(cache_key);
-  if (it != like_i32_cache_.end()) {
-    return it->second;
+  const auto cache_key = like_cache_key<int32_t>(pattern, icase, is_simple, escape);
+  if (const auto cached_ids = query_cache_.get<std::vector<int32_t>>(cache_key)) {
+    return *cached_ids;
   }
 
   auto result = getLikeImpl<int32_t>(pattern, icase, is_simple, escape, generation);
   // place result into cache for reuse if similar query
-  const auto it_ok = like_i32_cache_.insert(std::make_pair(cache_key, result));
-  like_cache_size_ += (pattern.size() + 3 + (result.size() * sizeof(int32_t)));
-
-  CHECK(it_ok.second);
+  query_cache_.put(cache_key, result);
 
   return result;
 }
@@ -901,18 +954,14 @@ std::vector<int64_t> StringDictionary::getLike<int64_t>(const std::string& patte
   if (isClient()) {
     return client_->get_like_i64(pattern, icase, is_simple, escape, generation);
   }
-  const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape);
-  const auto it = like_i64_cache_.find(cache_key);
-  if (it != like_i64_cache_.end()) {
-    return it->second;
+  const auto cache_key = like_cache_key<int64_t>(pattern, icase, is_simple, escape);
+  if (const auto cached_ids = query_cache_.get<std::vector<int64_t>>(cache_key)) {
+    return *cached_ids;
   }
 
   auto result = getLikeImpl<int64_t>(pattern, icase, is_simple, escape, generation);
   // place result into cache for reuse if similar query
-  const auto it_ok = like_i64_cache_.insert(std::make_pair(cache_key, result));
-  like_cache_size_ += (pattern.size() + 3 + (result.size() * sizeof(int64_t)));
-
-  CHECK(it_ok.second);
+  query_cache_.put(cache_key, result);
 
   return result;
 }
@@ -921,11 +970,12 @@ std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
                                                  std::string comp_operator,
                                                  size_t generation) {
   std::vector<int32_t> result;
-  auto eq_id_itr = equal_cache_.find(pattern);
+  const auto cache_key = equal_cache_key(pattern);
+  const auto cached_eq_id = query_cache_.get<int32_t>(cache_key);
   int32_t eq_id = MAX_STRLEN + 1;
   int32_t cur_size = str_count_;
-  if (eq_id_itr != equal_cache_.end()) {
-    eq_id = eq_id_itr->second;
+  if (cached_eq_id) {
+    eq_id = *cached_eq_id;
     if (comp_operator == "=") {
       result.push_back(eq_id);
     } else {
@@ -942,13 +992,16 @@ std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
     CHECK_GT(worker_count, 0);
     std::vector<std::vector<int32_t>> worker_results(worker_count);
     CHECK_LE(generation, str_count_);
+    // Compare against the stored bytes directly, encoding the pattern once if needed
+    const std::string stored_pattern =
+        payload_compressor_ ? payload_compressor_->encode(pattern) : pattern;
     for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
       workers.emplace_back(
-          [&worker_results, &pattern, generation, worker_idx, worker_count, this]() {
+          [&worker_results, &stored_pattern, generation, worker_idx, worker_count, this]() {
             for (size_t string_id = worker_idx; string_id < generation;
                  string_id += worker_count) {
-              const auto str = getStringUnlocked(string_id);
-              if (str == pattern) {
+              const auto str = getStringFromStorageFast(string_id);
+              if (str == stored_pattern) {
                 worker_results[worker_idx].push_back(string_id);
               }
             }
@@ -961,9 +1014,7 @@ std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
       result.insert(result.end(), worker_result.begin(), worker_result.end());
     }
     if (result.size() > 0) {
-      const auto it_ok = equal_cache_.insert(std::make_pair(pattern, result[0]));
-      equal_cache_size_ += (pattern.size() + (result.size() * sizeof(int32_t)));
-      CHECK(it_ok.second);
+      query_cache_.put(cache_key, result[0]);
       eq_id = result[0];
     }
     if (comp_operator == "<>") {
@@ -1000,22 +1051,24 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
 
   if (!cache_index) {
     cache_index = std::make_shared<StringDictionary::compare_cache_value_t>();
+    std::string decode_buffer;
     const auto cache_itr = std::lower_bound(
         sorted_cache.begin(),
         sorted_cache.end(),
         pattern,
-        [this](decltype(sorted_cache)::value_type const& a, decltype(pattern)& b) {
-          auto a_str = this->getStringFromStorage(a);
-          return string_lt(a_str.c_str_ptr, a_str.size, b.c_str(), b.size());
+        [this, &decode_buffer](decltype(sorted_cache)::value_type const& a,
+                               decltype(pattern)& b) {
+          auto a_str = this->decodeStringFromStorage(a, decode_buffer);
+          return string_lt(a_str.data(), a_str.size(), b.c_str(), b.size());
         });
 
     if (cache_itr == sorted_cache.end()) {
       cache_index->index = sorted_cache.size() - 1;
       cache_index->diff = 1;
     } else {
-      const auto cache_str = getStringFromStorage(*cache_itr);
+      const auto cache_str = decodeStringFromStorage(*cache_itr, decode_buffer);
       if (!string_eq(
-              cache_str.c_str_ptr, cache_str.size, pattern.c_str(), pattern.size())) {
+              cache_str.data(), cache_str.size(), pattern.c_str(), pattern.size())) {
         cache_index->index = cache_itr - sorted_cache.begin() - 1;
         cache_index->diff = 1;
       } else {
@@ -1147,10 +1200,9 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   if (isClient()) {
     return client_->get_regexp_like(pattern, escape, generation);
   }
-  const auto cache_key = std::make_pair(pattern, escape);
-  const auto it = regex_cache_.find(cache_key);
-  if (it != regex_cache_.end()) {
-    return it->second;
+  const auto cache_key = regex_cache_key(pattern, escape);
+  if (const auto cached_ids = query_cache_.get<std::vector<int32_t>>(cache_key)) {
+    return *cached_ids;
   }
   std::vector<int32_t> result;
   std::vector<std::thread> workers;
@@ -1181,9 +1233,7 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   for (const auto& worker_result : worker_results) {
     result.insert(result.end(), worker_result.begin(), worker_result.end());
   }
-  const auto it_ok = regex_cache_.insert(std::make_pair(cache_key, result));
-  regex_cache_size_ += (pattern.size() + 1 + (result.size() * sizeof(int32_t)));
-  CHECK(it_ok.second);
+  query_cache_.put(cache_key, result);
 
   return result;
 }
@@ -1196,28 +1246,26 @@ std::vector<std::string> StringDictionary::copyStrings() const {
         "copying dictionaries from remote server is not supported yet.");
   }
 
-  if (strings_cache_) {
-    return *strings_cache_;
+  const auto cache_key = strings_cache_key();
+  using CachedStrings = std::shared_ptr<const std::vector<std::string>>;
+  if (const auto cached_strings = query_cache_.get<CachedStrings>(cache_key)) {
+    return **cached_strings;
   }
 
-  strings_cache_ = std::make_shared<std::vector<std::string>>();
-  strings_cache_->reserve(str_count_);
+  auto strings = std::make_shared<std::vector<std::string>>();
+  strings->reserve(str_count_);
   const bool multithreaded = str_count_ > 10000;
   const auto worker_count =
       multithreaded ? static_cast<size_t>(cpu_threads()) : size_t(1);
   CHECK_GT(worker_count, 0UL);
   std::vector<std::vector<std::string>> worker_results(worker_count);
-  std::vector<size_t> string_size(worker_count, 0);
-  auto copy = [this, &string_size](std::vector<std::string>& str_list,
-                                   const size_t worker_idx,
-                                   const size_t start_id,
-                                   const size_t end_id) {
+  auto copy = [this](std::vector<std::string>& str_list,
+                     const size_t start_id,
+                     const size_t end_id) {
     CHECK_LE(start_id, end_id);
     str_list.reserve(end_id - start_id);
     for (size_t string_id = start_id; string_id < end_id; ++string_id) {
-      auto str = getStringUnlocked(string_id);
-      string_size[worker_idx] += str.size();
-      str_list.push_back(str);
+      str_list.push_back(getStringUnlocked(string_id));
     }
   };
   if (multithreaded) {
@@ -1229,7 +1277,6 @@ std::vector<std::string> StringDictionary::copyStrings() const {
       workers.push_back(std::async(std::launch::async,
                                    copy,
                                    std::ref(worker_results[worker_idx]),
-                                   worker_idx,
                                    start,
                                    end));
     }
@@ -1238,16 +1285,14 @@ std::vector<std::string> StringDictionary::copyStrings() const {
     }
   } else {
     CHECK_EQ(worker_results.size(), size_t(1));
-    copy(worker_results[0], 0, 0, str_count_);
+    copy(worker_results[0], 0, str_count_);
   }
 
   for (const auto& worker_result : worker_results) {
-    strings_cache_->insert(
-        strings_cache_->end(), worker_result.begin(), worker_result.end());
+    strings->insert(strings->end(), worker_result.begin(), worker_result.end());
   }
-  strings_cache_size_ +=
-      std::accumulate(string_size.begin(), string_size.end(), size_t(0));
-  return *strings_cache_;
+  query_cache_.put(cache_key, CachedStrings(strings));
+  return *strings;
 }
 
 bool StringDictionary::fillRateIsHigh(const size_t num_strings) const noexcept {
@@ -1267,7 +1312,7 @@ void StringDictionary::increaseHashTableCapacity() noexcept {
     hash_cache_.resize(hash_cache_.size() * 2);
   } else {
     for (size_t i = 0; i != str_count_; ++i) {
-      const auto str = getStringChecked(i);
+      const auto str = getStringFromStorageFast(i);
       const string_dict_hash_t hash = hash_string(str);
       const uint32_t bucket = computeUniqueBucketWithHash(hash, new_str_ids);
       new_str_ids[bucket] = i;
@@ -1295,7 +1340,7 @@ void StringDictionary::increaseHashTableCapacityFromStorageAndMemory(
     hash_cache_.resize(hash_cache_.size() * 2);
   } else {
     for (size_t storage_idx = 0; storage_idx != storage_high_water_mark; ++storage_idx) {
-      const auto storage_string = getStringChecked(storage_idx);
+      const auto storage_string = getStringFromStorageFast(storage_idx);
       const string_dict_hash_t hash = hash_string(storage_string);
       const uint32_t bucket = computeUniqueBucketWithHash(hash, new_str_ids);
       new_str_ids[bucket] = storage_idx;
@@ -1310,12 +1355,18 @@ void StringDictionary::increaseHashTableCapacityFromStorageAndMemory(
   string_id_string_dict_hash_table_.swap(new_str_ids);
 }
 
-int32_t StringDictionary::getOrAddImpl(const std::string_view& str) noexcept {
+int32_t StringDictionary::getOrAddImpl(const std::string_view& raw_str) noexcept {
   // @TODO(wei) treat empty string as NULL for now
-  if (str.size() == 0) {
+  if (raw_str.size() == 0) {
     return inline_int_null_value<int32_t>();
   }
-  CHECK(str.size() <= MAX_STRLEN);
+  CHECK(raw_str.size() <= MAX_STRLEN);
+  std::string encoded_str;
+  const bool encode_payload = preparePayloadCompressor<std::string_view>(nullptr);
+  if (encode_payload) {
+    payload_compressor_->encode(raw_str, encoded_str);
+  }
+  const std::string_view str = encode_payload ? encoded_str : raw_str;
   const string_dict_hash_t hash = hash_string(str);
   {
     std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
@@ -1352,6 +1403,9 @@ int32_t StringDictionary::getOrAddImpl(const std::string_view& str) noexcept {
 std::string StringDictionary::getStringChecked(const int string_id) const noexcept {
   const auto str_canary = getStringFromStorage(string_id);
   CHECK(!str_canary.canary);
+  if (payload_compressor_) {
+    return payload_compressor_->decode({str_canary.c_str_ptr, str_canary.size});
+  }
   return std::string(str_canary.c_str_ptr, str_canary.size);
 }
 
@@ -1359,6 +1413,9 @@ std::string_view StringDictionary::getStringViewChecked(
     const int string_id) const noexcept {
   const auto str_canary = getStringFromStorage(string_id);
   CHECK(!str_canary.canary);
+  if (payload_compressor_) {
+    return getDecodedStringView(string_id);
+  }
   return std::string_view{str_canary.c_str_ptr, str_canary.size};
 }
 
@@ -1366,9 +1423,27 @@ std::pair<char*, size_t> StringDictionary::getStringBytesChecked(
     const int string_id) const noexcept {
   const auto str_canary = getStringFromStorage(string_id);
   CHECK(!str_canary.canary);
+  if (payload_compressor_) {
+    const auto decoded_str = getDecodedStringView(string_id);
+    return std::make_pair(const_cast<char*>(decoded_str.data()), decoded_str.size());
+  }
   return std::make_pair(str_canary.c_str_ptr, str_canary.size);
 }
 
+// Decodes into the caller's buffer rather than the decoded string storage, for hot loops
+// that only need each string transiently
+std::string_view StringDictionary::decodeStringFromStorage(
+    const int string_id,
+    std::string& decode_buffer) const noexcept {
+  const auto stored_str = getStringFromStorageFast(string_id);
+  if (!payload_compressor_) {
+    return stored_str;
+  }
+  decode_buffer.resize(payload_compressor_->decodedLength(stored_str));
+  payload_compressor_->decodeInto(stored_str, decode_buffer.data());
+  return decode_buffer;
+}
+
 template <class String>
 uint32_t StringDictionary::computeBucket(
     const string_dict_hash_t hash,
@@ -1516,6 +1591,9 @@ void StringDictionary::appendToStorage(const String str) noexcept {
   // write the offset and length
   StringIdxEntry str_meta{static_cast<uint64_t>(payload_file_off_), str.size()};
   payload_file_off_ += str.size();  // Need to increment after we've defined str_meta
+  if (payload_compressor_) {
+    raw_payload_bytes_ += payload_compressor_->decodedLength(str);
+  }
 
   checkAndConditionallyIncreaseOffsetCapacity(sizeof(str_meta));
   memcpy(offset_map_ + str_count_, &str_meta, sizeof(str_meta));
@@ -1539,6 +1617,9 @@ void StringDictionary::appendToStorageBulk(
     StringIdxEntry str_meta{static_cast<uint64_t>(payload_file_off_), str_size};
     payload_file_off_ += str_size;  // Need to increment after we've defined str_meta
     memcpy(offset_map_ + str_count_ + i, &str_meta, sizeof(str_meta));
+    if (payload_compressor_) {
+      raw_payload_bytes_ += payload_compressor_->decodedLength(str);
+    }
   }
 }
 
@@ -1624,23 +1705,8 @@ void* StringDictionary::addMemoryCapacity(void* addr,
 }
 
 void StringDictionary::invalidateInvertedIndex() noexcept {
-  if (!like_i32_cache_.empty()) {
-    decltype(like_i32_cache_)().swap(like_i32_cache_);
-  }
-  if (!like_i64_cache_.empty()) {
-    decltype(like_i64_cache_)().swap(like_i64_cache_);
-  }
-  if (!regex_cache_.empty()) {
-    decltype(regex_cache_)().swap(regex_cache_);
-  }
-  if (!equal_cache_.empty()) {
-    decltype(equal_cache_)().swap(equal_cache_);
-  }
+  query_cache_.clear();
   compare_cache_.invalidateInvertedIndex();
-
-  like_cache_size_ = 0;
-  regex_cache_size_ = 0;
-  equal_cache_size_ = 0;
   compare_cache_size_ = 0;
 }
 
@@ -1664,6 +1730,17 @@ bool StringDictionary::checkpoint() noexcept {
         (heavyai::msync((void*)payload_map_, payload_file_size_, /*async=*/false) == 0);
   ret = ret && (heavyai::fsync(offset_fd_) == 0);
   ret = ret && (heavyai::fsync(payload_fd_) == 0);
+  if (ret && payload_compressor_ && payload_compressor_->isTrained()) {
+    // Refresh the payload size counters stored alongside the symbol table
+    try {
+      std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
+      payload_compressor_->writeToFile(symbols_path_,
+                                       {raw_payload_bytes_, payload_file_off_});
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to checkpoint string dictionary symbol table: " << e.what();
+      ret = false;
+    }
+  }
   return ret;
 }
 
@@ -1688,22 +1765,28 @@ void StringDictionary::sortCache(std::vector<int32_t>& cache) {
   // this boost sort is creating some problems when we use UTF-8 encoded strings.
   // TODO (vraj): investigate What is wrong with boost sort and try to mitigate it.
 
-  std::sort(cache.begin(), cache.end(), [this](int32_t a, int32_t b) {
-    auto a_str = this->getStringFromStorage(a);
-    auto b_str = this->getStringFromStorage(b);
-    return string_lt(a_str.c_str_ptr, a_str.size, b_str.c_str_ptr, b_str.size);
-  });
+  std::string a_buffer;
+  std::string b_buffer;
+  std::sort(cache.begin(),
+            cache.end(),
+            [this, &a_buffer, &b_buffer](int32_t a, int32_t b) {
+              auto a_str = this->decodeStringFromStorage(a, a_buffer);
+              auto b_str = this->decodeStringFromStorage(b, b_buffer);
+              return string_lt(a_str.data(), a_str.size(), b_str.data(), b_str.size());
+            });
 }
 
 void StringDictionary::mergeSortedCache(std::vector<int32_t>& temp_sorted_cache) {
   // this method is not thread safe
   std::vector<int32_t> updated_cache(temp_sorted_cache.size() + sorted_cache.size());
   size_t t_idx = 0, s_idx = 0, idx = 0;
+  std::string t_buffer;
+  std::string s_buffer;
   for (; t_idx < temp_sorted_cache.size() && s_idx < sorted_cache.size(); idx++) {
-    auto t_string = getStringFromStorage(temp_sorted_cache[t_idx]);
-    auto s_string = getStringFromStorage(sorted_cache[s_idx]);
-    const auto insert_from_temp_cache =
-        string_lt(t_string.c_str_ptr, t_string.size, s_string.c_str_ptr, s_string.size);
+    auto t_string = decodeStringFromStorage(temp_sorted_cache[t_idx], t_buffer);
+    auto s_string = decodeStringFromStorage(sorted_cache[s_idx], s_buffer);
+    const auto insert_from_temp_cache = string_lt(
+        t_string.data(), t_string.size(), s_string.data(), s_string.size());
     if (insert_from_temp_cache) {
       updated_cache[idx] = temp_sorted_cache[t_idx++];
     } else {
@@ -1785,7 +1868,8 @@ void StringDictionary::populate_string_array_ids(
 }
 
 std::vector<std::string_view> StringDictionary::getStringViews(
-    const size_t generation) const {
+    const size_t generation,
+    std::string& decoded_payload) const {
   auto timer = DEBUG_TIMER(__func__);
   std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
   const int64_t num_strings = generation >= 0 ? generation : storageEntryCount();
@@ -1805,6 +1889,24 @@ std::vector<std::string_view> StringDictionary::getStringViews(
   if (num_strings == 0) {
     return string_views;
   }
+  if (payload_compressor_) {
+    // The views have to outlive this call, so the strings are decoded back to back
+    // into the caller's buffer, sized up front so that it is never reallocated
+    std::vector<size_t> string_offsets(num_strings + 1, 0);
+    for (int32_t string_idx = 0; string_idx < num_strings; ++string_idx) {
+      string_offsets[string_idx + 1] =
+          string_offsets[string_idx] +
+          payload_compressor_->decodedLength(getStringFromStorageFast(string_idx));
+    }
+    decoded_payload.resize(string_offsets[num_strings]);
+    for (int32_t string_idx = 0; string_idx < num_strings; ++string_idx) {
+      char* decoded_str = decoded_payload.data() + string_offsets[string_idx];
+      payload_compressor_->decodeInto(getStringFromStorageFast(string_idx), decoded_str);
+      string_views[string_idx] = std::string_view{
+          decoded_str, string_offsets[string_idx + 1] - string_offsets[string_idx]};
+    }
+    return string_views;
+  }
   constexpr int64_t tbb_parallel_threshold{1000};
   if (num_strings < tbb_parallel_threshold) {
     // Use int32_t to match type expected by getStringFromStorageFast
@@ -1837,8 +1939,9 @@ std::vector<std::string_view> StringDictionary::getStringViews(
   return string_views;
 }
 
-std::vector<std::string_view> StringDictionary::getStringViews() const {
-  return getStringViews(storageEntryCount());
+std::vector<std::string_view> StringDictionary::getStringViews(
+    std::string& decoded_payload) const {
+  return getStringViews(storageEntryCount(), decoded_payload);
 }
 
 std::vector<int32_t> StringDictionary::buildDictionaryTranslationMap(
@@ -1885,7 +1988,8 @@ size_t StringDictionary::buildDictionaryTranslationMap(
     const int64_t dest_generation,
     const bool dest_has_transients,
     StringLookupCallback const& dest_transient_lookup_callback,
-    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const {
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+    const DictionaryTranslationMap* persisted_translation_map) const {
   auto timer = DEBUG_TIMER(__func__);
   CHECK_GE(source_generation, 0L);
   CHECK_GE(dest_generation, 0L);
@@ -1906,6 +2010,19 @@ size_t StringDictionary::buildDictionaryTranslationMap(
         "Cannot translate between a local source and remote destination dictionary.");
   }
 
+  const StringOps_Namespace::StringOps string_ops(string_op_infos);
+  const bool has_string_ops = string_ops.size();
+
+  // A persisted map is always locked before the dictionaries, matching
+  // updateDictionaryTranslationMap
+  std::shared_lock<std::shared_mutex> persisted_map_read_lock;
+  if (persisted_translation_map) {
+    CHECK(persisted_translation_map->isTranslationBetween(
+        this, dest_dict, string_op_infos));
+    persisted_map_read_lock =
+        std::shared_lock<std::shared_mutex>(persisted_translation_map->mutex_);
+  }
+
   // Sort this/source dict and dest dict on folder_ so we can enforce
   // lock ordering and avoid deadlocks
   std::shared_lock<std::shared_mutex> source_read_lock(rw_mutex_, std::defer_lock);
@@ -1923,6 +2040,17 @@ size_t StringDictionary::buildDictionaryTranslationMap(
   CHECK_LE(num_dest_strings, static_cast<int64_t>(dest_dict->str_count_));
   const bool dest_dictionary_is_empty = (num_dest_strings == 0);
 
+  // The persisted map can stand in for probing the destination as long as it covers
+  // both generations. Ids past dest_generation are filtered below like probed ones.
+  const int32_t* persisted_translated_ids = nullptr;
+  if (persisted_map_read_lock.owns_lock() &&
+      persisted_translation_map->translated_ids_.size() >=
+          static_cast<size_t>(num_source_strings) &&
+      persisted_translation_map->num_dest_strings_ >=
+          static_cast<size_t>(num_dest_strings)) {
+    persisted_translated_ids = persisted_translation_map->translated_ids_.data();
+  }
+
   constexpr int64_t target_strings_per_thread{1000};
   const ThreadInfo thread_info(
       std::thread::hardware_concurrency(), num_source_strings, target_strings_per_thread);
@@ -1934,8 +2062,10 @@ size_t StringDictionary::buildDictionaryTranslationMap(
   // numbers of threads are needed than just letting tbb figure the number of threads,
   // but should benchmark in this specific context
 
-  const StringOps_Namespace::StringOps string_ops(string_op_infos);
-  const bool has_string_ops = string_ops.size();
+  // Hashes are taken over the stored bytes, so they only carry over between two
+  // dictionaries that both store strings uncompressed
+  const bool can_reuse_source_hashes =
+      materialize_hashes_ && !payload_compressor_ && !dest_dict->payload_compressor_;
 
   tbb::task_arena limited_arena(thread_info.num_threads);
   std::vector<size_t> num_strings_not_translated_per_thread(thread_info.num_threads, 0UL);
@@ -1974,28 +2104,58 @@ size_t StringDictionary::buildDictionaryTranslationMap(
             size_t num_strings_not_translated = 0;
             std::string string_ops_storage;  // Needs to be thread local to back
                                              // string_view returned by string_ops()
+            std::string decode_storage;
+            std::string dest_encode_storage;
             for (int32_t source_string_id = start_idx; source_string_id != end_idx;
                  ++source_string_id) {
+              if (persisted_translated_ids) {
+                const auto translated_string_id =
+                    persisted_translated_ids[source_string_id];
+                translated_ids[source_string_id] = translated_string_id;
+                if (translated_string_id != inline_int_null_value<int32_t>() &&
+                    (translated_string_id == StringDictionary::INVALID_STR_ID ||
+                     translated_string_id >= num_dest_strings)) {
+                  num_strings_not_translated +=
+                      dest_has_transients
+                          ? dest_transient_lookup_callback(
+                                has_string_ops
+                                    ? persisted_translation_map->getTransformedString(
+                                          source_string_id)
+                                    : decodeStringFromStorage(source_string_id,
+                                                              decode_storage),
+                                source_string_id)
+                          : 1;
+                }
+                continue;
+              }
               const std::string_view source_str =
-                  has_string_ops ? string_ops(getStringFromStorageFast(source_string_id),
-                                              string_ops_storage)
-                                 : getStringFromStorageFast(source_string_id);
+                  has_string_ops
+                      ? string_ops(decodeStringFromStorage(source_string_id,
+                                                           decode_storage),
+                                   string_ops_storage)
+                      : decodeStringFromStorage(source_string_id, decode_storage);
 
               if (source_str.empty()) {
                 translated_ids[source_string_id] = inline_int_null_value<int32_t>();
                 continue;
               }
+              // The destination is probed with its own stored form of the string
+              if (dest_dict->payload_compressor_) {
+                dest_dict->payload_compressor_->encode(source_str, dest_encode_storage);
+              }
+              const std::string_view dest_lookup_str =
+                  dest_dict->payload_compressor_ ? dest_encode_storage : source_str;
               // Get the hash from this/the source dictionary's cache, as the function
               // will be the same for the dest_dict, sparing us having to recompute it
 
               // Todo(todd): Remove option to turn string hash cache off or at least
               // make a constexpr to avoid these branches when we expect it to be always
               // on going forward
-              const string_dict_hash_t hash = (materialize_hashes_ && !has_string_ops)
+              const string_dict_hash_t hash = (can_reuse_source_hashes && !has_string_ops)
                                                   ? hash_cache_[source_string_id]
-                                                  : hash_string(source_str);
+                                                  : hash_string(dest_lookup_str);
               const uint32_t hash_bucket = dest_dict->computeBucket(
-                  hash, source_str, dest_dict->string_id_string_dict_hash_table_);
+                  hash, dest_lookup_str, dest_dict->string_id_string_dict_hash_table_);
               const auto translated_string_id =
                   dest_dict->string_id_string_dict_hash_table_[hash_bucket];
               translated_ids[source_string_id] = translated_string_id;
@@ -2025,6 +2185,197 @@ size_t StringDictionary::buildDictionaryTranslationMap(
   return total_num_strings_not_translated;
 }
 
+void StringDictionary::updateDictionaryTranslationMap(
+    const StringDictionary* dest_dict,
+    DictionaryTranslationMap& persisted_translation_map) const {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(!isClient() && !dest_dict->isClient());
+  CHECK(persisted_translation_map.isTranslationBetween(
+      this, dest_dict, persisted_translation_map.string_op_infos_));
+  std::unique_lock<std::shared_mutex> persisted_map_write_lock(
+      persisted_translation_map.mutex_);
+  std::shared_lock<std::shared_mutex> source_read_lock(rw_mutex_, std::defer_lock);
+  std::shared_lock<std::shared_mutex> dest_read_lock(dest_dict->rw_mutex_,
+                                                     std::defer_lock);
+  order_translation_locks(
+      getDictKey(), dest_dict->getDictKey(), source_read_lock, dest_read_lock);
+
+  auto& translated_ids = persisted_translation_map.translated_ids_;
+  auto& transformed_offsets = persisted_translation_map.transformed_offsets_;
+  const bool has_string_ops = !persisted_translation_map.string_op_infos_.empty();
+  const size_t num_source_strings = str_count_;
+  const size_t num_dest_strings = dest_dict->str_count_;
+  if (translated_ids.size() > num_source_strings ||
+      persisted_translation_map.num_dest_strings_ > num_dest_strings) {
+    // One of the dictionaries was rolled back past the map, start over
+    translated_ids.clear();
+    persisted_translation_map.transformed_payload_.clear();
+    transformed_offsets.assign(has_string_ops ? 1 : 0, 0);
+    persisted_translation_map.num_dest_strings_ = 0;
+  }
+  const size_t num_mapped_source_strings = translated_ids.size();
+  const size_t num_mapped_dest_strings = persisted_translation_map.num_dest_strings_;
+
+  // Already mapped source strings can only have gained a match among the strings added to
+  // the destination since
+  if (num_mapped_source_strings > 0 && num_dest_strings > num_mapped_dest_strings) {
+    if (has_string_ops) {
+      // Several source strings can transform to the same string, so there is no reverse
+      // lookup; re-probe the misses with their transformed strings instead
+      tbb::parallel_for(
+          tbb::blocked_range<size_t>(0, num_mapped_source_strings),
+          [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t source_string_id = r.begin(); source_string_id != r.end();
+                 ++source_string_id) {
+              if (translated_ids[source_string_id] == INVALID_STR_ID) {
+                translated_ids[source_string_id] = dest_dict->getUnlocked(
+                    persisted_translation_map.getTransformedString(source_string_id));
+              }
+            }
+          });
+    } else {
+      tbb::parallel_for(
+          tbb::blocked_range<size_t>(num_mapped_dest_strings, num_dest_strings),
+          [&](const tbb::blocked_range<size_t>& r) {
+            std::string decode_storage;
+            for (size_t dest_string_id = r.begin(); dest_string_id != r.end();
+                 ++dest_string_id) {
+              const auto source_string_id = getUnlocked(
+                  dest_dict->decodeStringFromStorage(dest_string_id, decode_storage));
+              if (source_string_id != INVALID_STR_ID &&
+                  static_cast<size_t>(source_string_id) < num_mapped_source_strings) {
+                translated_ids[source_string_id] = dest_string_id;
+              }
+            }
+          });
+    }
+  }
+
+  if (num_source_strings > num_mapped_source_strings) {
+    if (has_string_ops) {
+      appendTransformedStrings(num_mapped_source_strings,
+                               num_source_strings,
+                               persisted_translation_map);
+    }
+    translated_ids.resize(num_source_strings);
+    const bool can_reuse_source_hashes = !has_string_ops && materialize_hashes_ &&
+                                         !payload_compressor_ &&
+                                         !dest_dict->payload_compressor_;
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(num_mapped_source_strings, num_source_strings),
+        [&](const tbb::blocked_range<size_t>& r) {
+          std::string decode_storage;
+          std::string dest_encode_storage;
+          for (size_t source_string_id = r.begin(); source_string_id != r.end();
+               ++source_string_id) {
+            const auto source_str =
+                has_string_ops
+                    ? persisted_translation_map.getTransformedString(source_string_id)
+                    : decodeStringFromStorage(source_string_id, decode_storage);
+            if (source_str.empty()) {
+              translated_ids[source_string_id] = inline_int_null_value<int32_t>();
+              continue;
+            }
+            if (dest_dict->payload_compressor_) {
+              dest_dict->payload_compressor_->encode(source_str, dest_encode_storage);
+            }
+            const std::string_view dest_lookup_str =
+                dest_dict->payload_compressor_ ? dest_encode_storage : source_str;
+            const string_dict_hash_t hash = can_reuse_source_hashes
+                                                ? hash_cache_[source_string_id]
+                                                : hash_string(dest_lookup_str);
+            translated_ids[source_string_id] =
+                dest_dict->string_id_string_dict_hash_table_[dest_dict->computeBucket(
+                    hash, dest_lookup_str, dest_dict->string_id_string_dict_hash_table_)];
+          }
+        });
+  }
+  persisted_translation_map.num_dest_strings_ = num_dest_strings;
+}
+
+void StringDictionary::appendTransformedStrings(
+    const size_t start_string_id,
+    const size_t end_string_id,
+    DictionaryTranslationMap& persisted_translation_map) const {
+  const StringOps_Namespace::StringOps string_ops(
+      persisted_translation_map.string_op_infos_);
+  auto& transformed_payload = persisted_translation_map.transformed_payload_;
+  auto& transformed_offsets = persisted_translation_map.transformed_offsets_;
+  CHECK_EQ(transformed_offsets.size(), start_string_id + 1);
+  // Transform in batches so the intermediate strings stay bounded for large dictionaries
+  constexpr size_t batch_size{1UL << 20};
+  std::vector<std::string> transformed_strings;
+  for (size_t batch_start = start_string_id; batch_start < end_string_id;
+       batch_start += batch_size) {
+    const size_t batch_end = std::min(batch_start + batch_size, end_string_id);
+    transformed_strings.resize(batch_end - batch_start);
+    tbb::parallel_for(tbb::blocked_range<size_t>(batch_start, batch_end),
+                      [&](const tbb::blocked_range<size_t>& r) {
+                        std::string decode_storage;
+                        for (size_t string_id = r.begin(); string_id != r.end();
+                             ++string_id) {
+                          std::string& transformed_str =
+                              transformed_strings[string_id - batch_start];
+                          const auto transformed_sv = string_ops(
+                              decodeStringFromStorage(string_id, decode_storage),
+                              transformed_str);
+                          if (transformed_sv.empty()) {
+                            transformed_str.clear();
+                          }
+                        }
+                      });
+    for (const auto& transformed_str : transformed_strings) {
+      transformed_payload.insert(
+          transformed_payload.end(), transformed_str.begin(), transformed_str.end());
+      transformed_offsets.push_back(transformed_payload.size());
+    }
+  }
+}
+
+DictionaryTranslationMap::DictionaryTranslationMap(
+    std::shared_ptr<const StringDictionary> source_dict,
+    std::shared_ptr<const StringDictionary> dest_dict,
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos)
+    : source_dict_(source_dict)
+    , dest_dict_(dest_dict)
+    , string_op_infos_(string_op_infos)
+    , string_ops_key_(getStringOpsKey(string_op_infos))
+    , transformed_offsets_(string_op_infos.empty() ? 0 : 1, 0) {}
+
+bool DictionaryTranslationMap::isTranslationBetween(
+    const StringDictionary* source_dict,
+    const StringDictionary* dest_dict,
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const {
+  return source_dict_.lock().get() == source_dict &&
+         dest_dict_.lock().get() == dest_dict &&
+         string_ops_key_ == getStringOpsKey(string_op_infos);
+}
+
+size_t DictionaryTranslationMap::getSizeInBytes() const {
+  std::shared_lock<std::shared_mutex> read_lock(mutex_);
+  return sizeof(*this) + translated_ids_.capacity() * sizeof(int32_t) +
+         transformed_payload_.capacity() +
+         transformed_offsets_.capacity() * sizeof(size_t);
+}
+
+std::string DictionaryTranslationMap::getStringOpsKey(
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) {
+  if (string_op_infos.empty()) {
+    return {};
+  }
+  std::ostringstream oss;
+  oss << string_op_infos;
+  return oss.str();
+}
+
+std::string_view DictionaryTranslationMap::getTransformedString(
+    const size_t source_string_id) const {
+  CHECK_LT(source_string_id + 1, transformed_offsets_.size());
+  const auto start_offset = transformed_offsets_[source_string_id];
+  return std::string_view(transformed_payload_.data() + start_offset,
+                          transformed_offsets_[source_string_id + 1] - start_offset);
+}
+
 void StringDictionary::buildDictionaryNumericTranslationMap(
     Datum* translated_ids,
     const int64_t source_generation,
@@ -2082,10 +2433,11 @@ void StringDictionary::buildDictionaryNumericTranslationMap(
         [&](const tbb::blocked_range<int32_t>& r) {
           const int32_t start_idx = r.begin();
           const int32_t end_idx = r.end();
+          std::string decode_storage;
           for (int32_t source_string_id = start_idx; source_string_id != end_idx;
                ++source_string_id) {
             const std::string source_str =
-                std::string(getStringFromStorageFast(source_string_id));
+                std::string(decodeStringFromStorage(source_string_id, decode_storage));
             translated_ids[source_string_id] = string_ops.numericEval(source_str);
           }
         });
@@ -2112,6 +2464,135 @@ size_t StringDictionary::computeCacheSize() const {
   std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
   return string_id_string_dict_hash_table_.size() * sizeof(int32_t) +
          hash_cache_.size() * sizeof(string_dict_hash_t) +
-         sorted_cache.size() * sizeof(int32_t) + like_cache_size_ + regex_cache_size_ +
-         equal_cache_size_ + compare_cache_size_ + strings_cache_size_;
+         sorted_cache.size() * sizeof(int32_t) + query_cache_.getSizeInBytes() +
+         compare_cache_size_ + decoded_strings_size_;
+}
+
+DictionaryQueryCache::Stats StringDictionary::getQueryCacheStats() const {
+  return query_cache_.getStats();
+}
+
+bool StringDictionary::isPayloadCompressed() const noexcept {
+  return payload_compressed_.load(std::memory_order_acquire);
+}
+
+std::optional<StringPayloadCompressor::Stats>
+StringDictionary::getPayloadCompressionStats() const {
+  std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
+  if (!payload_compressor_) {
+    return std::nullopt;
+  }
+  return StringPayloadCompressor::Stats{raw_payload_bytes_, payload_file_off_};
+}
+
+/**
+ * Payload compression is decided when a dictionary is created: an existing symbol table
+ * is always honored, since the stored payload cannot be read without it, while new
+ * dictionaries opt in via g_enable_stringdict_compression. Existing dictionaries without
+ * a symbol table keep their uncompressed payload. The table itself is trained on the
+ * first strings added, see preparePayloadCompressor.
+ */
+void StringDictionary::initPayloadCompressor(const bool payload_is_empty) {
+  CHECK(!isTemp_);
+  const bool has_symbols = boost::filesystem::exists(symbols_path_);
+  if (has_symbols && !payload_is_empty) {
+    StringPayloadCompressor::Stats stats;
+    payload_compressor_ = StringPayloadCompressor::readFromFile(symbols_path_, stats);
+    if (!payload_compressor_) {
+      auto err = "Dictionary symbol table " + symbols_path_ + " is corrupt.";
+      LOG(ERROR) << err;
+      throw DictPayloadUnavailable(err);
+    }
+    raw_payload_bytes_ = stats.raw_payload_bytes;
+    payload_compressed_ = true;
+    return;
+  }
+  if (has_symbols) {
+    // The payload was truncated or never written, so the old table no longer applies
+    boost::filesystem::remove(symbols_path_);
+  }
+  if (g_enable_stringdict_compression && payload_is_empty) {
+    payload_compressor_ = std::make_unique<StringPayloadCompressor>();
+    payload_compressed_ = true;
+  }
+}
+
+/**
+ * Returns whether the strings being added are stored encoded. The symbol table of a new
+ * compressed dictionary is trained on the first batch of strings added to it. A single
+ * string is no sample to train on, so a dictionary whose first string is added on its
+ * own (input_strings is null) keeps an uncompressed payload instead.
+ */
+template <class String>
+bool StringDictionary::preparePayloadCompressor(
+    const std::vector<String>* input_strings) {
+  {
+    std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
+    if (!payload_compressor_ || payload_compressor_->isTrained()) {
+      return static_cast<bool>(payload_compressor_);
+    }
+  }
+  std::lock_guard<std::shared_mutex> write_lock(rw_mutex_);
+  if (!payload_compressor_ || payload_compressor_->isTrained()) {
+    return static_cast<bool>(payload_compressor_);
+  }
+  CHECK_EQ(str_count_, size_t(0));
+  if (!input_strings) {
+    payload_compressor_.reset();
+    payload_compressed_ = false;
+    return false;
+  }
+  if (input_strings->empty()) {
+    // nothing gets stored, so leave training to the next batch
+    return true;
+  }
+  payload_compressor_->train(*input_strings);
+  try {
+    // Persist the table before any string encoded with it reaches the payload
+    payload_compressor_->writeToFile(symbols_path_, {0, 0});
+  } catch (...) {
+    payload_compressor_->reset();
+    throw;
+  }
+  return true;
+}
+
+template <class String>
+std::vector<std::string> StringDictionary::encodePayloadStrings(
+    const std::vector<String>& input_strings) const {
+  CHECK(payload_compressor_);
+  std::vector<std::string> encoded_strings(input_strings.size());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, input_strings.size()),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                      for (size_t i = r.begin(); i != r.end(); ++i) {
+                        const auto& input_string = input_strings[i];
+                        if (input_string.size() > MAX_STRLEN) {
+                          throw_string_too_long_error(input_string, dict_key_);
+                        }
+                        payload_compressor_->encode(
+                            {input_string.data(), input_string.size()},
+                            encoded_strings[i]);
+                      }
+                    });
+  return encoded_strings;
+}
+
+// Decodes a single string into storage that lives as long as the dictionary, for the
+// accessors that hand out views or raw pointers
+std::string_view StringDictionary::getDecodedStringView(
+    const int string_id) const noexcept {
+  CHECK_GE(string_id, 0);
+  std::lock_guard<std::mutex> decoded_lock(decoded_strings_mutex_);
+  auto [it, inserted] = decoded_strings_.try_emplace(string_id);
+  if (inserted) {
+    decodeStringFromStorage(string_id, it->second);
+    decoded_strings_size_ +=
+        it->second.capacity() + sizeof(decltype(decoded_strings_)::value_type);
+  }
+  return it->second;
+}
+
+size_t StringDictionary::maxStoredStringLength() const noexcept {
+  return payload_compressor_ ? MAX_STRLEN * StringPayloadCompressor::kMaxExpansionFactor
+                             : MAX_STRLEN;
 }
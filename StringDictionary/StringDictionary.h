@@ -16,22 +16,32 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <future>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "DictRef.h"
 #include "DictionaryCache.hpp"
+#include "DictionaryQueryCache.h"
 #include "Shared/DbObjectKeys.h"
 #include "StringOps/StringOpInfo.h"
+#include "StringPayloadCompressor.h"
 
 extern bool g_enable_stringdict_parallel;
+extern bool g_enable_stringdict_compression;
+extern size_t g_stringdict_query_cache_size;
 
+class DictionaryTranslationMap;
 class StringDictionaryClient;
 
 namespace StringOps_Namespace {
@@ -87,8 +97,6 @@ class StringDictionary {
                  const int64_t generation) const;
   template <class T, class String>
   void getOrAddBulk(const std::vector<String>& string_vec, T* encoded_vec);
-  template <class T, class String>
-  void getOrAddBulkParallel(const std::vector<String>& string_vec, T* encoded_vec);
   template <class String>
   void getOrAddBulkArray(const std::vector<std::vector<String>>& string_array_vec,
                          std::vector<std::vector<int32_t>>& ids_array_vec);
@@ -123,8 +131,10 @@ class StringDictionary {
 
   std::vector<std::string> copyStrings() const;
 
-  std::vector<std::string_view> getStringViews() const;
-  std::vector<std::string_view> getStringViews(const size_t generation) const;
+  // The views of a compressed payload point into decoded_payload, owned by the caller
+  std::vector<std::string_view> getStringViews(std::string& decoded_payload) const;
+  std::vector<std::string_view> getStringViews(const size_t generation,
+                                               std::string& decoded_payload) const;
 
   std::vector<int32_t> buildDictionaryTranslationMap(
       const std::shared_ptr<StringDictionary> dest_dict,
@@ -137,7 +147,14 @@ class StringDictionary {
       const int64_t dest_generation,
       const bool dest_has_transients,
       StringLookupCallback const& dest_transient_lookup_callback,
-      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const;
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+      const DictionaryTranslationMap* persisted_translation_map = nullptr) const;
+
+  // Brings persisted_translation_map up to date with the current contents of this
+  // dictionary and dest_dict, only translating strings added since its last update
+  void updateDictionaryTranslationMap(
+      const StringDictionary* dest_dict,
+      DictionaryTranslationMap& persisted_translation_map) const;
 
   void buildDictionaryNumericTranslationMap(
       Datum* translated_ids,
@@ -184,6 +201,10 @@ class StringDictionary {
 
   void update_leaf(const LeafHostInfo& host_info);
   size_t computeCacheSize() const;
+  DictionaryQueryCache::Stats getQueryCacheStats() const;
+
+  bool isPayloadCompressed() const noexcept;
+  std::optional<StringPayloadCompressor::Stats> getPayloadCompressionStats() const;
 
  private:
   struct StringIdxEntry {
@@ -206,6 +227,10 @@ class StringDictionary {
     bool canary;
   };
 
+  void appendTransformedStrings(
+      const size_t start_string_id,
+      const size_t end_string_id,
+      DictionaryTranslationMap& persisted_translation_map) const;
   void processDictionaryFutures(
       std::vector<std::future<std::vector<std::pair<string_dict_hash_t, unsigned int>>>>&
           dictionary_futures);
@@ -220,6 +245,14 @@ class StringDictionary {
       const std::vector<size_t>& string_memory_ids,
       const std::vector<string_dict_hash_t>& input_strings_hashes) noexcept;
   int32_t getOrAddImpl(const std::string_view& str) noexcept;
+  template <class T, class String>
+  void getOrAddBulkStored(const std::vector<String>& string_vec, T* encoded_vec);
+  template <class T, class String>
+  void getOrAddBulkParallel(const std::vector<String>& string_vec, T* encoded_vec);
+  template <class T, class String>
+  size_t getBulkUnlocked(const std::vector<String>& string_vec,
+                         T* encoded_vec,
+                         const int64_t generation) const;
   template <class String>
   void hashStrings(const std::vector<String>& string_vec,
                    std::vector<string_dict_hash_t>& hashes) const noexcept;
@@ -230,6 +263,16 @@ class StringDictionary {
   std::string getStringChecked(const int string_id) const noexcept;
   std::string_view getStringViewChecked(const int string_id) const noexcept;
   std::pair<char*, size_t> getStringBytesChecked(const int string_id) const noexcept;
+  std::string_view decodeStringFromStorage(const int string_id,
+                                           std::string& decode_buffer) const noexcept;
+  void initPayloadCompressor(const bool payload_is_empty);
+  template <class String>
+  bool preparePayloadCompressor(const std::vector<String>* input_strings);
+  template <class String>
+  std::vector<std::string> encodePayloadStrings(
+      const std::vector<String>& input_strings) const;
+  std::string_view getDecodedStringView(const int string_id) const noexcept;
+  size_t maxStoredStringLength() const noexcept;
   template <class String>
   uint32_t computeBucket(
       const string_dict_hash_t hash,
@@ -291,26 +334,78 @@ class StringDictionary {
   size_t payload_file_size_;
   size_t payload_file_off_;
   mutable std::shared_mutex rw_mutex_;
-  mutable std::map<std::tuple<std::string, bool, bool, char>, std::vector<int32_t>>
-      like_i32_cache_;
-  mutable std::map<std::tuple<std::string, bool, bool, char>, std::vector<int64_t>>
-      like_i64_cache_;
-  mutable size_t like_cache_size_;
-  mutable std::map<std::pair<std::string, char>, std::vector<int32_t>> regex_cache_;
-  mutable size_t regex_cache_size_;
-  mutable std::map<std::string, int32_t> equal_cache_;
-  mutable size_t equal_cache_size_;
+  // LIKE, REGEXP and equality results and full string copies, bounded together with
+  // the caches of the other dictionaries by g_stringdict_query_cache_size
+  mutable DictionaryQueryCache query_cache_;
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable size_t compare_cache_size_;
-  mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
-  mutable size_t strings_cache_size_;
   mutable std::unique_ptr<StringDictionaryClient> client_;
   mutable std::unique_ptr<StringDictionaryClient> client_no_timeout_;
 
+  // Set when the payload is stored compressed with a static symbol table. Strings are
+  // encoded on the way in, so hashing, bucket probing and equality all operate on the
+  // stored bytes; only the accessors that hand strings back out decode them.
+  std::unique_ptr<StringPayloadCompressor> payload_compressor_;
+  // Whether payload_compressor_ is set, read without rw_mutex_ by per-row accessors
+  std::atomic<bool> payload_compressed_{false};
+  std::string symbols_path_;
+  uint64_t raw_payload_bytes_{0};
+  // Decoded copies backing the string_views and raw pointers handed out by
+  // getStringView/getStringBytes for compressed payloads, only for the strings asked
+  // for. Queries decode through StringDictionaryProxy instead, and getStringViews and
+  // internal scans decode into buffers of their own, so this does not grow with the
+  // dictionary.
+  mutable std::mutex decoded_strings_mutex_;
+  mutable std::unordered_map<int32_t, std::string> decoded_strings_;
+  mutable size_t decoded_strings_size_{0};
+
   char* CANARY_BUFFER{nullptr};
   size_t canary_buffer_size = 0;
 };
 
+// Translation of the strings of one persisted dictionary to their ids in another, kept
+// across queries. Dictionaries only ever append strings, so an id resolved once stays
+// valid and the map can be extended as either dictionary grows instead of rebuilt. With
+// string ops the map also keeps every source string after the ops, so those are only
+// ever computed once per string. The dictionaries are held weakly so a map outliving a
+// dropped or recreated dictionary is never mistaken for a translation of its
+// replacement.
+class DictionaryTranslationMap {
+ public:
+  DictionaryTranslationMap(
+      std::shared_ptr<const StringDictionary> source_dict,
+      std::shared_ptr<const StringDictionary> dest_dict,
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos = {});
+
+  bool isTranslationBetween(
+      const StringDictionary* source_dict,
+      const StringDictionary* dest_dict,
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos = {}) const;
+  size_t getSizeInBytes() const;
+
+  static std::string getStringOpsKey(
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos);
+
+ private:
+  friend class StringDictionary;
+
+  std::string_view getTransformedString(const size_t source_string_id) const;
+
+  const std::weak_ptr<const StringDictionary> source_dict_;
+  const std::weak_ptr<const StringDictionary> dest_dict_;
+  const std::vector<StringOps_Namespace::StringOpInfo> string_op_infos_;
+  const std::string string_ops_key_;
+  mutable std::shared_mutex mutex_;
+  // Indexed by source string id, INVALID_STR_ID if the string is not in the destination
+  std::vector<int32_t> translated_ids_;
+  // Source strings with the string ops applied, empty for null results. Only kept when
+  // there are string ops.
+  std::vector<char> transformed_payload_;
+  std::vector<size_t> transformed_offsets_;
+  // Number of destination strings the map has been resolved against
+  size_t num_dest_strings_{0};
+};
+
 int32_t truncate_to_generation(const int32_t id, const size_t generation);
 
 void translate_string_ids(std::vector<int32_t>& dest_ids,
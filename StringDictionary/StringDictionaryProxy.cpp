@@ -264,7 +264,8 @@ StringDictionaryProxy::buildNumericTranslationMap(
 StringDictionaryProxy::IdMap
 StringDictionaryProxy::buildIntersectionTranslationMapToOtherProxyUnlocked(
     const StringDictionaryProxy* dest_proxy,
-    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const {
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+    const DictionaryTranslationMap* persisted_translation_map) const {
   auto timer = DEBUG_TIMER(__func__);
   IdMap id_map = initIdMap();
 
@@ -328,7 +329,8 @@ StringDictionaryProxy::buildIntersectionTranslationMapToOtherProxyUnlocked(
                             dest_proxy->generation_,
                             num_dest_transients > 0UL,
                             dest_transient_lookup_callback,
-                            string_op_infos)
+                            string_op_infos,
+                            persisted_translation_map)
                       : 0UL;
 
   const size_t num_dest_entries = dest_proxy->entryCountUnlocked();
@@ -381,7 +383,8 @@ void order_translation_locks(const shared::StringDictKey& source_dict_key,
 StringDictionaryProxy::IdMap
 StringDictionaryProxy::buildIntersectionTranslationMapToOtherProxy(
     const StringDictionaryProxy* dest_proxy,
-    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const {
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+    const DictionaryTranslationMap* persisted_translation_map) const {
   const auto& source_dict_id = getDictKey();
   const auto& dest_dict_id = dest_proxy->getDictKey();
 
@@ -390,12 +393,14 @@ StringDictionaryProxy::buildIntersectionTranslationMapToOtherProxy(
                                                             std::defer_lock);
   order_translation_locks(
       source_dict_id, dest_dict_id, source_proxy_read_lock, dest_proxy_write_lock);
-  return buildIntersectionTranslationMapToOtherProxyUnlocked(dest_proxy, string_op_infos);
+  return buildIntersectionTranslationMapToOtherProxyUnlocked(
+      dest_proxy, string_op_infos, persisted_translation_map);
 }
 
 StringDictionaryProxy::IdMap StringDictionaryProxy::buildUnionTranslationMapToOtherProxy(
     StringDictionaryProxy* dest_proxy,
-    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const {
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+    const DictionaryTranslationMap* persisted_translation_map) const {
   auto timer = DEBUG_TIMER(__func__);
 
   const auto& source_dict_id = getDictKey();
@@ -406,8 +411,8 @@ StringDictionaryProxy::IdMap StringDictionaryProxy::buildUnionTranslationMapToOt
   order_translation_locks(
       source_dict_id, dest_dict_id, source_proxy_read_lock, dest_proxy_write_lock);
 
-  auto id_map =
-      buildIntersectionTranslationMapToOtherProxyUnlocked(dest_proxy, string_op_infos);
+  auto id_map = buildIntersectionTranslationMapToOtherProxyUnlocked(
+      dest_proxy, string_op_infos, persisted_translation_map);
   if (id_map.empty()) {
     return id_map;
   }
@@ -562,7 +567,17 @@ int32_t StringDictionaryProxy::getOrAdd(const std::string& str) noexcept {
 std::pair<const char*, size_t> StringDictionaryProxy::getStringBytes(
     int32_t string_id) const noexcept {
   if (string_id >= 0) {
-    return string_dict_.get()->getStringBytes(string_id);
+    if (!string_dict_->isPayloadCompressed()) {
+      return string_dict_.get()->getStringBytes(string_id);
+    }
+    // Decode into storage owned by the proxy, so the decoded strings are released
+    // along with the query rather than kept by the dictionary
+    std::lock_guard<std::mutex> decoded_lock(decoded_strings_mutex_);
+    auto [it, inserted] = decoded_strings_.try_emplace(string_id);
+    if (inserted) {
+      it->second = string_dict_->getString(string_id);
+    }
+    return {it->second.c_str(), it->second.size()};
   }
   unsigned const string_index = transientIdToIndex(string_id);
   std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
@@ -799,6 +814,11 @@ StringDictionary* StringDictionaryProxy::getDictionary() const noexcept {
   return string_dict_.get();
 }
 
+std::shared_ptr<StringDictionary> StringDictionaryProxy::getDictionarySharedPtr()
+    const noexcept {
+  return string_dict_;
+}
+
 int64_t StringDictionaryProxy::getGeneration() const noexcept {
   return generation_;
 }
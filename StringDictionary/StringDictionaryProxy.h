@@ -23,12 +23,14 @@
 
 #include "ThirdParty/robin_hood/robin_hood.h"
 
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <shared_mutex>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace StringOps_Namespace {
@@ -51,6 +53,7 @@ class StringDictionaryProxy {
 
   int32_t getOrAdd(const std::string& str) noexcept;
   StringDictionary* getDictionary() const noexcept;
+  std::shared_ptr<StringDictionary> getDictionarySharedPtr() const noexcept;
   int64_t getGeneration() const noexcept;
 
   /**
@@ -168,13 +171,17 @@ class StringDictionaryProxy {
   TranslationMap<Datum> buildNumericTranslationMap(
       const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const;
 
+  // persisted_translation_map, if given, must translate between the two underlying
+  // dictionaries and is used in place of probing the destination dictionary
   IdMap buildIntersectionTranslationMapToOtherProxy(
       const StringDictionaryProxy* dest_proxy,
-      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const;
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+      const DictionaryTranslationMap* persisted_translation_map = nullptr) const;
 
   IdMap buildUnionTranslationMapToOtherProxy(
       StringDictionaryProxy* dest_proxy,
-      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_types) const;
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_types,
+      const DictionaryTranslationMap* persisted_translation_map = nullptr) const;
 
   /**
    * @brief Returns the number of string entries in the underlying string dictionary,
@@ -290,7 +297,8 @@ class StringDictionaryProxy {
 
   IdMap buildIntersectionTranslationMapToOtherProxyUnlocked(
       const StringDictionaryProxy* dest_proxy,
-      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos) const;
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+      const DictionaryTranslationMap* persisted_translation_map) const;
 
   std::shared_ptr<StringDictionary> string_dict_;
   const shared::StringDictKey string_dict_key_;
@@ -299,6 +307,10 @@ class StringDictionaryProxy {
   std::vector<std::string const*> transient_string_vec_;
   int64_t generation_;
   mutable std::shared_mutex rw_mutex_;
+  // Decoded copies of the strings of a compressed dictionary handed out by
+  // getStringBytes
+  mutable std::mutex decoded_strings_mutex_;
+  mutable std::unordered_map<int32_t, std::string> decoded_strings_;
 
   // Return INVALID_STR_ID if not found on string_dict_. Don't lock or check transients.
   template <typename String>
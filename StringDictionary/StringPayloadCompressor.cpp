@@ -0,0 +1,339 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringDictionary/StringPayloadCompressor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+#include "Logger/Logger.h"
+
+namespace {
+
+constexpr size_t kMaxTrainingStrings{16384};
+constexpr size_t kMaxTrainingBytes{1 << 18};
+constexpr size_t kTrainingGenerations{5};
+
+constexpr uint32_t kSymbolsFileMagic{0x54535346};  // "FSST"
+constexpr uint32_t kSymbolsFileVersion{1};
+
+// Bytes saved by replacing `count` occurrences of `token` with a single code
+size_t compute_gain(const std::string_view token, const size_t count) {
+  if (token.size() == 1) {
+    // ASCII bytes are already free literals, non-ASCII bytes save their escape
+    return static_cast<uint8_t>(token[0]) < StringPayloadCompressor::kFirstSymbolCode
+               ? 0
+               : count;
+  }
+  return count * (token.size() - 1);
+}
+
+template <typename T>
+void write_pod(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_pod(std::istream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return static_cast<bool>(in);
+}
+
+bool read_header(std::istream& in, StringPayloadCompressor::Stats& stats) {
+  uint32_t magic{0}, version{0};
+  if (!read_pod(in, magic) || magic != kSymbolsFileMagic) {
+    return false;
+  }
+  if (!read_pod(in, version) || version != kSymbolsFileVersion) {
+    return false;
+  }
+  return read_pod(in, stats.raw_payload_bytes) &&
+         read_pod(in, stats.encoded_payload_bytes);
+}
+
+}  // namespace
+
+StringPayloadCompressor::StringPayloadCompressor() : is_trained_(false) {
+  buildLookupTables();
+}
+
+/**
+ * Builds the symbol table from a sample of the given strings, following the FSST
+ * training loop: each generation encodes the sample with the current table, counts how
+ * often every emitted token and every pair of adjacent tokens occur, and keeps the
+ * candidates that would save the most bytes.
+ */
+template <class String>
+void StringPayloadCompressor::train(const std::vector<String>& sample_strings) {
+  CHECK(!is_trained_);
+  std::vector<std::string_view> sample;
+  size_t sample_bytes{0};
+  // Stride through the input so the sample is not biased towards its head
+  const size_t stride =
+      std::max(sample_strings.size() / kMaxTrainingStrings, static_cast<size_t>(1));
+  for (size_t i = 0; i < sample_strings.size() && sample_bytes < kMaxTrainingBytes;
+       i += stride) {
+    const std::string_view str(sample_strings[i].data(), sample_strings[i].size());
+    if (!str.empty()) {
+      sample.emplace_back(str);
+      sample_bytes += str.size();
+    }
+  }
+
+  std::string encoded;
+  for (size_t generation = 0; generation < kTrainingGenerations; ++generation) {
+    std::unordered_map<std::string, size_t> token_counts;
+    std::unordered_map<std::string, size_t> pair_counts;
+    for (const auto& str : sample) {
+      encode(str, encoded);
+      std::string_view prev_token;
+      size_t raw_pos{0};
+      for (size_t i = 0; i < encoded.size(); ++i) {
+        const uint8_t code = encoded[i];
+        size_t token_length{1};
+        if (code >= kFirstSymbolCode && code != kEscapeCode) {
+          token_length = code_lengths_[code];
+        } else if (code == kEscapeCode) {
+          ++i;
+        }
+        const std::string_view token = str.substr(raw_pos, token_length);
+        ++token_counts[std::string(token)];
+        if (!prev_token.empty()) {
+          const size_t pair_length =
+              std::min(prev_token.size() + token.size(), kMaxSymbolLength);
+          ++pair_counts[std::string(
+              str.substr(raw_pos - prev_token.size(), pair_length))];
+        }
+        prev_token = token;
+        raw_pos += token_length;
+      }
+    }
+
+    std::vector<std::pair<size_t, std::string>> candidates;
+    for (auto& [token, count] : token_counts) {
+      pair_counts[token] += count;
+    }
+    for (const auto& [token, count] : pair_counts) {
+      const size_t gain = compute_gain(token, count);
+      if (gain > 0) {
+        candidates.emplace_back(gain, token);
+      }
+    }
+    const size_t num_symbols = std::min(candidates.size(), kMaxSymbolCount);
+    // Break ties on the token itself so training is deterministic
+    std::partial_sort(candidates.begin(),
+                      candidates.begin() + num_symbols,
+                      candidates.end(),
+                      [](const auto& lhs, const auto& rhs) {
+                        return lhs.first != rhs.first ? lhs.first > rhs.first
+                                                      : lhs.second < rhs.second;
+                      });
+    std::vector<std::string> symbol_strings;
+    symbol_strings.reserve(num_symbols);
+    for (size_t i = 0; i < num_symbols; ++i) {
+      symbol_strings.emplace_back(std::move(candidates[i].second));
+    }
+    setSymbols(symbol_strings);
+  }
+  is_trained_ = true;
+  VLOG(1) << "Trained string payload symbol table with " << symbols_.size()
+          << " symbols on " << sample.size() << " strings (" << sample_bytes
+          << " bytes)";
+}
+
+template void StringPayloadCompressor::train(const std::vector<std::string>&);
+template void StringPayloadCompressor::train(const std::vector<std::string_view>&);
+
+void StringPayloadCompressor::reset() {
+  is_trained_ = false;
+  symbols_.clear();
+  buildLookupTables();
+}
+
+void StringPayloadCompressor::setSymbols(const std::vector<std::string>& symbol_strings) {
+  CHECK_LE(symbol_strings.size(), kMaxSymbolCount);
+  symbols_.clear();
+  symbols_.reserve(symbol_strings.size());
+  for (const auto& symbol_string : symbol_strings) {
+    CHECK(!symbol_string.empty());
+    CHECK_LE(symbol_string.size(), kMaxSymbolLength);
+    Symbol symbol{};
+    std::memcpy(symbol.bytes.data(), symbol_string.data(), symbol_string.size());
+    symbol.length = static_cast<uint8_t>(symbol_string.size());
+    symbols_.emplace_back(symbol);
+  }
+  buildLookupTables();
+}
+
+void StringPayloadCompressor::buildLookupTables() {
+  for (auto& bucket : symbols_by_first_byte_) {
+    bucket.clear();
+  }
+  code_lengths_.fill(0);
+  for (size_t code = 0; code < kFirstSymbolCode; ++code) {
+    code_lengths_[code] = 1;
+  }
+  for (size_t symbol_idx = 0; symbol_idx < symbols_.size(); ++symbol_idx) {
+    const auto& symbol = symbols_[symbol_idx];
+    symbols_by_first_byte_[static_cast<uint8_t>(symbol.bytes[0])].push_back(symbol_idx);
+    code_lengths_[kFirstSymbolCode + symbol_idx] = symbol.length;
+  }
+  for (auto& bucket : symbols_by_first_byte_) {
+    std::stable_sort(bucket.begin(), bucket.end(), [this](uint8_t lhs, uint8_t rhs) {
+      return symbols_[lhs].length > symbols_[rhs].length;
+    });
+  }
+}
+
+void StringPayloadCompressor::encode(std::string_view raw, std::string& encoded) const {
+  encoded.clear();
+  encoded.reserve(raw.size());
+  size_t pos{0};
+  while (pos < raw.size()) {
+    const uint8_t first_byte = raw[pos];
+    const size_t remaining = raw.size() - pos;
+    bool matched{false};
+    for (const auto symbol_idx : symbols_by_first_byte_[first_byte]) {
+      const auto& symbol = symbols_[symbol_idx];
+      if (symbol.length <= remaining &&
+          !std::memcmp(symbol.bytes.data(), raw.data() + pos, symbol.length)) {
+        encoded.push_back(static_cast<char>(kFirstSymbolCode + symbol_idx));
+        pos += symbol.length;
+        matched = true;
+        break;
+      }
+    }
+    if (matched) {
+      continue;
+    }
+    if (first_byte >= kFirstSymbolCode) {
+      encoded.push_back(static_cast<char>(kEscapeCode));
+    }
+    encoded.push_back(static_cast<char>(first_byte));
+    ++pos;
+  }
+}
+
+std::string StringPayloadCompressor::encode(std::string_view raw) const {
+  std::string encoded;
+  encode(raw, encoded);
+  return encoded;
+}
+
+size_t StringPayloadCompressor::decodedLength(std::string_view encoded) const noexcept {
+  size_t length{0};
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    const uint8_t code = encoded[i];
+    if (code == kEscapeCode) {
+      ++i;
+      ++length;
+    } else {
+      length += code_lengths_[code];
+    }
+  }
+  return length;
+}
+
+void StringPayloadCompressor::decodeInto(std::string_view encoded,
+                                         char* dest) const noexcept {
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    const uint8_t code = encoded[i];
+    if (code < kFirstSymbolCode) {
+      *dest++ = code;
+    } else if (code == kEscapeCode) {
+      *dest++ = encoded[++i];
+    } else {
+      const auto& symbol = symbols_[code - kFirstSymbolCode];
+      std::memcpy(dest, symbol.bytes.data(), symbol.length);
+      dest += symbol.length;
+    }
+  }
+}
+
+std::string StringPayloadCompressor::decode(std::string_view encoded) const {
+  std::string raw(decodedLength(encoded), '\0');
+  decodeInto(encoded, raw.data());
+  return raw;
+}
+
+void StringPayloadCompressor::writeToFile(const std::string& file_path,
+                                          const Stats& stats) const {
+  // Write to a temporary file first so that a crash never leaves a dictionary with a
+  // truncated symbol table, which would make its payload unreadable
+  const auto tmp_file_path = file_path + ".tmp";
+  {
+    std::ofstream out(tmp_file_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Unable to open " + tmp_file_path + " for writing.");
+    }
+    write_pod(out, kSymbolsFileMagic);
+    write_pod(out, kSymbolsFileVersion);
+    write_pod(out, stats.raw_payload_bytes);
+    write_pod(out, stats.encoded_payload_bytes);
+    write_pod(out, static_cast<uint32_t>(symbols_.size()));
+    for (const auto& symbol : symbols_) {
+      write_pod(out, symbol.length);
+      out.write(symbol.bytes.data(), symbol.length);
+    }
+    out.flush();
+    if (!out) {
+      throw std::runtime_error("Unable to write string dictionary symbol table " +
+                               tmp_file_path);
+    }
+  }
+  std::filesystem::rename(tmp_file_path, file_path);
+}
+
+std::unique_ptr<StringPayloadCompressor> StringPayloadCompressor::readFromFile(
+    const std::string& file_path,
+    Stats& stats) {
+  std::ifstream in(file_path, std::ios::binary);
+  if (!in || !read_header(in, stats)) {
+    return nullptr;
+  }
+  uint32_t num_symbols{0};
+  if (!read_pod(in, num_symbols) || num_symbols > kMaxSymbolCount) {
+    return nullptr;
+  }
+  std::vector<std::string> symbol_strings(num_symbols);
+  for (auto& symbol_string : symbol_strings) {
+    uint8_t length{0};
+    if (!read_pod(in, length) || length == 0 || length > kMaxSymbolLength) {
+      return nullptr;
+    }
+    symbol_string.resize(length);
+    if (!in.read(symbol_string.data(), length)) {
+      return nullptr;
+    }
+  }
+  auto compressor = std::make_unique<StringPayloadCompressor>();
+  compressor->setSymbols(symbol_strings);
+  compressor->is_trained_ = true;
+  return compressor;
+}
+
+std::optional<StringPayloadCompressor::Stats> StringPayloadCompressor::readStatsFromFile(
+    const std::string& file_path) {
+  std::ifstream in(file_path, std::ios::binary);
+  Stats stats;
+  if (!in || !read_header(in, stats)) {
+    return std::nullopt;
+  }
+  return stats;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    StringPayloadCompressor.h
+ * @brief   Static symbol table compression (FSST-style) for string dictionary payloads.
+ *
+ * A dictionary that opts into payload compression trains one symbol table from the
+ * first batch of strings it receives and keeps it for its whole lifetime. Encoding is
+ * a deterministic greedy longest-match, so two equal strings always produce the same
+ * encoded bytes, which lets the dictionary hash and compare payloads without decoding.
+ *
+ * Code layout of an encoded byte stream:
+ *   0x00 - 0x7f  the ASCII byte itself
+ *   0x80 - 0xfe  one of up to 127 learned symbols of 1 to 8 bytes
+ *   0xff         escape, the next byte is a literal non-ASCII byte
+ *
+ * Keeping ASCII as literals means an untrained or poorly trained table never inflates
+ * plain text; only non-ASCII bytes that are not covered by a symbol cost two bytes.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class StringPayloadCompressor {
+ public:
+  static constexpr size_t kMaxSymbolLength{8};
+  static constexpr size_t kMaxSymbolCount{127};
+  static constexpr uint8_t kFirstSymbolCode{0x80};
+  static constexpr uint8_t kEscapeCode{0xff};
+  // Worst case every byte is an escaped non-ASCII byte
+  static constexpr size_t kMaxExpansionFactor{2};
+
+  static constexpr const char* kSymbolsFileName{"DictSymbols"};
+
+  struct Stats {
+    uint64_t raw_payload_bytes{0};
+    uint64_t encoded_payload_bytes{0};
+
+    double compressionRatio() const {
+      return encoded_payload_bytes == 0
+                 ? 1.0
+                 : static_cast<double>(raw_payload_bytes) / encoded_payload_bytes;
+    }
+  };
+
+  StringPayloadCompressor();
+
+  template <class String>
+  void train(const std::vector<String>& sample_strings);
+
+  bool isTrained() const noexcept { return is_trained_.load(); }
+  // Drops a trained table that could not be persisted, so that it can be trained again
+  void reset();
+  size_t symbolCount() const noexcept { return symbols_.size(); }
+
+  void encode(std::string_view raw, std::string& encoded) const;
+  std::string encode(std::string_view raw) const;
+
+  size_t decodedLength(std::string_view encoded) const noexcept;
+  // Writes decodedLength(encoded) bytes to dest
+  void decodeInto(std::string_view encoded, char* dest) const noexcept;
+  std::string decode(std::string_view encoded) const;
+
+  // The symbol table file also carries the payload size counters so that the
+  // compression ratio can be reported without opening the dictionary
+  void writeToFile(const std::string& file_path, const Stats& stats) const;
+  static std::unique_ptr<StringPayloadCompressor> readFromFile(
+      const std::string& file_path,
+      Stats& stats);
+  static std::optional<Stats> readStatsFromFile(const std::string& file_path);
+
+ private:
+  struct Symbol {
+    std::array<char, kMaxSymbolLength> bytes;
+    uint8_t length;
+
+    std::string_view view() const { return {bytes.data(), length}; }
+  };
+
+  void setSymbols(const std::vector<std::string>& symbol_strings);
+  void buildLookupTables();
+
+  std::vector<Symbol> symbols_;
+  // Indexes into symbols_ bucketed by first byte, longest symbols first
+  std::array<std::vector<uint8_t>, 256> symbols_by_first_byte_;
+  // Decoded length of every code, used to size decode buffers in one pass
+  std::array<uint8_t, 256> code_lengths_;
+  // Flips once, after which the symbol table is immutable and safe to share
+  std::atomic<bool> is_trained_;
+};
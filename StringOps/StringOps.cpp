@@ -19,6 +19,7 @@
 
 #include <rapidjson/document.h>
 #include <boost/algorithm/string/predicate.hpp>
+#include <cstring>
 
 namespace StringOps_Namespace {
 
@@ -335,21 +336,49 @@ Datum Hash::numericEval(const std::string_view str) const {
   }
 }
 
+namespace {
+
+// Flips the case of every byte in [range_begin, range_end] eight bytes at a time. Only
+// ASCII letters are touched, which matches std::tolower/std::toupper in the "C" locale
+// for every byte value, so no separate ASCII check is needed.
+template <char range_begin, char range_end>
+void flip_ascii_letter_case(std::string& str) {
+  constexpr uint64_t ones{0x0101010101010101ULL};
+  constexpr uint64_t high_bits{ones * 0x80};
+  // Added to the low seven bits of each byte, these set the byte's high bit iff it is
+  // >= range_begin and > range_end respectively, without carrying into the next byte
+  constexpr uint64_t begin_offset{ones * (0x80 - range_begin)};
+  constexpr uint64_t end_offset{ones * (0x7f - range_end)};
+  char* data = str.data();
+  const size_t size = str.size();
+  size_t idx = 0;
+  for (; idx + sizeof(uint64_t) <= size; idx += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data + idx, sizeof(uint64_t));
+    const uint64_t low_bits = word & ~high_bits;
+    const uint64_t in_range =
+        (low_bits + begin_offset) & ~(low_bits + end_offset) & ~word & high_bits;
+    word ^= in_range >> 2;  // 0x80 -> 0x20, the ASCII case bit
+    std::memcpy(data + idx, &word, sizeof(uint64_t));
+  }
+  for (; idx < size; ++idx) {
+    if (data[idx] >= range_begin && data[idx] <= range_end) {
+      data[idx] ^= 0x20;
+    }
+  }
+}
+
+}  // namespace
+
 NullableStrType Lower::operator()(const std::string& str) const {
   std::string output_str(str);
-  std::transform(
-      output_str.begin(), output_str.end(), output_str.begin(), [](unsigned char c) {
-        return std::tolower(c);
-      });
+  flip_ascii_letter_case<'A', 'Z'>(output_str);
   return output_str;
 }
 
 NullableStrType Upper::operator()(const std::string& str) const {
   std::string output_str(str);
-  std::transform(
-      output_str.begin(), output_str.end(), output_str.begin(), [](unsigned char c) {
-        return std::toupper(c);
-      });
+  flip_ascii_letter_case<'a', 'z'>(output_str);
   return output_str;
 }
 
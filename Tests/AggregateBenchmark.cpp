@@ -0,0 +1,162 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+
+#include "../Logger/Logger.h"
+#include "../QueryEngine/ResultSet.h"
+#include "../QueryRunner/QueryRunner.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+extern bool g_enable_partitioned_count_distinct;
+extern bool g_enable_predicated_aggregates;
+
+using QR = QueryRunner::QueryRunner;
+
+inline void run_ddl_statement(const std::string& create_table_stmt) {
+  QR::get()->runDDLStatement(create_table_stmt);
+}
+
+std::shared_ptr<ResultSet> run_multiple_agg(const std::string& query_str,
+                                            const ExecutorDeviceType device_type) {
+  return QR::get()->runSQL(
+      query_str, device_type, /*hoist_literals=*/true, /*allow_loop_joins=*/true);
+}
+
+constexpr int64_t kRowCount{10000000};
+
+std::once_flag setup_flag;
+void global_setup() {
+  TestHelpers::init_logger_stderr_only();
+  QR::init(BASE_PATH);
+}
+
+// Creates a table of kRowCount rows from the given generate_series projection the first
+// time a benchmark on it runs, so that filtering the benchmarks skips the other tables
+void create_bench_table(std::once_flag& table_flag,
+                        const std::string& table_name,
+                        const std::string& projection,
+                        const std::string& warmup_query) {
+  std::call_once(setup_flag, global_setup);
+  std::call_once(table_flag, [&] {
+    run_ddl_statement("DROP TABLE IF EXISTS " + table_name + ";");
+    run_ddl_statement("CREATE TABLE " + table_name + " AS SELECT " + projection +
+                      " FROM TABLE(generate_series(1, " + std::to_string(kRowCount) +
+                      "));");
+    // make sure we're warmed up
+    run_multiple_agg(warmup_query, ExecutorDeviceType::CPU);
+  });
+}
+
+std::once_flag predicated_agg_table_flag;
+
+class PredicatedAggregatesFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    // k is scattered over [0, 100) so that "k < selectivity" passes the given percentage
+    // of the rows in an order the branch predictor cannot learn
+    create_bench_table(
+        predicated_agg_table_flag,
+        "predicated_agg_bench",
+        "MOD(generate_series * 7919, 100) AS k, generate_series AS x, "
+        "CAST(generate_series AS DOUBLE) / 3 AS d",
+        "SELECT COUNT(*), SUM(x), SUM(d) FROM predicated_agg_bench;");
+    g_enable_predicated_aggregates = state.range(1);
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    g_enable_predicated_aggregates = true;
+  }
+};
+
+//! Non-grouped aggregates behind a filter passing state.range(0) percent of the rows,
+//! with the filter branch (state.range(1) == 0) or with predicated aggregate updates
+BENCHMARK_DEFINE_F(PredicatedAggregatesFixture, FilteredAggregates)
+(benchmark::State& state) {
+  const auto query =
+      "SELECT COUNT(*), SUM(x), MIN(x), MAX(d) FROM predicated_agg_bench WHERE k < " +
+      std::to_string(state.range(0)) + ";";
+  for (auto _ : state) {
+    run_multiple_agg(query, ExecutorDeviceType::CPU);
+  }
+}
+
+void selectivity_args(benchmark::internal::Benchmark* b) {
+  for (int64_t selectivity : {1, 10, 30, 50, 70, 90, 99}) {
+    for (int64_t predicated : {0, 1}) {
+      b->Args({selectivity, predicated});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(PredicatedAggregatesFixture, FilteredAggregates)
+    ->Apply(selectivity_args)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+std::once_flag count_distinct_table_flag;
+
+class CountDistinctFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    // g takes 1M distinct values, v is scattered over a range too wide for a bitmap so
+    // that COUNT(DISTINCT v) uses hash sets
+    create_bench_table(count_distinct_table_flag,
+                       "count_distinct_bench",
+                       "MOD(generate_series * 7919, 1000000) AS g, "
+                       "MOD(generate_series * 104729, 1000000007) AS v",
+                       "SELECT COUNT(*), MIN(g), MAX(v) FROM count_distinct_bench;");
+    g_enable_partitioned_count_distinct = state.range(1);
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    g_enable_partitioned_count_distinct = false;
+  }
+};
+
+//! COUNT(DISTINCT v) over state.range(0) groups, with a hash set per group
+//! (state.range(1) == 0) or as a group by on (group, v) followed by a COUNT
+BENCHMARK_DEFINE_F(CountDistinctFixture, GroupedCountDistinct)
+(benchmark::State& state) {
+  const auto query = "SELECT MOD(g, " + std::to_string(state.range(0)) +
+                     ") AS k, COUNT(DISTINCT v) FROM count_distinct_bench GROUP BY k;";
+  for (auto _ : state) {
+    run_multiple_agg(query, ExecutorDeviceType::CPU);
+  }
+}
+
+void group_count_args(benchmark::internal::Benchmark* b) {
+  for (int64_t group_count : {1000, 100000, 1000000}) {
+    for (int64_t partitioned : {0, 1}) {
+      b->Args({group_count, partitioned});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(CountDistinctFixture, GroupedCountDistinct)
+    ->Apply(group_count_args)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
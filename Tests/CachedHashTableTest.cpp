@@ -32,6 +32,8 @@
 #include <set>
 #include <vector>
 
+extern bool g_enable_incremental_join_hash_table_maintenance;
+
 namespace po = boost::program_options;
 
 #ifndef BASE_PATH
@@ -1012,6 +1014,105 @@ TEST(Delete, JoinCacheInvalidationTest_DropTable) {
   }
 }
 
+TEST(Insert, JoinCacheIncrementalMaintenanceTest) {
+  ScopeGuard reset_incremental_maintenance =
+      [orig = g_enable_incremental_join_hash_table_maintenance] {
+        g_enable_incremental_join_hash_table_maintenance = orig;
+      };
+  g_enable_incremental_join_hash_table_maintenance = true;
+
+  run_ddl_statement("DROP TABLE IF EXISTS cache_append_t1;");
+  run_ddl_statement("DROP TABLE IF EXISTS cache_append_t2;");
+  run_ddl_statement("CREATE TABLE cache_append_t1 (k int);");
+  run_ddl_statement("CREATE TABLE cache_append_t2 (k int);");
+  for (int32_t k : {0, 1, 2, 3, 4, 5}) {
+    run_query("INSERT INTO cache_append_t1 VALUES (" + std::to_string(k) + ");",
+              ExecutorDeviceType::CPU);
+  }
+  run_query("INSERT INTO cache_append_t2 VALUES (0);", ExecutorDeviceType::CPU);
+  run_query("INSERT INTO cache_append_t2 VALUES (3);", ExecutorDeviceType::CPU);
+
+  const auto q =
+      "SELECT COUNT(1) FROM cache_append_t1 t1, cache_append_t2 t2 WHERE t1.k = t2.k;";
+  auto get_cached_perfect_ht = [] {
+    std::set<QueryPlanHash> visited_hashtable_key;
+    return std::dynamic_pointer_cast<PerfectHashTable>(
+        getCachedHashTable(visited_hashtable_key, CacheItemType::PERFECT_HT));
+  };
+  EXPECT_EQ(int64_t(2), v<int64_t>(run_simple_query(q, ExecutorDeviceType::CPU)));
+  EXPECT_EQ(QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::ALL,
+                                             CacheItemType::PERFECT_HT),
+            static_cast<size_t>(1));
+
+  // (a) a key within the cached key range: the cached hash table stays clean and
+  // is extended with the appended row on the next lookup
+  run_query("INSERT INTO cache_append_t2 VALUES (1);", ExecutorDeviceType::CPU);
+  EXPECT_EQ(QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::DIRTY_ONLY,
+                                             CacheItemType::PERFECT_HT),
+            static_cast<size_t>(0));
+  EXPECT_EQ(int64_t(3), v<int64_t>(run_simple_query(q, ExecutorDeviceType::CPU)));
+  EXPECT_EQ(QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::CLEAN_ONLY,
+                                             CacheItemType::PERFECT_HT),
+            static_cast<size_t>(1));
+  std::vector<int32_t> one_to_one_keys{0, 3, 1};
+  auto cached_ht = get_cached_perfect_ht();
+  CHECK(cached_ht);
+  EXPECT_EQ(cached_ht->getLayout(), HashType::OneToOne);
+  EXPECT_TRUE(check_one_to_one_join_hashtable(one_to_one_keys,
+                                              (int32_t*)cached_ht->getCpuBuffer()));
+
+  // (b) a duplicated key: the one-to-one hash table cannot be extended, so it is
+  // rebuilt as a one-to-many hash table
+  run_query("INSERT INTO cache_append_t2 VALUES (3);", ExecutorDeviceType::CPU);
+  EXPECT_EQ(int64_t(4), v<int64_t>(run_simple_query(q, ExecutorDeviceType::CPU)));
+  cached_ht = get_cached_perfect_ht();
+  CHECK(cached_ht);
+  EXPECT_EQ(cached_ht->getLayout(), HashType::OneToMany);
+
+  // (c) appends to the one-to-many hash table are merged into its row id buffer
+  run_query("INSERT INTO cache_append_t2 VALUES (1);", ExecutorDeviceType::CPU);
+  EXPECT_EQ(int64_t(5), v<int64_t>(run_simple_query(q, ExecutorDeviceType::CPU)));
+  std::vector<int32_t> one_to_many_keys{0, 3, 1, 3, 1};
+  cached_ht = get_cached_perfect_ht();
+  CHECK(cached_ht);
+  EXPECT_EQ(cached_ht->getLayout(), HashType::OneToMany);
+  EXPECT_TRUE(check_one_to_many_join_hashtable(one_to_many_keys,
+                                               (int32_t*)cached_ht->getCpuBuffer()));
+
+  // (d) a key out of the cached key range forces a rebuild
+  run_query("INSERT INTO cache_append_t2 VALUES (5);", ExecutorDeviceType::CPU);
+  EXPECT_EQ(int64_t(6), v<int64_t>(run_simple_query(q, ExecutorDeviceType::CPU)));
+  EXPECT_EQ(QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::CLEAN_ONLY,
+                                             CacheItemType::PERFECT_HT),
+            static_cast<size_t>(1));
+
+  // (e) an append opening a new fragment changes the cache key, so the cached hash
+  // table is marked dirty instead of being left behind in the cache
+  clearCaches();
+  run_ddl_statement("DROP TABLE IF EXISTS cache_append_t3;");
+  run_ddl_statement("CREATE TABLE cache_append_t3 (k int) WITH (fragment_size = 2);");
+  run_query("INSERT INTO cache_append_t3 VALUES (0);", ExecutorDeviceType::CPU);
+  run_query("INSERT INTO cache_append_t3 VALUES (3);", ExecutorDeviceType::CPU);
+  const auto q_fragmented =
+      "SELECT COUNT(1) FROM cache_append_t1 t1, cache_append_t3 t3 WHERE t1.k = t3.k;";
+  EXPECT_EQ(int64_t(2),
+            v<int64_t>(run_simple_query(q_fragmented, ExecutorDeviceType::CPU)));
+  run_query("INSERT INTO cache_append_t3 VALUES (1);", ExecutorDeviceType::CPU);
+  EXPECT_EQ(QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::DIRTY_ONLY,
+                                             CacheItemType::PERFECT_HT),
+            static_cast<size_t>(1));
+  EXPECT_EQ(int64_t(3),
+            v<int64_t>(run_simple_query(q_fragmented, ExecutorDeviceType::CPU)));
+  EXPECT_EQ(QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::CLEAN_ONLY,
+                                             CacheItemType::PERFECT_HT),
+            static_cast<size_t>(1));
+
+  run_ddl_statement("DROP TABLE cache_append_t1;");
+  run_ddl_statement("DROP TABLE cache_append_t2;");
+  run_ddl_statement("DROP TABLE cache_append_t3;");
+  clearCaches();
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
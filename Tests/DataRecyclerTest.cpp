@@ -35,6 +35,7 @@
 extern bool g_is_test_env;
 extern bool g_enable_table_functions;
 extern bool g_enable_dev_table_functions;
+extern bool g_enable_incremental_join_hash_table_maintenance;
 
 using QR = QueryRunner::QueryRunner;
 using namespace TestHelpers;
@@ -1933,6 +1934,13 @@ TEST(DataRecycler, Hashtable_For_Dict_Encoded_Column) {
 }
 
 TEST(DataRecycler, SimpleInsertion) {
+  // appends keep cached perfect hash tables alive when they are maintained
+  // incrementally, so check the invalidation path with the feature disabled
+  ScopeGuard reset_incremental_maintenance =
+      [orig = g_enable_incremental_join_hash_table_maintenance] {
+        g_enable_incremental_join_hash_table_maintenance = orig;
+      };
+  g_enable_incremental_join_hash_table_maintenance = false;
   auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID).get();
   executor->clearMemory(MemoryLevel::CPU_LEVEL);
   executor->getQueryPlanDagCache().clearQueryPlanCache();
@@ -21,7 +21,9 @@
 #include "../QueryEngine/ArrowResultSet.h"
 #include "../QueryEngine/CgenState.h"
 #include "../QueryEngine/CodeCacheAccessor.h"
+#include "../QueryEngine/CodeGenerator.h"
 #include "../QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
+#include "../QueryEngine/DiskCodeCache.h"
 #include "../QueryEngine/Execute.h"
 #include "../QueryEngine/ExpressionRange.h"
 #include "../QueryEngine/QueryEngine.h"
@@ -38,6 +40,7 @@
 #include <gtest/gtest.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/any.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/program_options.hpp>
 
 #include <cmath>
@@ -79,6 +82,26 @@ extern bool g_enable_union;
 extern size_t g_watchdog_none_encoded_string_translation_limit;
 extern bool g_enable_table_functions;
 extern bool g_enable_executor_resource_mgr;
+extern bool g_enable_cpu_sub_tasks;
+extern size_t g_cpu_sub_task_size;
+extern bool g_enable_group_by_spill;
+extern size_t g_group_by_spill_partition_count;
+extern size_t g_max_cpu_group_by_buffer_size;
+extern bool g_columnar_intermediate_projections;
+extern size_t g_columnar_intermediate_projections_threshold;
+extern bool g_enable_concurrent_subqueries;
+extern bool g_enable_predicated_aggregates;
+extern bool g_enable_tiered_cpu_compilation;
+extern bool g_enable_concurrent_cpu_codegen;
+extern bool g_enable_left_join_lazy_fetch;
+extern bool g_enable_parallel_sort;
+extern size_t g_parallel_sort_max_buffer_size;
+extern bool g_enable_top_n_fragment_skipping;
+extern bool g_enable_partitioned_count_distinct;
+extern bool g_enable_sparse_hll;
+extern int64_t g_bitmap_memory_limit;
+extern bool g_enable_runtime_join_filters;
+extern bool g_enable_loop_join_fragment_alignment;
 
 extern size_t g_leaf_count;
 extern bool g_cluster;
@@ -2178,6 +2201,28 @@ TEST_F(Select, FilterShortCircuit) {
   }
 }
 
+TEST_F(Select, PredicatedAggregates) {
+  ScopeGuard reset_flag = [orig = g_enable_predicated_aggregates] {
+    g_enable_predicated_aggregates = orig;
+  };
+  for (bool enable : {false, true}) {
+    g_enable_predicated_aggregates = enable;
+    const auto dt = ExecutorDeviceType::CPU;
+    c("SELECT COUNT(*), SUM(x), MIN(y), MAX(z), AVG(t), COUNT(ofd) FROM test WHERE y > "
+      "42;",
+      dt);
+    c("SELECT SUM(f), MIN(d), MAX(dd), COUNT(smallint_nulls), AVG(ofq) FROM test WHERE "
+      "x < 8 AND z > 100;",
+      dt);
+    c("SELECT COUNT(*), SUM(y), MIN(ofd), MAX(ufq) FROM test WHERE x > 7 OR y IS NULL;",
+      dt);
+    c("SELECT COUNT(*), SUM(x), MAX(t) FROM test WHERE UNLIKELY(x > 7);", dt);
+    c("SELECT COUNT(*), SUM(x), MIN(y), MAX(d) FROM test WHERE x > 1000;", dt);
+    // the argument of the aggregate is not a plain column, keep the filter branch
+    c("SELECT SUM(x / y) FROM test WHERE y <> 0;", dt);
+  }
+}
+
 TEST_F(Select, InValues) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -3632,6 +3677,27 @@ TEST_F(Select, CountDistinct) {
   }
 }
 
+TEST_F(Select, PartitionedCountDistinct) {
+  ScopeGuard reset = [orig = g_enable_partitioned_count_distinct] {
+    g_enable_partitioned_count_distinct = orig;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable : {false, true}) {
+      g_enable_partitioned_count_distinct = enable;
+      c("SELECT COUNT(DISTINCT y) FROM test;", dt);
+      c("SELECT COUNT(DISTINCT y) FROM test WHERE x < 0;", dt);
+      c("SELECT x, COUNT(DISTINCT y) FROM test GROUP BY x ORDER BY x;", dt);
+      c("SELECT x, COUNT(DISTINCT y) FROM test WHERE z > 0 GROUP BY x ORDER BY x;", dt);
+      c("SELECT y, COUNT(DISTINCT str) FROM test GROUP BY y ORDER BY y;", dt);
+      c("SELECT x, y, COUNT(DISTINCT smallint_nulls) AS n FROM test GROUP BY x, y "
+        "ORDER BY x, y;",
+        dt);
+      c("SELECT COUNT(DISTINCT x) AS n, x FROM test GROUP BY x ORDER BY x;", dt);
+    }
+  }
+}
+
 TEST_F(Select, CountIf) {
   struct CountIfTestQuery {
     std::string query;
@@ -3938,6 +4004,47 @@ TEST_F(Select, ApproxCountDistinct) {
                        false));
 }
 
+TEST_F(Select, SparseApproxCountDistinct) {
+  ScopeGuard reset = [orig = g_enable_sparse_hll] { g_enable_sparse_hll = orig; };
+  // an error rate of 20% uses 32 registers, which are made dense after a few values
+  const std::vector<std::string> queries{
+      "SELECT y, APPROX_COUNT_DISTINCT(x) FROM test GROUP BY y ORDER BY y;",
+      "SELECT y, APPROX_COUNT_DISTINCT(x + z, 20) FROM test GROUP BY y ORDER BY y;",
+      "SELECT str, APPROX_COUNT_DISTINCT(d, 20), APPROX_COUNT_DISTINCT(f) FROM test "
+      "GROUP BY str ORDER BY str;"};
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const auto& query : queries) {
+      g_enable_sparse_hll = false;
+      const auto dense_rows = run_multiple_agg(query, dt);
+      g_enable_sparse_hll = true;
+      const auto sparse_rows = run_multiple_agg(query, dt);
+      ASSERT_EQ(dense_rows->rowCount(), sparse_rows->rowCount());
+      for (size_t i = 0; i < dense_rows->rowCount(); ++i) {
+        const auto dense_row = dense_rows->getNextRow(true, true);
+        const auto sparse_row = sparse_rows->getNextRow(true, true);
+        ASSERT_EQ(dense_row.size(), sparse_row.size());
+        for (size_t j = 1; j < dense_row.size(); ++j) {
+          EXPECT_EQ(v<int64_t>(dense_row[j]), v<int64_t>(sparse_row[j]));
+        }
+      }
+    }
+    c("SELECT y, APPROX_COUNT_DISTINCT(x) FROM test GROUP BY y ORDER BY y;",
+      "SELECT y, COUNT(distinct x) FROM test GROUP BY y ORDER BY y;",
+      dt);
+  }
+  // the sparse records count against the bitmap memory limit
+  ScopeGuard reset_limit = [orig = g_bitmap_memory_limit] {
+    g_bitmap_memory_limit = orig;
+  };
+  g_enable_sparse_hll = true;
+  g_bitmap_memory_limit = 64;
+  EXPECT_THROW(
+      run_multiple_agg("SELECT y, APPROX_COUNT_DISTINCT(x) FROM test GROUP BY y;",
+                       ExecutorDeviceType::CPU),
+      std::exception);
+}
+
 class AggDistinct
     : public Select,
       public testing::WithParamInterface<std::tuple<ExecutorDeviceType, SQLAgg>> {
@@ -5213,6 +5320,10 @@ TEST_F(Select, Strings) {
     c("SELECT * FROM test WHERE str LIKE '@f%%' ESCAPE '@' ORDER BY x ASC, y ASC;", dt);
     c(R"(SELECT COUNT(*) FROM test WHERE real_str LIKE '%foo' OR real_str LIKE '%"bar"';)",
       dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str LIKE 'real%';", dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str LIKE '%%bar';", dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str LIKE 'real@_foo' ESCAPE '@';", dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str LIKE '%@_%' ESCAPE '@';", dt);
     c("SELECT COUNT(*) FROM test WHERE str LIKE 'ba_' or str LIKE 'fo_';", dt);
     c("SELECT COUNT(*) FROM test WHERE str IS NULL;", dt);
     c("SELECT COUNT(*) FROM test WHERE str IS NOT NULL;", dt);
@@ -5512,6 +5623,68 @@ TEST_F(Select, CanReuseCompiledCodeForStringPatternMatchQuery) {
   }
 }
 
+TEST_F(Select, TieredCpuCompilation) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset_flag = [orig = g_enable_tiered_cpu_compilation] {
+    g_enable_tiered_cpu_compilation = orig;
+  };
+  g_enable_tiered_cpu_compilation = true;
+  const auto dt = ExecutorDeviceType::CPU;
+  auto qe_instance = QueryEngine::getInstance();
+  const auto before = qe_instance->cpu_code_accessor->getCodeCacheMetric();
+  // the quick tier runs the first query, the optimized kernel the repeated one
+  const std::string query{
+      "SELECT SUM(x * 7 - y), MAX(w + z) FROM test WHERE y * 3 > x + 5;"};
+  c(query, dt);
+  CodeGenerator::waitForTieredCPUCompilation();
+  const auto after = qe_instance->cpu_code_accessor->getCodeCacheMetric();
+  EXPECT_GT(after.overwrite_count, before.overwrite_count);
+  c(query, dt);
+  c("SELECT x, COUNT(*) FROM test WHERE y * 3 > x + 5 GROUP BY x ORDER BY x;", dt);
+  CodeGenerator::waitForTieredCPUCompilation();
+  c("SELECT x, COUNT(*) FROM test WHERE y * 3 > x + 5 GROUP BY x ORDER BY x;", dt);
+}
+
+TEST_F(Select, DiskCodeCache) {
+  SKIP_ALL_ON_AGGREGATOR();
+  const auto cache_dir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("heavyai_disk_code_cache_%%%%-%%%%");
+  ScopeGuard reset_dir = [orig = g_disk_code_cache_dir, &cache_dir] {
+    if (auto disk_code_cache = DiskCodeCache::getInstance()) {
+      disk_code_cache->clear();
+    }
+    g_disk_code_cache_dir = orig;
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(cache_dir, ec);
+  };
+  g_disk_code_cache_dir = cache_dir.string();
+  auto disk_code_cache = DiskCodeCache::getInstance();
+  ASSERT_TRUE(disk_code_cache);
+  disk_code_cache->clear();
+
+  const auto dt = ExecutorDeviceType::CPU;
+  auto qe_instance = QueryEngine::getInstance();
+  const std::string query{
+      "SELECT SUM(x * 11 - y), MIN(w - z) FROM test WHERE y * 5 > x + 3;"};
+  qe_instance->cpu_code_accessor->clear();
+  c(query, dt);
+  size_t num_entries{0};
+  for (const auto& entry : boost::filesystem::recursive_directory_iterator(cache_dir)) {
+    if (entry.path().extension() == ".o") {
+      ++num_entries;
+    }
+  }
+  EXPECT_GT(num_entries, size_t(0));
+  // the in-memory code cache is lost, as on a restart, and the kernel is loaded from
+  // the disk code cache instead of being compiled again
+  const auto hit_count = disk_code_cache->getHitCount();
+  qe_instance->cpu_code_accessor->clear();
+  c(query, dt);
+  EXPECT_GT(disk_code_cache->getHitCount(), hit_count);
+  c(query, dt);
+}
+
 TEST_F(Select, SharedDictionary) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -10732,6 +10905,84 @@ TEST_F(Select, TopNSortWithWatchdogOn) {
   }
 }
 
+TEST_F(Select, TopNFragmentSkipping) {
+  ScopeGuard reset = [orig = g_enable_top_n_fragment_skipping] {
+    g_enable_top_n_fragment_skipping = orig;
+    run_ddl_statement("DROP TABLE IF EXISTS top_n_frag_test;");
+    g_sqlite_comparator.query("DROP TABLE IF EXISTS top_n_frag_test;");
+  };
+  run_ddl_statement("DROP TABLE IF EXISTS top_n_frag_test;");
+  g_sqlite_comparator.query("DROP TABLE IF EXISTS top_n_frag_test;");
+  run_ddl_statement(
+      "CREATE TABLE top_n_frag_test(x INT, d DOUBLE, g INT) WITH (fragment_size=4);");
+  g_sqlite_comparator.query("CREATE TABLE top_n_frag_test(x INT, d DOUBLE, g INT);");
+  // every fragment covers a disjoint range of keys, d is null when x is a multiple of 7
+  // and g ties across fragment boundaries
+  for (int x = 0; x < 20; ++x) {
+    const std::string insert_query{
+        "INSERT INTO top_n_frag_test VALUES(" + std::to_string(x) + ", " +
+        (x % 7 ? std::to_string(x * 0.5) : std::string("NULL")) + ", " +
+        std::to_string(x / 3) + ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable : {false, true}) {
+      g_enable_top_n_fragment_skipping = enable;
+      c("SELECT x FROM top_n_frag_test ORDER BY x LIMIT 3;", dt);
+      c("SELECT x, d FROM top_n_frag_test ORDER BY x DESC LIMIT 5 OFFSET 2;", dt);
+      c("SELECT x FROM top_n_frag_test WHERE x > 5 ORDER BY x LIMIT 2;", dt);
+      c("SELECT d FROM top_n_frag_test ORDER BY d ASC NULLS FIRST LIMIT 4;",
+        "SELECT d FROM top_n_frag_test ORDER BY d ASC LIMIT 4;",
+        dt);
+      c("SELECT d FROM top_n_frag_test ORDER BY d DESC NULLS LAST LIMIT 4;",
+        "SELECT d FROM top_n_frag_test ORDER BY d DESC LIMIT 4;",
+        dt);
+      c("SELECT d FROM top_n_frag_test ORDER BY d ASC NULLS LAST LIMIT 18;",
+        "SELECT d FROM top_n_frag_test ORDER BY d IS NULL, d ASC LIMIT 18;",
+        dt);
+      c("SELECT g, x FROM top_n_frag_test ORDER BY g, x DESC LIMIT 5;", dt);
+      c("SELECT g, x FROM top_n_frag_test ORDER BY g DESC, x LIMIT 4 OFFSET 1;", dt);
+    }
+  }
+}
+
+TEST_F(Select, ParallelSort) {
+  ScopeGuard reset = [top_min = g_parallel_top_min,
+                      parallel_sort = g_enable_parallel_sort,
+                      max_buffer_size = g_parallel_sort_max_buffer_size] {
+    g_parallel_top_min = top_min;
+    g_enable_parallel_sort = parallel_sort;
+    g_parallel_sort_max_buffer_size = max_buffer_size;
+  };
+  g_parallel_top_min = 0;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool parallel_sort : {false, true}) {
+      g_enable_parallel_sort = parallel_sort;
+      c("SELECT x, y, COUNT(*) AS n FROM test GROUP BY x, y ORDER BY x DESC, y;", dt);
+      c("SELECT z, AVG(d) AS a FROM test GROUP BY z ORDER BY a DESC, z;", dt);
+      c("SELECT f + d AS s FROM test GROUP BY s ORDER BY s DESC;", dt);
+      c("SELECT fn FROM test ORDER BY fn ASC NULLS FIRST;",
+        "SELECT fn FROM test ORDER BY fn ASC;",
+        dt);
+      c("SELECT smallint_nulls, COUNT(*) FROM test GROUP BY smallint_nulls ORDER BY "
+        "smallint_nulls DESC NULLS LAST;",
+        "SELECT smallint_nulls, COUNT(*) FROM test GROUP BY smallint_nulls ORDER BY "
+        "smallint_nulls DESC;",
+        dt);
+    }
+  }
+  // Over the buffer budget, the sort falls back to the comparator.
+  g_enable_parallel_sort = true;
+  g_parallel_sort_max_buffer_size = 1;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT x, y, COUNT(*) AS n FROM test GROUP BY x, y ORDER BY x DESC, y;", dt);
+  }
+}
+
 TEST_F(Select, GroupByPerfectHash) {
   const auto default_bigint_flag = g_bigint_count;
   ScopeGuard reset = [default_bigint_flag] { g_bigint_count = default_bigint_flag; };
@@ -10850,6 +11101,96 @@ TEST_F(Select, GroupByBaselineHash) {
   }
 }
 
+TEST_F(Select, GroupByCpuSubTasks) {
+  ScopeGuard reset_flags = [orig_enable = g_enable_cpu_sub_tasks,
+                            orig_size = g_cpu_sub_task_size] {
+    g_enable_cpu_sub_tasks = orig_enable;
+    g_cpu_sub_task_size = orig_size;
+  };
+  g_enable_cpu_sub_tasks = true;
+  // Split every fragment into many sub-tasks, more than there are threads
+  g_cpu_sub_task_size = 3;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT x, COUNT(*), SUM(y), MIN(z), MAX(t) FROM test GROUP BY x ORDER BY x;", dt);
+  c("SELECT str, COUNT(*), AVG(x) FROM test GROUP BY str ORDER BY str;", dt);
+  c("SELECT x1, x2, COUNT(*), SUM(x3) FROM random_test GROUP BY x1, x2 ORDER BY x1, x2;",
+    dt);
+  c("SELECT x4, COUNT(*) FROM random_test WHERE x5 > 0 GROUP BY x4 ORDER BY x4;", dt);
+}
+
+TEST_F(Select, GroupBySpill) {
+  ScopeGuard reset_flags_and_drop_table = [orig_spill = g_enable_group_by_spill,
+                                           orig_count = g_group_by_spill_partition_count,
+                                           orig_size = g_max_cpu_group_by_buffer_size] {
+    g_enable_group_by_spill = orig_spill;
+    g_group_by_spill_partition_count = orig_count;
+    g_max_cpu_group_by_buffer_size = orig_size;
+    run_ddl_statement("DROP TABLE IF EXISTS group_by_spill_test;");
+  };
+  run_ddl_statement("DROP TABLE IF EXISTS group_by_spill_test;");
+  run_ddl_statement(
+      "CREATE TABLE group_by_spill_test AS SELECT generate_series AS k, "
+      "generate_series * 7 AS k2 FROM TABLE(generate_series(1, 20000));");
+  run_multiple_agg(
+      "INSERT INTO group_by_spill_test SELECT k, k2 FROM group_by_spill_test;",
+      ExecutorDeviceType::CPU);
+
+  // Too small for the baseline hash buffer of 20000 groups, large enough for a partition
+  g_max_cpu_group_by_buffer_size = 128 * 1024;
+  g_group_by_spill_partition_count = 64;
+  const auto dt = ExecutorDeviceType::CPU;
+  const std::string query{
+      "SELECT COUNT(*), SUM(n), MIN(n), MAX(n), SUM(s) FROM (SELECT k, k2, COUNT(*) "
+      "AS n, SUM(k2) AS s FROM group_by_spill_test GROUP BY k, k2);"};
+  g_enable_group_by_spill = false;
+  EXPECT_ANY_THROW(run_multiple_agg(query, dt));
+  g_enable_group_by_spill = true;
+  const auto rows = run_multiple_agg(query, dt);
+  ASSERT_EQ(size_t(1), rows->rowCount());
+  const auto row = rows->getNextRow(false, false);
+  EXPECT_EQ(int64_t(20000), v<int64_t>(row[0]));
+  EXPECT_EQ(int64_t(40000), v<int64_t>(row[1]));
+  EXPECT_EQ(int64_t(2), v<int64_t>(row[2]));
+  EXPECT_EQ(int64_t(2), v<int64_t>(row[3]));
+  EXPECT_EQ(int64_t(2) * 7 * (20000 * 20001 / 2), v<int64_t>(row[4]));
+
+  // The groups of every pass are kept in a buffer of their own within the budget,
+  // rather than in one buffer holding all the groups, and a pass takes as many
+  // partitions as the budget allows
+  const auto spilled_rows = run_multiple_agg(
+      "SELECT k, k2, COUNT(*) AS n FROM group_by_spill_test GROUP BY k, k2;", dt);
+  EXPECT_EQ(size_t(20000), spilled_rows->rowCount());
+  EXPECT_GT(spilled_rows->getSpillPassCount(), size_t(1));
+  EXPECT_LE(spilled_rows->getSpillPassCount(), g_group_by_spill_partition_count);
+  EXPECT_LE(spilled_rows->getBufferSizeBytes(ExecutorDeviceType::CPU),
+            g_max_cpu_group_by_buffer_size);
+}
+
+TEST_F(Select, ColumnarIntermediateProjections) {
+  ScopeGuard reset_flag = [orig = g_columnar_intermediate_projections] {
+    g_columnar_intermediate_projections = orig;
+  };
+  ScopeGuard reset_threshold = [orig = g_columnar_intermediate_projections_threshold] {
+    g_columnar_intermediate_projections_threshold = orig;
+  };
+  // the subquery results are far below the default threshold
+  g_columnar_intermediate_projections_threshold = 0;
+  for (bool enable : {false, true}) {
+    g_columnar_intermediate_projections = enable;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT x, COUNT(*), SUM(y) FROM (SELECT x, y FROM test WHERE y > 41 LIMIT "
+        "1000) GROUP BY x ORDER BY x;",
+        dt);
+      c("SELECT str, MAX(d) FROM (SELECT str, d FROM test WHERE x < 8 LIMIT 1000) "
+        "GROUP BY str ORDER BY str;",
+        dt);
+      c("SELECT COUNT(*), SUM(z) FROM (SELECT x, z FROM test LIMIT 1000) WHERE x > 7;",
+        dt);
+    }
+  }
+}
+
 TEST_F(Select, GroupByConstrainedByInQueryRewrite) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -11482,6 +11823,47 @@ TEST_F(Select, Subqueries) {
   }
 }
 
+TEST_F(Select, ConcurrentSubqueries) {
+  ScopeGuard reset_flag = [orig = g_enable_concurrent_subqueries] {
+    g_enable_concurrent_subqueries = orig;
+  };
+  g_enable_concurrent_subqueries = true;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM test WHERE x > (SELECT MIN(x) FROM test) AND y < (SELECT "
+      "MAX(y) FROM test) AND x <> (SELECT MIN(x) FROM test_inner);",
+      dt);
+    c("SELECT str, SUM(y) FROM test WHERE x IN (SELECT x FROM join_test) AND y > "
+      "(SELECT AVG(y) FROM test) GROUP BY str ORDER BY str;",
+      dt);
+    // the inner subquery has to finish before the one which contains it
+    c("SELECT COUNT(*) FROM test WHERE x IN (SELECT x FROM test WHERE y > (SELECT "
+      "MIN(y) FROM test)) AND z > (SELECT MIN(z) FROM test);",
+      dt);
+  }
+}
+
+TEST_F(Select, ConcurrentCpuCodegen) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset_flags = [orig_codegen = g_enable_concurrent_cpu_codegen,
+                            orig_subqueries = g_enable_concurrent_subqueries] {
+    g_enable_concurrent_cpu_codegen = orig_codegen;
+    g_enable_concurrent_subqueries = orig_subqueries;
+  };
+  g_enable_concurrent_cpu_codegen = true;
+  g_enable_concurrent_subqueries = true;
+  const auto dt = ExecutorDeviceType::CPU;
+  // the kernels of the subqueries are compiled concurrently by the helper executors
+  QueryEngine::getInstance()->cpu_code_accessor->clear();
+  c("SELECT COUNT(*) FROM test WHERE x > (SELECT MIN(x) FROM test) AND y < (SELECT "
+    "MAX(y) FROM test) AND x <> (SELECT MIN(x) FROM test_inner) AND z > (SELECT "
+    "AVG(z) FROM test);",
+    dt);
+  c("SELECT str, SUM(y) FROM test WHERE x IN (SELECT x FROM join_test) AND y > "
+    "(SELECT AVG(y) FROM test) GROUP BY str ORDER BY str;",
+    dt);
+}
+
 TEST_F(Select, Export_Via_Query_Having_Scalar_Subquery) {
   // EXPORT stmt needs "validation_query" to gather some info from the query
   // before doing the actual data export
@@ -11734,6 +12116,110 @@ TEST_F(Select, Joins_EmptyTable) {
   }
 }
 
+TEST_F(Select, Joins_RuntimeJoinFilters) {
+  auto drop_tables = [] {
+    for (const std::string table : {"rjf_fact", "rjf_dim"}) {
+      run_ddl_statement("DROP TABLE IF EXISTS " + table + ";");
+      g_sqlite_comparator.query("DROP TABLE IF EXISTS " + table + ";");
+    }
+  };
+  ScopeGuard reset = [orig = g_enable_runtime_join_filters, &drop_tables] {
+    g_enable_runtime_join_filters = orig;
+    drop_tables();
+  };
+  drop_tables();
+  run_ddl_statement("CREATE TABLE rjf_fact(k INT, v INT) WITH (fragment_size=5);");
+  g_sqlite_comparator.query("CREATE TABLE rjf_fact(k INT, v INT);");
+  run_ddl_statement("CREATE TABLE rjf_dim(k BIGINT, s INT) WITH (fragment_size=2);");
+  g_sqlite_comparator.query("CREATE TABLE rjf_dim(k BIGINT, s INT);");
+  // every fragment of the fact table covers a disjoint range of keys
+  for (int i = 0; i < 40; ++i) {
+    const std::string insert_query{"INSERT INTO rjf_fact VALUES(" + std::to_string(i) +
+                                   ", " + std::to_string(i % 3) + ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (const std::string values : {"(12, 1)", "(13, 2)", "(13, 3)", "(17, 4)"}) {
+    const std::string insert_query{"INSERT INTO rjf_dim VALUES" + values + ";"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable : {false, true}) {
+      g_enable_runtime_join_filters = enable;
+      c("SELECT COUNT(*) FROM rjf_fact f, rjf_dim d WHERE f.k = d.k;", dt);
+      c("SELECT SUM(f.v), SUM(d.s) FROM rjf_fact f JOIN rjf_dim d ON f.k = d.k;", dt);
+      c("SELECT f.k, d.s FROM rjf_fact f, rjf_dim d WHERE f.k = d.k AND d.s > 1 "
+        "ORDER BY f.k, d.s;",
+        dt);
+      c("SELECT f.k, d.s FROM rjf_fact f LEFT JOIN rjf_dim d ON f.k = d.k "
+        "ORDER BY f.k, d.s;",
+        dt);
+    }
+  }
+}
+
+TEST_F(Select, Joins_LoopJoinFragmentAlignment) {
+  auto drop_tables = [] {
+    for (const std::string table : {"ljfa_outer", "ljfa_inner"}) {
+      run_ddl_statement("DROP TABLE IF EXISTS " + table + ";");
+      g_sqlite_comparator.query("DROP TABLE IF EXISTS " + table + ";");
+    }
+  };
+  ScopeGuard reset = [orig = g_enable_loop_join_fragment_alignment, &drop_tables] {
+    g_enable_loop_join_fragment_alignment = orig;
+    drop_tables();
+  };
+  drop_tables();
+  run_ddl_statement("CREATE TABLE ljfa_outer(k INT, v INT) WITH (fragment_size=4);");
+  g_sqlite_comparator.query("CREATE TABLE ljfa_outer(k INT, v INT);");
+  run_ddl_statement("CREATE TABLE ljfa_inner(k BIGINT, s INT) WITH (fragment_size=3);");
+  g_sqlite_comparator.query("CREATE TABLE ljfa_inner(k BIGINT, s INT);");
+  // both tables are clustered on the join key
+  for (int i = 0; i < 24; ++i) {
+    const std::string insert_query{"INSERT INTO ljfa_outer VALUES(" +
+                                   std::to_string(i) + ", " + std::to_string(i % 5) +
+                                   ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (int i = 0; i < 30; i += 2) {
+    const std::string insert_query{"INSERT INTO ljfa_inner VALUES(" +
+                                   std::to_string(i) + ", " + std::to_string(i % 7) +
+                                   ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable : {false, true}) {
+      g_enable_loop_join_fragment_alignment = enable;
+      c("SELECT COUNT(*) FROM ljfa_outer o, ljfa_inner i WHERE o.k BETWEEN i.k - 2 AND "
+        "i.k + 1;",
+        dt);
+      c("SELECT o.k, i.k FROM ljfa_outer o JOIN ljfa_inner i ON o.k >= i.k + 3 AND "
+        "o.k < i.k + 5 ORDER BY o.k, i.k;",
+        dt);
+      c("SELECT SUM(o.v), SUM(i.s) FROM ljfa_outer o, ljfa_inner i WHERE o.k > i.k "
+        "AND o.k - 1 <= i.k;",
+        dt);
+      c("SELECT COUNT(*) FROM ljfa_outer o, ljfa_inner i WHERE o.k < i.k - 25;", dt);
+      // e.g., the outer fragment of keys [8, 11] only pairs with the second inner
+      // fragment of keys {6, 8, 10}
+      c("SELECT o.k, o.v, i.k, i.s FROM ljfa_outer o, ljfa_inner i WHERE o.k >= i.k AND "
+        "o.k <= i.k + 1 ORDER BY o.k, i.k;",
+        dt);
+      c("SELECT o.k, i.k, i.s FROM ljfa_outer o, ljfa_inner i WHERE o.k >= i.k AND "
+        "o.k <= i.k + 1 AND o.k BETWEEN 8 AND 11 ORDER BY o.k, i.k;",
+        dt);
+      c("SELECT o.k, i.k FROM ljfa_outer o LEFT JOIN ljfa_inner i ON o.k >= i.k AND "
+        "o.k < i.k + 1 ORDER BY o.k, i.k;",
+        dt);
+    }
+  }
+}
+
 TEST_F(Select, Joins_BuildHashTableFromTableWithNullValueOnly) {
   auto drop_tables = []() {
     run_ddl_statement("DROP TABLE IF EXISTS nt1;");
@@ -12814,6 +13300,31 @@ TEST_F(Select, Joins_LeftOuterJoin) {
   }
 }
 
+TEST_F(Select, Joins_LeftJoinLazyFetch) {
+  ScopeGuard reset_flag = [orig = g_enable_left_join_lazy_fetch] {
+    g_enable_left_join_lazy_fetch = orig;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable : {false, true}) {
+      g_enable_left_join_lazy_fetch = enable;
+      // the columns of the outer table are fetched only for the rows which survive the
+      // sort and the limit, the inner table may have no matching row
+      c("SELECT test.x, test.real_str, test.str, test.d, test_inner.str FROM test LEFT "
+        "JOIN test_inner ON test.x = test_inner.x ORDER BY test.x, test.real_str, "
+        "test.str, test.d LIMIT 5;",
+        dt);
+      c("SELECT a.x, a.real_str, b.str FROM test a LEFT JOIN join_test b ON a.str = "
+        "b.dup_str ORDER BY a.x, a.real_str, b.str IS NULL, b.str;",
+        dt);
+      c("SELECT test.real_str, test.y, test_inner.x FROM test JOIN test_inner ON "
+        "test.x = test_inner.x LEFT JOIN join_test ON test.str = join_test.dup_str "
+        "ORDER BY test.real_str, test.y, test_inner.x LIMIT 3;",
+        dt);
+    }
+  }
+}
+
 TEST_F(Select, Joins_LeftJoin_Filters) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -12986,6 +13497,89 @@ TEST_F(Select, Joins_LeftJoin_MultiQuals) {
   }
 }
 
+TEST_F(Select, Joins_RightOuterJoin) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    // right outer join runs as a left outer join of the swapped tables
+    c("select a,b,c,d,e,f from outer_join_foo right outer join outer_join_bar on a = d "
+      "order by a,b,c,d,e,f;",
+      "select a,b,c,d,e,f from outer_join_bar left outer join outer_join_foo on a = d "
+      "order by a,b,c,d,e,f;",
+      dt);
+    c("select d, count(*) from outer_join_foo right join outer_join_bar on b = e group "
+      "by d order by d;",
+      "select d, count(*) from outer_join_bar left join outer_join_foo on b = e group "
+      "by d order by d;",
+      dt);
+    c("select count(*), count(a), sum(f) from outer_join_foo right join outer_join_bar "
+      "on a = d and c < 5;",
+      "select count(*), count(a), sum(f) from outer_join_bar left join outer_join_foo "
+      "on a = d and c < 5;",
+      dt);
+    // the left input is a join, which runs as a separate step
+    const std::string inner_join_rows{
+        "(select t1.a as a1, t2.b as b2 from outer_join_foo t1 join outer_join_foo t2 on "
+        "t1.a = t2.a)"};
+    c("select t1.a, t2.b, d, e from (outer_join_foo t1 join outer_join_foo t2 on t1.a = "
+      "t2.a) right join outer_join_bar on t1.a = d order by t1.a, t2.b, d, e;",
+      "select a1, b2, d, e from outer_join_bar left join " + inner_join_rows +
+          " on a1 = d order by a1, b2, d, e;",
+      dt);
+    c("select count(*), count(t2.b), sum(f) from (outer_join_foo t1 join outer_join_foo "
+      "t2 on t1.a = t2.a) right join outer_join_bar on t2.b = e;",
+      "select count(*), count(b2), sum(f) from outer_join_bar left join " +
+          inner_join_rows + " on b2 = e;",
+      dt);
+  }
+}
+
+TEST_F(Select, Joins_FullOuterJoin) {
+  const std::string full_join_rows{
+      "(select a,b,c,d,e,f from outer_join_foo left outer join outer_join_bar on a = d "
+      "union all select null as a, null as b, null as c, d, e, f from outer_join_bar "
+      "where not exists (select * from outer_join_foo where a = d))"};
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    // the left join flags the matched rows of outer_join_bar, the unmatched ones are
+    // added afterwards
+    c("select a,b,c,d,e,f from outer_join_foo full outer join outer_join_bar on a = d "
+      "order by a,b,c,d,e,f;",
+      "select a,b,c,d,e,f from " + full_join_rows + " order by a,b,c,d,e,f;",
+      dt);
+    c("select a,b,c,d,e,f from outer_join_foo full outer join outer_join_bar on a = d "
+      "order by a,b,c,d,e,f limit 3 offset 1;",
+      "select a,b,c,d,e,f from " + full_join_rows +
+          " order by a,b,c,d,e,f limit 3 offset 1;",
+      dt);
+    c("select count(*), count(a), count(d), sum(c), sum(f) from outer_join_foo full "
+      "join outer_join_bar on a = d;",
+      "select count(*), count(a), count(d), sum(c), sum(f) from " + full_join_rows + ";",
+      dt);
+    c("select coalesce(a, d) as k, count(*) from outer_join_foo full join outer_join_bar "
+      "on a = d group by k order by k;",
+      "select coalesce(a, d) as k, count(*) from " + full_join_rows +
+          " group by k order by k;",
+      dt);
+    // the remaining join condition decides which inner rows are matched
+    c("select count(*), count(a), count(d) from outer_join_foo full join outer_join_bar "
+      "on a = d and c < f;",
+      "select count(*), count(a), count(d) from (select a, d from outer_join_foo left "
+      "join outer_join_bar on a = d and c < f union all select null as a, d from "
+      "outer_join_bar where not exists (select * from outer_join_foo where a = d and c "
+      "< f));",
+      dt);
+    // a join input runs as a separate step
+    c("select count(*), count(t1.a), count(d) from (outer_join_foo t1 join "
+      "outer_join_foo t2 on t1.a = t2.a) full join outer_join_bar on t1.a = d;",
+      "select count(*), count(a1), count(d) from (select a1, d from (select t1.a as a1 "
+      "from outer_join_foo t1 join outer_join_foo t2 on t1.a = t2.a) left join "
+      "outer_join_bar on a1 = d union all select null as a1, d from outer_join_bar where "
+      "not exists (select * from outer_join_foo t1 join outer_join_foo t2 on t1.a = t2.a "
+      "where t1.a = d));",
+      dt);
+  }
+}
+
 TEST_F(Select, Joins_OuterJoin_OptBy_NullRejection) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -13039,40 +13633,24 @@ TEST_F(Select, Joins_OuterJoin_OptBy_NullRejection) {
       "where b > 1 and c < 7 order by a,b,c,d,e,f;",
       dt);
 
-    //    d) expect to throw an error due to unsupported full outer join
-    //    --> we need a filter predicate in probe-side (i.e., outer) table
-    EXPECT_THROW(
-        run_multiple_agg(
-            "select a,b,c,d,e,f from outer_join_foo full outer join outer_join_bar on a "
-            "= d where d is not null and c < 2 order by a,b,c,d,e,f;",
-            dt),
-        std::runtime_error);
-    EXPECT_THROW(run_multiple_agg(
-                     "select a,b,c,d,e,f from outer_join_foo full outer join "
-                     "outer_join_bar on a = d where e is not null order by a,b,c,d,e,f;",
-                     dt),
-                 std::runtime_error);
-    EXPECT_THROW(
-        run_multiple_agg(
-            "select a,b,c,d,e,f from outer_join_foo full outer join outer_join_bar on a "
-            "= d where f is not null and e < 2 order by a,b,c,d,e,f;",
-            dt),
-        std::runtime_error);
-    EXPECT_THROW(
-        run_multiple_agg("select a,b,c,d,e,f from outer_join_foo full outer join "
-                         "outer_join_bar on a = d where c < 2 order by a,b,c,d,e,f;",
-                         dt),
-        std::runtime_error);
-    EXPECT_THROW(
-        run_multiple_agg("select a,b,c,d,e,f from outer_join_foo full outer join "
-                         "outer_join_bar on a = d where d < 5 order by a,b,c,d,e,f;",
-                         dt),
-        std::runtime_error);
-    EXPECT_THROW(
-        run_multiple_agg("select a,b,c,d,e,f from outer_join_foo full outer join "
-                         "outer_join_bar on a = d where e < 8 order by a,b,c,d,e,f;",
-                         dt),
-        std::runtime_error);
+    //    d) the filters don't reject the nulls of the probe-side (i.e., outer) table,
+    //    --> the full outer join runs as such
+    for (const std::string filter : {"d is not null and c < 2",
+                                     "e is not null",
+                                     "f is not null and e < 2",
+                                     "c < 2",
+                                     "d < 5",
+                                     "e < 8"}) {
+      c("select a,b,c,d,e,f from outer_join_foo full outer join outer_join_bar on a = d "
+        "where " +
+            filter + " order by a,b,c,d,e,f;",
+        "select a,b,c,d,e,f from (select a,b,c,d,e,f from outer_join_foo left outer join "
+        "outer_join_bar on a = d union all select null as a, null as b, null as c, d, "
+        "e, f from outer_join_bar where not exists (select * from outer_join_foo where "
+        "a = d)) where " +
+            filter + " order by a,b,c,d,e,f;",
+        dt);
+    }
 
     // 2. execute full outer join via inner join
     //    a) return zero matching row
@@ -13252,20 +13830,19 @@ TEST_F(Select, Joins_OuterJoin_OptBy_NullRejection) {
       "a,b,c,d,e,f;",
       dt);
 
-    //    d) expect to throw an error due to unsupported full outer join
-    //    --> we need a filter predicate in probe-side (i.e., outer) table
-    EXPECT_THROW(
-        run_multiple_agg(
-            "select a,b,c,d,e,f from outer_join_foo full outer join outer_join_bar on a "
-            "= d and c = f where d is not null and f < 2 order by a,b,c,d,e,f;",
-            dt),
-        std::runtime_error);
-    EXPECT_THROW(
-        run_multiple_agg(
-            "select a,b,c,d,e,f from outer_join_foo full outer join outer_join_bar on a "
-            "= d and c = f where a < 2 order by a,b,c,d,e,f;",
-            dt),
-        std::runtime_error);
+    //    d) the filters don't reject the nulls of the probe-side (i.e., outer) table,
+    //    --> the full outer join runs as such
+    for (const std::string filter : {"d is not null and f < 2", "a < 2"}) {
+      c("select a,b,c,d,e,f from outer_join_foo full outer join outer_join_bar on a = d "
+        "and c = f where " +
+            filter + " order by a,b,c,d,e,f;",
+        "select a,b,c,d,e,f from (select a,b,c,d,e,f from outer_join_foo left outer join "
+        "outer_join_bar on a = d and c = f union all select null as a, null as b, null "
+        "as c, d, e, f from outer_join_bar where not exists (select * from "
+        "outer_join_foo where a = d and c = f)) where " +
+            filter + " order by a,b,c,d,e,f;",
+        dt);
+    }
 
     // 2. execute full outer join via inner join
     //    a) return zero matching row
@@ -24,6 +24,8 @@
 #include "QueryEngine/JoinHashTable/BoundingBoxIntersectJoinHashTable.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/measure.h"
+#include "Shared/scope.h"
 #include "Shared/thread_count.h"
 #include "TestHelpers.h"
 
@@ -49,6 +51,9 @@ using namespace TestHelpers;
 
 using QR = QueryRunner::QueryRunner;
 
+extern bool g_enable_radix_partitioned_hash_join_build;
+extern size_t g_radix_partitioned_hash_join_build_threshold;
+
 namespace {
 ExecutorDeviceType g_device_type;
 }
@@ -580,6 +585,71 @@ TEST_F(Build, KeyedOneToMany) {
   }
 }
 
+TEST_F(Build, KeyedRadixPartitioned) {
+  auto catalog = QR::get()->getCatalog();
+  CHECK(catalog);
+
+  ScopeGuard reset = [enable = g_enable_radix_partitioned_hash_join_build,
+                      threshold = g_radix_partitioned_hash_join_build_threshold] {
+    g_enable_radix_partitioned_hash_join_build = enable;
+    g_radix_partitioned_hash_join_build_threshold = threshold;
+    sql(R"(
+      drop table if exists radix_outer;
+      drop table if exists radix_inner;
+    )");
+  };
+
+  // the radix partitioned build is CPU only
+  g_device_type = ExecutorDeviceType::CPU;
+  constexpr size_t num_rows{2000000};
+  sql(R"(
+    drop table if exists radix_outer;
+    drop table if exists radix_inner;
+    create table radix_outer (a1 bigint, a2 bigint);
+  )");
+  sql("create table radix_inner as select generate_series as b1, mod(generate_series, "
+      "1000) as b2, mod(generate_series, " +
+      std::to_string(num_rows / 4) + ") as b3 from table(generate_series(1, " +
+      std::to_string(num_rows) + "));");
+
+  auto a1 = getSyntheticColumnVar("radix_outer", "a1", 0, *catalog);
+  auto a2 = getSyntheticColumnVar("radix_outer", "a2", 0, *catalog);
+  using VE = std::vector<std::shared_ptr<Analyzer::Expr>>;
+  auto et1 = std::make_shared<Analyzer::ExpressionTuple>(VE{a1, a2});
+
+  for (const auto& [key_col, hash_type] :
+       {std::make_pair("b1", HashType::OneToOne),
+        std::make_pair("b3", HashType::OneToMany)}) {
+    auto k1 = getSyntheticColumnVar("radix_inner", key_col, 1, *catalog);
+    auto k2 = getSyntheticColumnVar("radix_inner", "b2", 1, *catalog);
+    auto et2 = std::make_shared<Analyzer::ExpressionTuple>(VE{k1, k2});
+    auto op = std::make_shared<Analyzer::BinOper>(kBOOLEAN, kEQ, kONE, et1, et2);
+
+    DecodedJoinHashBufferSet expected;
+    for (bool partitioned : {false, true}) {
+      JoinHashTableCacheInvalidator::invalidateCaches();
+      g_enable_radix_partitioned_hash_join_build = partitioned;
+      // partition every build, regardless of the size of the last level cache
+      g_radix_partitioned_hash_join_build_threshold = 1;
+      auto clock_begin = timer_start();
+      auto hash_table = buildKeyed(op);
+      const auto build_ms = timer_stop(clock_begin);
+      LOG(INFO) << "Built " << HashJoin::getHashTypeString(hash_type)
+                << " baseline hash table of " << num_rows << " rows "
+                << (partitioned ? "with" : "without") << " radix partitioning in "
+                << build_ms << " ms";
+      EXPECT_EQ(hash_table->getHashType(), hash_type);
+      auto s = hash_table->toSet(g_device_type, 0);
+      EXPECT_EQ(s.size(), hash_type == HashType::OneToOne ? num_rows : num_rows / 4);
+      if (partitioned) {
+        EXPECT_EQ(expected, s);
+      } else {
+        expected = std::move(s);
+      }
+    }
+  }
+}
+
 TEST_F(Build, GeoOneToMany1) {
   auto catalog = QR::get()->getCatalog();
   CHECK(catalog);
@@ -1818,6 +1818,124 @@ TEST(Reduce, BaselineHashColumnar) {
   test_reduce(target_infos, query_mem_desc, generator1, generator2, 1, true);
 }
 
+namespace {
+
+std::vector<std::shared_ptr<ResultSet>> make_partial_result_sets(
+    const std::vector<TargetInfo>& target_infos,
+    const QueryMemoryDescriptor& query_mem_desc,
+    const std::shared_ptr<RowSetMemoryOwner>& row_set_mem_owner,
+    const size_t partial_count) {
+  std::vector<std::shared_ptr<ResultSet>> result_sets;
+  for (size_t i = 0; i < partial_count; ++i) {
+    auto rs = std::make_shared<ResultSet>(
+        target_infos, ExecutorDeviceType::CPU, query_mem_desc, row_set_mem_owner, 0, 0);
+    const auto storage = rs->allocateStorage();
+    EvenNumberGenerator generator;
+    fill_storage_buffer(
+        storage->getUnderlyingBuffer(), target_infos, query_mem_desc, generator, 2);
+    result_sets.push_back(std::move(rs));
+  }
+  return result_sets;
+}
+
+// Reduces the same partial results sequentially and with a tree or partitioned
+// reduction and checks that both produce the same groups
+void test_parallel_reduce(const std::vector<TargetInfo>& target_infos,
+                          const QueryMemoryDescriptor& query_mem_desc,
+                          const size_t partial_count,
+                          const bool partitioned) {
+  const auto row_set_mem_owner = std::make_shared<RowSetMemoryOwner>(
+      Executor::getArenaBlockSize(), Executor::UNITARY_EXECUTOR_ID);
+  auto sequential_partials = make_partial_result_sets(
+      target_infos, query_mem_desc, row_set_mem_owner, partial_count);
+  const auto parallel_partials = make_partial_result_sets(
+      target_infos, query_mem_desc, row_set_mem_owner, partial_count);
+
+  std::vector<ResultSet*> storage_set;
+  for (const auto& rs : sequential_partials) {
+    storage_set.push_back(rs.get());
+  }
+  ResultSetManager rs_manager;
+  auto timer = timer_start();
+  auto sequential_rs = rs_manager.reduce(storage_set, Executor::UNITARY_EXECUTOR_ID);
+  const auto sequential_ms = timer_stop(timer);
+
+  ResultSetReductionJIT reduction_jit(parallel_partials.front()->getQueryMemDesc(),
+                                      parallel_partials.front()->getTargetInfos(),
+                                      parallel_partials.front()->getTargetInitVals(),
+                                      Executor::UNITARY_EXECUTOR_ID);
+  const auto reduction_code = reduction_jit.codegen();
+  timer = timer_start();
+  const auto parallel_rs =
+      partitioned ? ResultSetManager::reducePartitioned(
+                        parallel_partials, reduction_code, Executor::UNITARY_EXECUTOR_ID)
+                  : ResultSetManager::reduceTree(
+                        parallel_partials, reduction_code, Executor::UNITARY_EXECUTOR_ID);
+  const auto parallel_ms = timer_stop(timer);
+  LOG(INFO) << "Reduced " << partial_count << " partial results with "
+            << query_mem_desc.getEntryCount() << " entries each: sequential "
+            << sequential_ms << " ms, " << (partitioned ? "partitioned " : "tree ")
+            << parallel_ms << " ms";
+
+  const auto sequential_rows = get_rows_sorted_by_col(*sequential_rs, 0);
+  const auto parallel_rows = get_rows_sorted_by_col(*parallel_rs, 0);
+  ASSERT_EQ(sequential_rows.size(), parallel_rows.size());
+  for (size_t row_idx = 0; row_idx < sequential_rows.size(); ++row_idx) {
+    ASSERT_EQ(target_infos.size(), parallel_rows[row_idx].size());
+    for (size_t i = 0; i < target_infos.size(); ++i) {
+      if (target_infos[i].agg_kind == kAVG) {
+        ASSERT_DOUBLE_EQ(v<double>(sequential_rows[row_idx][i]),
+                         v<double>(parallel_rows[row_idx][i]));
+      } else {
+        ASSERT_EQ(v<int64_t>(sequential_rows[row_idx][i]),
+                  v<int64_t>(parallel_rows[row_idx][i]));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ReduceTree, PerfectHash) {
+  const auto target_infos = generate_random_groups_nullable_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
+  test_parallel_reduce(target_infos, query_mem_desc, 7, false);
+}
+
+TEST(ReduceTree, BaselineHash) {
+  const auto target_infos = generate_random_groups_nullable_target_infos();
+  const auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8);
+  test_parallel_reduce(target_infos, query_mem_desc, 7, false);
+}
+
+TEST(ReduceTree, BaselineHashColumnar) {
+  const auto target_infos = generate_random_groups_nullable_target_infos();
+  auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8);
+  query_mem_desc.setOutputColumnar(true);
+  test_parallel_reduce(target_infos, query_mem_desc, 5, false);
+}
+
+// Many small partial results, i.e. a high cardinality group by over many kernels, where
+// every single pairwise reduction is too small to be split across threads
+TEST(ReduceTree, PerfectHashBenchmark) {
+  const auto target_infos = generate_random_groups_nullable_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 49999);
+  test_parallel_reduce(target_infos, query_mem_desc, 64, false);
+}
+
+TEST(ReducePartitioned, BaselineHash) {
+  const auto target_infos = generate_random_groups_nullable_target_infos();
+  const auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8);
+  test_parallel_reduce(target_infos, query_mem_desc, 7, true);
+}
+
+TEST(ReducePartitioned, BaselineHashBenchmark) {
+  const auto target_infos = generate_random_groups_nullable_target_infos();
+  auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8);
+  query_mem_desc.setEntryCount(200'000);
+  test_parallel_reduce(target_infos, query_mem_desc, 16, true);
+}
+
 #ifndef HAVE_TSAN
 // The large buffers tests allocate too much memory to instrument under TSAN
 TEST(ReduceLargeBuffers, PerfectHashOne_Overflow32) {
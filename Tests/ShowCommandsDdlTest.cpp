@@ -1701,7 +1701,17 @@ TEST_F(SystemTablesShowCreateTableTest, StorageDetails) {
         "total_data_page_count BIGINT,\n  total_free_data_page_count BIGINT,\n  "
         "total_metadata_file_size BIGINT,\n  total_metadata_page_count BIGINT,\n  "
         "total_free_metadata_page_count BIGINT,\n  total_dictionary_data_file_size "
-        "BIGINT);"}});
+        "BIGINT,\n  dictionary_compression_ratio DOUBLE);"}});
+}
+
+TEST_F(SystemTablesShowCreateTableTest, StringDictionaryCaches) {
+  sqlAndCompareResult(
+      "SHOW CREATE TABLE string_dictionary_caches;",
+      {{"CREATE TABLE string_dictionary_caches (\n  node TEXT ENCODING DICT(32),\n  "
+        "database_id INTEGER,\n  database_name TEXT ENCODING DICT(32),\n  "
+        "dictionary_id INTEGER,\n  entry_count BIGINT,\n  cache_size BIGINT,\n  "
+        "max_cache_size BIGINT,\n  hit_count BIGINT,\n  miss_count BIGINT,\n  "
+        "eviction_count BIGINT);"}});
 }
 
 TEST_F(SystemTablesShowCreateTableTest, ExecutorPoolSummary) {
@@ -4587,6 +4597,34 @@ TEST_F(SystemTablesTest, MemoryDetailsSystemTableGpu) {
   // clang-format on
 }
 
+TEST_F(SystemTablesTest, StringDictionaryCaches) {
+  if (isDistributedMode()) {
+    GTEST_SKIP() << "String dictionary caches are kept by the string dictionary server";
+  }
+  switchToAdmin();
+  sql("CREATE TABLE test_table (t TEXT ENCODING DICT(32));");
+  sql("INSERT INTO test_table VALUES ('abc');");
+  sql("INSERT INTO test_table VALUES ('abd');");
+  sql("INSERT INTO test_table VALUES ('xyz');");
+  sqlAndCompareResult("SELECT COUNT(*) FROM test_table WHERE t LIKE 'ab%';", {{i(2)}});
+  sqlAndCompareResult("SELECT t FROM test_table WHERE t LIKE 'ab%' ORDER BY t;",
+                      {{"abc"}, {"abd"}});
+
+  const auto db_id = getDbId(shared::kDefaultDbName);
+  const auto cd = getCatalog().getMetadataForColumn(getTableId("test_table"), "t");
+  ASSERT_NE(cd, nullptr);
+  const auto dict_id = cd->columnType.getStringDictKey().dict_id;
+
+  loginInformationSchema();
+  sqlAndCompareResult(
+      "SELECT database_name, entry_count, miss_count, hit_count > 0, eviction_count, "
+      "cache_size > 0, cache_size <= max_cache_size FROM string_dictionary_caches "
+      "WHERE database_id = " +
+          std::to_string(db_id) + " AND dictionary_id = " + std::to_string(dict_id) +
+          ";",
+      {{shared::kDefaultDbName, i(1), i(1), True, i(0), True, True}});
+}
+
 TEST_F(SystemTablesTest, SystemTablesJoin) {
   if (isDistributedMode()) {
     // Right now distributed joins must be performed on replicated tables, or tables that
@@ -4808,6 +4846,7 @@ struct StorageDetailsResult {
   int64_t total_metadata_page_count{PAGES_PER_METADATA_FILE};
   int64_t total_free_metadata_page_count{PAGES_PER_METADATA_FILE};
   int64_t total_dictionary_data_file_size{0};
+  NullableTargetValue dictionary_compression_ratio{Null};
 
   std::vector<NullableTargetValue> asTargetValuesSkipNode() const {
     return std::vector<NullableTargetValue>{database_id,
@@ -4826,7 +4865,8 @@ struct StorageDetailsResult {
                                             total_metadata_file_size,
                                             total_metadata_page_count,
                                             total_free_metadata_page_count,
-                                            total_dictionary_data_file_size};
+                                            total_dictionary_data_file_size,
+                                            dictionary_compression_ratio};
   }
 };
 
@@ -4842,7 +4882,8 @@ class StorageDetailsSystemTableTest : public SystemTablesTest,
            "data_file_count, metadata_file_count, total_data_file_size, "
            "total_data_page_count, total_free_data_page_count, total_metadata_file_size, "
            "total_metadata_page_count, total_free_metadata_page_count, "
-           "total_dictionary_data_file_size FROM storage_details WHERE database_id <> " +
+           "total_dictionary_data_file_size, dictionary_compression_ratio FROM "
+           "storage_details WHERE database_id <> " +
            std::to_string(getDbId(shared::kDefaultDbName)) + " ORDER BY table_id, " +
            order_by_col + ";";
   }
@@ -4881,7 +4922,8 @@ class StorageDetailsSystemTableTest : public SystemTablesTest,
                                            result.total_metadata_file_size,
                                            result.total_metadata_page_count,
                                            result.total_free_metadata_page_count,
-                                           result.total_dictionary_data_file_size});
+                                           result.total_dictionary_data_file_size,
+                                           result.dictionary_compression_ratio});
     }
     loginInformationSchema();
     // Skip the shared::kDefaultDbName database, since it can contain default
@@ -17,6 +17,7 @@
 #include "TestHelpers.h"
 
 #include "Shared/funcannotations.h"
+#include "Shared/scope.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 
 #include <boost/lexical_cast.hpp>
@@ -136,7 +137,8 @@ TEST_F(StringDictionaryTest, GetStringViews) {
   }
   string_dict->getOrAddBulk(strings, string_ids.data());
 
-  const auto string_views = string_dict->getStringViews();
+  std::string decoded_payload;
+  const auto string_views = string_dict->getStringViews(decoded_payload);
   ASSERT_EQ(string_views.size(), static_cast<size_t>(g_op_count));
   for (int i = 0; i < g_op_count; ++i) {
     ASSERT_EQ(strings[i], std::string(string_views[i]));
@@ -311,6 +313,336 @@ TEST_F(StringDictionaryTest, BuildTranslationMap) {
   }
 }
 
+TEST_F(StringDictionaryTest, PersistedTranslationMap) {
+  const DictRef dict_ref1(-1, 1);
+  const DictRef dict_ref2(-1, 2);
+  auto source_string_dict = std::make_shared<StringDictionary>(
+      dict_ref1, BASE_PATH1, false, false, g_cache_string_hash);
+  auto dest_string_dict = std::make_shared<StringDictionary>(
+      dict_ref2, BASE_PATH2, false, false, g_cache_string_hash);
+  auto add_strings = [](StringDictionary& string_dict, int start, int end, int step) {
+    std::vector<std::string> strings;
+    for (int i = start; i < end; i += step) {
+      strings.emplace_back(std::to_string(i));
+    }
+    std::vector<int32_t> string_ids(strings.size());
+    string_dict.getOrAddBulk(strings, string_ids.data());
+  };
+  auto dummy_callback = [](const std::string_view& source_string,
+                           const int32_t source_string_id) { return false; };
+  // Translations through the persisted map must match probing the destination
+  auto check_translation = [&](const DictionaryTranslationMap& persisted_map,
+                               const int64_t source_generation,
+                               const int64_t dest_generation) {
+    std::vector<int32_t> expected_ids(source_generation);
+    std::vector<int32_t> translated_ids(source_generation);
+    const auto expected_num_not_translated =
+        source_string_dict->buildDictionaryTranslationMap(dest_string_dict.get(),
+                                                          expected_ids.data(),
+                                                          source_generation,
+                                                          dest_generation,
+                                                          false,
+                                                          dummy_callback,
+                                                          {});
+    const auto num_not_translated =
+        source_string_dict->buildDictionaryTranslationMap(dest_string_dict.get(),
+                                                          translated_ids.data(),
+                                                          source_generation,
+                                                          dest_generation,
+                                                          false,
+                                                          dummy_callback,
+                                                          {},
+                                                          &persisted_map);
+    ASSERT_EQ(num_not_translated, expected_num_not_translated);
+    ASSERT_EQ(translated_ids, expected_ids);
+  };
+
+  add_strings(*source_string_dict, 0, g_op_count, 1);
+  add_strings(*dest_string_dict, 0, g_op_count, 2);
+  DictionaryTranslationMap persisted_map(source_string_dict, dest_string_dict);
+  ASSERT_TRUE(persisted_map.isTranslationBetween(source_string_dict.get(),
+                                                 dest_string_dict.get()));
+  source_string_dict->updateDictionaryTranslationMap(dest_string_dict.get(),
+                                                     persisted_map);
+  check_translation(persisted_map,
+                    source_string_dict->storageEntryCount(),
+                    dest_string_dict->storageEntryCount());
+
+  // Grow both dictionaries: the odd strings now resolve against the destination, and new
+  // source strings are partially present in it
+  const auto old_source_count = source_string_dict->storageEntryCount();
+  const auto old_dest_count = dest_string_dict->storageEntryCount();
+  add_strings(*dest_string_dict, 1, g_op_count + 100, 2);
+  add_strings(*source_string_dict, g_op_count, g_op_count + 200, 1);
+  source_string_dict->updateDictionaryTranslationMap(dest_string_dict.get(),
+                                                     persisted_map);
+  check_translation(persisted_map,
+                    source_string_dict->storageEntryCount(),
+                    dest_string_dict->storageEntryCount());
+  // Older generations are served from the same map
+  check_translation(persisted_map, old_source_count, old_dest_count);
+}
+
+TEST_F(StringDictionaryTest, PersistedTranslationMapWithStringOps) {
+  const DictRef dict_ref1(-1, 1);
+  const DictRef dict_ref2(-1, 2);
+  auto source_string_dict = std::make_shared<StringDictionary>(
+      dict_ref1, BASE_PATH1, false, false, g_cache_string_hash);
+  auto dest_string_dict = std::make_shared<StringDictionary>(
+      dict_ref2, BASE_PATH2, false, false, g_cache_string_hash);
+  auto add_strings = [](StringDictionary& string_dict,
+                        const std::string& prefix,
+                        int start,
+                        int end,
+                        int step) {
+    std::vector<std::string> strings;
+    for (int i = start; i < end; i += step) {
+      strings.emplace_back(prefix + std::to_string(i));
+    }
+    std::vector<int32_t> string_ids(strings.size());
+    string_dict.getOrAddBulk(strings, string_ids.data());
+  };
+  auto dummy_callback = [](const std::string_view& source_string,
+                           const int32_t source_string_id) { return false; };
+  const std::vector<StringOps_Namespace::StringOpInfo> string_op_infos{
+      StringOps_Namespace::StringOpInfo(SqlStringOpKind::LOWER, SQLTypeInfo(kTEXT), {})};
+  auto check_translation = [&](const StringDictionary* dest_dict,
+                               const DictionaryTranslationMap& persisted_map) {
+    const auto source_generation = source_string_dict->storageEntryCount();
+    const auto dest_generation = dest_dict->storageEntryCount();
+    std::vector<int32_t> expected_ids(source_generation);
+    std::vector<int32_t> translated_ids(source_generation);
+    const auto expected_num_not_translated =
+        source_string_dict->buildDictionaryTranslationMap(dest_dict,
+                                                          expected_ids.data(),
+                                                          source_generation,
+                                                          dest_generation,
+                                                          false,
+                                                          dummy_callback,
+                                                          string_op_infos);
+    const auto num_not_translated =
+        source_string_dict->buildDictionaryTranslationMap(dest_dict,
+                                                          translated_ids.data(),
+                                                          source_generation,
+                                                          dest_generation,
+                                                          false,
+                                                          dummy_callback,
+                                                          string_op_infos,
+                                                          &persisted_map);
+    ASSERT_EQ(num_not_translated, expected_num_not_translated);
+    ASSERT_EQ(translated_ids, expected_ids);
+  };
+
+  add_strings(*source_string_dict, "Str_", 0, g_op_count, 1);
+  add_strings(*dest_string_dict, "str_", 0, g_op_count, 2);
+  DictionaryTranslationMap persisted_map(
+      source_string_dict, dest_string_dict, string_op_infos);
+  ASSERT_FALSE(persisted_map.isTranslationBetween(source_string_dict.get(),
+                                                  dest_string_dict.get()));
+  ASSERT_TRUE(persisted_map.isTranslationBetween(
+      source_string_dict.get(), dest_string_dict.get(), string_op_infos));
+  source_string_dict->updateDictionaryTranslationMap(dest_string_dict.get(),
+                                                     persisted_map);
+  check_translation(dest_string_dict.get(), persisted_map);
+
+  // Destination growth re-probes the cached transformed strings
+  add_strings(*dest_string_dict, "str_", 1, g_op_count + 100, 2);
+  add_strings(*source_string_dict, "STR_", g_op_count, g_op_count + 200, 1);
+  source_string_dict->updateDictionaryTranslationMap(dest_string_dict.get(),
+                                                     persisted_map);
+  check_translation(dest_string_dict.get(), persisted_map);
+
+  // Translating a dictionary onto itself through string ops
+  DictionaryTranslationMap self_map(
+      source_string_dict, source_string_dict, string_op_infos);
+  source_string_dict->updateDictionaryTranslationMap(source_string_dict.get(), self_map);
+  check_translation(source_string_dict.get(), self_map);
+}
+
+TEST_F(StringDictionaryTest, CompressedPayload) {
+  ScopeGuard reset_compression = [orig = g_enable_stringdict_compression] {
+    g_enable_stringdict_compression = orig;
+  };
+  g_enable_stringdict_compression = true;
+  const DictRef dict_ref(-1, 2);
+  std::vector<std::string> strings;
+  strings.reserve(g_op_count);
+  for (int i = 0; i < g_op_count; ++i) {
+    strings.emplace_back("https://www.heavy.ai/docs/latest/" + std::to_string(i) +
+                         "/index.html");
+  }
+  std::vector<int32_t> string_ids(g_op_count);
+  {
+    StringDictionary string_dict(dict_ref, BASE_PATH2, false, false, g_cache_string_hash);
+    ASSERT_TRUE(string_dict.isPayloadCompressed());
+    string_dict.getOrAddBulk(strings, string_ids.data());
+    for (int i = 0; i < g_op_count; ++i) {
+      ASSERT_EQ(i, string_ids[i]);
+      ASSERT_EQ(strings[i], string_dict.getString(i));
+      ASSERT_EQ(strings[i], string_dict.getStringView(i));
+      ASSERT_EQ(i, string_dict.getIdOfString(strings[i]));
+    }
+    // Strings not seen during training, including non-ASCII bytes, must round trip
+    const std::string unseen_str{"ftp://übung.example/straße"};
+    const auto unseen_id = string_dict.getOrAdd(unseen_str);
+    ASSERT_EQ(g_op_count, unseen_id);
+    ASSERT_EQ(unseen_str, string_dict.getString(unseen_id));
+    const auto stats = string_dict.getPayloadCompressionStats();
+    ASSERT_TRUE(stats.has_value());
+    ASSERT_GT(stats->compressionRatio(), 1.0);
+    ASSERT_TRUE(string_dict.checkpoint());
+  }
+  // The stored symbol table is honored on recovery regardless of the flag
+  g_enable_stringdict_compression = false;
+  std::shared_ptr<StringDictionary> string_dict = std::make_shared<StringDictionary>(
+      dict_ref, BASE_PATH2, false, true, g_cache_string_hash);
+  ASSERT_TRUE(string_dict->isPayloadCompressed());
+  ASSERT_EQ(static_cast<size_t>(g_op_count + 1), string_dict->storageEntryCount());
+  std::vector<int32_t> lookup_ids(g_op_count);
+  ASSERT_EQ(size_t(0), string_dict->getBulk(strings, lookup_ids.data()));
+  ASSERT_EQ(string_ids, lookup_ids);
+  std::string decoded_payload;
+  const auto string_views = string_dict->getStringViews(decoded_payload);
+  for (int i = 0; i < g_op_count; ++i) {
+    ASSERT_EQ(strings[i], string_views[i]);
+  }
+  // the views point into the caller's buffer rather than the dictionary's storage
+  ASSERT_FALSE(decoded_payload.empty());
+  ASSERT_EQ(decoded_payload.data(), string_views[0].data());
+
+  // Translating to an uncompressed dictionary must match on the decoded strings
+  std::shared_ptr<StringDictionary> dest_string_dict = std::make_shared<StringDictionary>(
+      DictRef(-1, 1), BASE_PATH1, false, false, g_cache_string_hash);
+  ASSERT_FALSE(dest_string_dict->isPayloadCompressed());
+  std::vector<std::string> reversed_strings(strings.rbegin(), strings.rend());
+  std::vector<int32_t> reversed_string_ids(g_op_count);
+  dest_string_dict->getOrAddBulk(reversed_strings, reversed_string_ids.data());
+  auto dummy_callback = [](const std::string_view& source_string,
+                           const int32_t source_string_id) { return false; };
+  const auto translated_ids =
+      string_dict->buildDictionaryTranslationMap(dest_string_dict, dummy_callback);
+  for (int32_t idx = 0; idx < g_op_count; ++idx) {
+    ASSERT_EQ(g_op_count - idx - 1, translated_ids[idx]);
+  }
+  ASSERT_EQ(StringDictionary::INVALID_STR_ID, translated_ids[g_op_count]);
+}
+
+TEST_F(StringDictionaryTest, CompressedPayloadOnlyForNewDictionaries) {
+  ScopeGuard reset_compression = [orig = g_enable_stringdict_compression] {
+    g_enable_stringdict_compression = orig;
+  };
+  const DictRef dict_ref(-1, 1);
+  const std::vector<std::string> strings{"alpha", "beta", "gamma"};
+  std::vector<int32_t> string_ids(strings.size());
+  {
+    g_enable_stringdict_compression = false;
+    StringDictionary string_dict(dict_ref, BASE_PATH1, false, false, g_cache_string_hash);
+    string_dict.getOrAddBulk(strings, string_ids.data());
+    ASSERT_TRUE(string_dict.checkpoint());
+  }
+  // A dictionary that already holds an uncompressed payload keeps it
+  g_enable_stringdict_compression = true;
+  StringDictionary string_dict(dict_ref, BASE_PATH1, false, true, g_cache_string_hash);
+  ASSERT_FALSE(string_dict.isPayloadCompressed());
+  const std::vector<std::string> more_strings{"beta", "delta"};
+  std::vector<int32_t> more_string_ids(more_strings.size());
+  string_dict.getOrAddBulk(more_strings, more_string_ids.data());
+  ASSERT_EQ(string_ids[1], more_string_ids[0]);
+  ASSERT_EQ(3, more_string_ids[1]);
+  for (size_t i = 0; i < strings.size(); ++i) {
+    ASSERT_EQ(string_ids[i], string_dict.getIdOfString(strings[i]));
+  }
+
+  // A new dictionary whose first string is added on its own has no sample to train a
+  // symbol table on, so it stays uncompressed too
+  StringDictionary single_add_dict(
+      DictRef(-1, 2), BASE_PATH2, false, false, g_cache_string_hash);
+  ASSERT_TRUE(single_add_dict.isPayloadCompressed());
+  ASSERT_EQ(0, single_add_dict.getOrAdd("alpha"));
+  ASSERT_FALSE(single_add_dict.isPayloadCompressed());
+  std::vector<int32_t> single_add_ids(strings.size());
+  single_add_dict.getOrAddBulk(strings, single_add_ids.data());
+  ASSERT_EQ(std::vector<int32_t>({0, 1, 2}), single_add_ids);
+}
+
+TEST_F(StringDictionaryTest, QueryCacheEviction) {
+  ScopeGuard reset_cache_size = [orig = g_stringdict_query_cache_size] {
+    g_stringdict_query_cache_size = orig;
+  };
+  g_stringdict_query_cache_size = 2048;
+  const DictRef dict_ref(-1, 1);
+  StringDictionary string_dict(dict_ref, BASE_PATH1, false, false, g_cache_string_hash);
+  constexpr int32_t num_strings{1000};
+  for (int32_t i = 0; i < num_strings; ++i) {
+    ASSERT_EQ(i, string_dict.getOrAdd("str_" + std::to_string(i)));
+  }
+
+  // Every pattern matches 111 ids, so only a few results fit in the cache at once
+  for (int32_t digit = 1; digit <= 9; ++digit) {
+    const auto pattern = "str_" + std::to_string(digit) + "%";
+    const auto ids = string_dict.getLike<int32_t>(pattern, false, false, '\\', num_strings);
+    ASSERT_EQ(size_t(111), ids.size());
+    ASSERT_EQ(ids, string_dict.getLike<int32_t>(pattern, false, false, '\\', num_strings));
+  }
+  auto stats = string_dict.getQueryCacheStats();
+  ASSERT_EQ(size_t(9), stats.miss_count);
+  ASSERT_EQ(size_t(9), stats.hit_count);
+  ASSERT_GT(stats.eviction_count, size_t(0));
+  ASSERT_LT(stats.entry_count, size_t(9));
+  ASSERT_LE(stats.size_in_bytes, g_stringdict_query_cache_size);
+  ASSERT_LE(stats.size_in_bytes, string_dict.computeCacheSize());
+
+  // The least recently used result was evicted and has to be recomputed
+  string_dict.getLike<int32_t>("str_1%", false, false, '\\', num_strings);
+  ASSERT_EQ(size_t(10), string_dict.getQueryCacheStats().miss_count);
+
+  // Adding strings invalidates cached results
+  const auto new_id = string_dict.getOrAdd("str_1_new");
+  stats = string_dict.getQueryCacheStats();
+  ASSERT_EQ(size_t(0), stats.entry_count);
+  ASSERT_EQ(size_t(0), stats.size_in_bytes);
+  const auto ids = string_dict.getLike<int32_t>("str_1%", false, false, '\\', new_id + 1);
+  ASSERT_EQ(size_t(112), ids.size());
+  ASSERT_EQ(new_id, ids.back());
+}
+
+TEST_F(StringDictionaryTest, QueryCacheSharedBudget) {
+  ScopeGuard reset_cache_size = [orig = g_stringdict_query_cache_size] {
+    g_stringdict_query_cache_size = orig;
+  };
+  g_stringdict_query_cache_size = 2048;
+  StringDictionary first_dict(
+      DictRef(-1, 1), BASE_PATH1, false, false, g_cache_string_hash);
+  StringDictionary second_dict(
+      DictRef(-1, 2), BASE_PATH2, false, false, g_cache_string_hash);
+  constexpr int32_t num_strings{1000};
+  for (int32_t i = 0; i < num_strings; ++i) {
+    ASSERT_EQ(i, first_dict.getOrAdd("str_" + std::to_string(i)));
+    ASSERT_EQ(i, second_dict.getOrAdd("str_" + std::to_string(i)));
+  }
+
+  // Both dictionaries charge their results to the same budget, so the results of the
+  // second one evict the least recently used results of the first one
+  for (int32_t digit = 1; digit <= 3; ++digit) {
+    const auto pattern = "str_" + std::to_string(digit) + "%";
+    first_dict.getLike<int32_t>(pattern, false, false, '\\', num_strings);
+  }
+  const auto first_size = first_dict.getQueryCacheStats().size_in_bytes;
+  ASSERT_GT(first_size, size_t(0));
+  for (int32_t digit = 1; digit <= 3; ++digit) {
+    const auto pattern = "str_" + std::to_string(digit) + "%";
+    second_dict.getLike<int32_t>(pattern, false, false, '\\', num_strings);
+  }
+  const auto first_stats = first_dict.getQueryCacheStats();
+  const auto second_stats = second_dict.getQueryCacheStats();
+  ASSERT_GT(first_stats.eviction_count, size_t(0));
+  ASSERT_LT(first_stats.size_in_bytes, first_size);
+  ASSERT_GT(second_stats.entry_count, size_t(0));
+  ASSERT_LE(first_stats.size_in_bytes + second_stats.size_in_bytes,
+            DictionaryQueryCache::getTotalSizeInBytes());
+  ASSERT_LE(DictionaryQueryCache::getTotalSizeInBytes(), g_stringdict_query_cache_size);
+}
+
 static shared::StringDictKey test_source_dict_key{1, 1};
 static shared::StringDictKey test_dest_dict_key{1, 2};
 
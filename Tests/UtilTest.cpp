@@ -175,6 +175,26 @@ TEST(Utils, StringLike) {
   ASSERT_TRUE(string_like("hello [", 7, "%\\[%", 4, '\\'));
 }
 
+TEST(Utils, StringLikeAnchored) {
+  ASSERT_TRUE(string_like_simple("abcxyzefg", 9, "xyz", 3, '\\'));
+  ASSERT_TRUE(string_like_simple("xxxxxy", 6, "xxy", 3, '\\'));
+  ASSERT_FALSE(string_like_simple("abcxyzefg", 9, "xyzz", 4, '\\'));
+  ASSERT_FALSE(string_like_simple("ab", 2, "abc", 3, '\\'));
+  ASSERT_TRUE(string_like_prefix("abcxyz", 6, "abc", 3, '\\'));
+  ASSERT_FALSE(string_like_prefix("abcxyz", 6, "xyz", 3, '\\'));
+  ASSERT_FALSE(string_like_prefix("ab", 2, "abc", 3, '\\'));
+  ASSERT_TRUE(string_ilike_prefix("ABCxyz", 6, "abc", 3, '\\'));
+  ASSERT_TRUE(string_like_suffix("abcxyz", 6, "xyz", 3, '\\'));
+  ASSERT_FALSE(string_like_suffix("abcxyz", 6, "abc", 3, '\\'));
+  ASSERT_TRUE(string_ilike_suffix("abcXYZ", 6, "xyz", 3, '\\'));
+  ASSERT_TRUE(string_like_exact("abc", 3, "abc", 3, '\\'));
+  ASSERT_FALSE(string_like_exact("abcd", 4, "abc", 3, '\\'));
+  ASSERT_TRUE(string_ilike_exact("AbC", 3, "abc", 3, '\\'));
+  ASSERT_TRUE(string_eq("abc", 3, "abc", 3));
+  ASSERT_FALSE(string_eq("abc", 3, "abd", 3));
+  ASSERT_TRUE(string_ne("abc", 3, "ab", 2));
+}
+
 TEST(Utils, Regexp) {
   ASSERT_TRUE(regexp_like("abc", 3, "abc", 3, '\\'));
   ASSERT_FALSE(regexp_like("abc", 3, "ABC", 3, '\\'));
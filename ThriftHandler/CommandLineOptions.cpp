@@ -50,23 +50,38 @@ bool g_enable_thrift_logs{false};
 
 extern bool g_use_table_device_offset;
 extern float g_fraction_code_cache_to_evict;
+extern bool g_enable_tiered_cpu_compilation;
+extern bool g_enable_concurrent_cpu_codegen;
+extern std::string g_disk_code_cache_dir;
+extern size_t g_disk_code_cache_max_size_in_bytes;
 extern bool g_cache_string_hash;
 extern bool g_enable_idp_temporary_users;
 extern bool g_enable_left_join_filter_hoisting;
 extern int64_t g_large_ndv_threshold;
 extern size_t g_large_ndv_multiplier;
 extern int64_t g_bitmap_memory_limit;
+extern bool g_enable_partitioned_count_distinct;
+extern size_t g_max_cpu_group_by_buffer_size;
 extern bool g_enable_seconds_refresh;
 extern bool g_enable_foreign_table_scheduled_refresh;
 extern size_t g_approx_quantile_buffer;
 extern size_t g_approx_quantile_centroids;
 extern size_t g_parallel_top_min;
 extern size_t g_parallel_top_max;
+extern bool g_enable_parallel_sort;
+extern size_t g_parallel_sort_max_buffer_size;
+extern bool g_enable_top_n_fragment_skipping;
 extern size_t g_streaming_topn_max;
 extern size_t g_estimator_failure_max_groupby_size;
 extern double g_ndv_groups_estimator_multiplier;
 extern bool g_columnar_large_projections;
 extern size_t g_columnar_large_projections_threshold;
+extern bool g_columnar_intermediate_projections;
+extern size_t g_columnar_intermediate_projections_threshold;
+extern bool g_enable_concurrent_subqueries;
+extern size_t g_max_concurrent_subqueries;
+extern bool g_enable_group_by_spill;
+extern size_t g_group_by_spill_partition_count;
 extern bool g_enable_system_tables;
 extern bool g_allow_system_dashboard_update;
 extern bool g_allow_memory_status_log;
@@ -305,6 +320,17 @@ void CommandLineOptions::fillOptions() {
                          ->default_value(g_use_chunk_metadata_cache)
                          ->implicit_value(true),
                      "Use chunk metadata cache.");
+  desc.add_options()("use-string-dict-translation-map-cache",
+                     po::value<bool>(&g_use_string_dict_translation_map_cache)
+                         ->default_value(g_use_string_dict_translation_map_cache)
+                         ->implicit_value(true),
+                     "Keep translation maps between string dictionaries across queries "
+                     "and extend them as the dictionaries grow.");
+  desc.add_options()("string-dict-translation-map-cache-total-bytes",
+                     po::value<size_t>(&g_string_dict_translation_map_cache_total_bytes)
+                         ->default_value(g_string_dict_translation_map_cache_total_bytes),
+                     "Size of total memory space for string dictionary translation map "
+                     "cache, in bytes (default: 1GB).");
   desc.add_options()(
       "hashtable-cache-total-bytes",
       po::value<size_t>(&hashtable_cache_total_bytes)
@@ -377,6 +403,26 @@ void CommandLineOptions::fillOptions() {
                      "Enable the bounding box intersect hash join framework to more "
                      "spatial join operators for pairs of geometry types corresponding "
                      "to many-to-many relationship.");
+  desc.add_options()("enable-radix-partitioned-hash-join-build",
+                     po::value<bool>(&g_enable_radix_partitioned_hash_join_build)
+                         ->default_value(g_enable_radix_partitioned_hash_join_build)
+                         ->implicit_value(true),
+                     "Partition the input of large CPU baseline join hash tables on "
+                     "their hash slots, so that threads fill cache-sized regions of the "
+                     "table one at a time.");
+  desc.add_options()(
+      "radix-partitioned-hash-join-build-threshold",
+      po::value<size_t>(&g_radix_partitioned_hash_join_build_threshold)
+          ->default_value(g_radix_partitioned_hash_join_build_threshold),
+      "Size in bytes of a CPU baseline join hash table above which its build is radix "
+      "partitioned. 0 uses the size of the last level cache.");
+  desc.add_options()("enable-incremental-join-hash-table-maintenance",
+                     po::value<bool>(&g_enable_incremental_join_hash_table_maintenance)
+                         ->default_value(g_enable_incremental_join_hash_table_maintenance)
+                         ->implicit_value(true),
+                     "Keep cached perfect join hash tables across appends to their build "
+                     "side table and extend them with the appended rows, rebuilding "
+                     "them only when the appended keys exceed their key range.");
   desc.add_options()("enable-distance-rangejoin",
                      po::value<bool>(&g_enable_distance_rangejoin)
                          ->default_value(g_enable_distance_rangejoin)
@@ -501,6 +547,13 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_hll_precision_bits)
           ->implicit_value(g_hll_precision_bits),
       "Number of bits used from the hash value used to specify the bucket number.");
+  desc.add_options()("enable-sparse-hll",
+                     po::value<bool>(&g_enable_sparse_hll)
+                         ->default_value(g_enable_sparse_hll)
+                         ->implicit_value(true),
+                     "Keep only the non-zero registers of the per group "
+                     "APPROX_COUNT_DISTINCT records on CPU, until there are too many of "
+                     "them.");
   if (!dist_v5_) {
     desc.add_options()("http-port",
                        po::value<int>(&http_port)->default_value(http_port),
@@ -520,6 +573,18 @@ void CommandLineOptions::fillOptions() {
                      "Enable/disable inner join fragment skipping. This feature is "
                      "considered stable and is enabled by default. This "
                      "parameter will be removed in a future release.");
+  desc.add_options()("enable-runtime-join-filters",
+                     po::value<bool>(&g_enable_runtime_join_filters)
+                         ->default_value(g_enable_runtime_join_filters)
+                         ->implicit_value(true),
+                     "Skip outer table fragments whose range of join key values lies "
+                     "outside the range of keys in the inner join hash table.");
+  desc.add_options()("enable-loop-join-fragment-alignment",
+                     po::value<bool>(&g_enable_loop_join_fragment_alignment)
+                         ->default_value(g_enable_loop_join_fragment_alignment)
+                         ->implicit_value(true),
+                     "Only join pairs of outer and inner table fragments whose ranges "
+                     "of join key values can satisfy the conditions of a loop join.");
   desc.add_options()(
       "max-session-duration",
       po::value<int>(&max_session_duration)->default_value(max_session_duration),
@@ -702,6 +767,20 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_enable_stringdict_parallel)
           ->implicit_value(true),
       "Allow StringDictionary to parallelize loads using multiple threads");
+  desc.add_options()(
+      "enable-stringdict-compression",
+      po::value<bool>(&g_enable_stringdict_compression)
+          ->default_value(g_enable_stringdict_compression)
+          ->implicit_value(true),
+      "Store the payload of newly created string dictionaries compressed with a "
+      "per-dictionary static symbol table. Existing dictionaries keep their format.");
+  desc.add_options()(
+      "stringdict-query-cache-size",
+      po::value<size_t>(&g_stringdict_query_cache_size)
+          ->default_value(g_stringdict_query_cache_size),
+      "Maximum size in bytes of the LIKE, REGEXP and equality results cached for all "
+      "the string dictionaries. Least recently used results are evicted beyond this "
+      "size.");
   desc.add_options()("log-user-id",
                      po::value<bool>(&Catalog_Namespace::g_log_user_id)
                          ->default_value(Catalog_Namespace::g_log_user_id)
@@ -814,6 +893,12 @@ void CommandLineOptions::fillDeveloperOptions() {
                          ->default_value(g_enable_lazy_fetch)
                          ->implicit_value(true),
                      "Enable lazy fetch columns in query results.");
+  desc.add_options()("enable-left-join-lazy-fetch",
+                     po::value<bool>(&g_enable_left_join_lazy_fetch)
+                         ->default_value(g_enable_left_join_lazy_fetch)
+                         ->implicit_value(true),
+                     "Enable lazy fetch in left join queries for the columns of the "
+                     "tables which are not the inner table of a left join.");
   desc.add_options()("enable-shared-mem-group-by",
                      po::value<bool>(&g_enable_smem_group_by)
                          ->default_value(g_enable_smem_group_by)
@@ -935,11 +1020,33 @@ void CommandLineOptions::fillDeveloperOptions() {
           ->default_value(g_enable_cpu_sub_tasks)
           ->implicit_value(true),
       "Enable parallel processing of a single data fragment on CPU. This can improve CPU "
-      "load balance and decrease reduction overhead.");
+      "load balance and decrease reduction overhead. Group by query steps then use all "
+      "CPU threads regardless of the number of fragments they touch.");
   desc.add_options()(
       "cpu-sub-task-size",
       po::value<size_t>(&g_cpu_sub_task_size)->default_value(g_cpu_sub_task_size),
-      "Set CPU sub-task size in rows.");
+      "Set the maximum CPU sub-task size in rows. Fragments are split into smaller "
+      "sub-tasks when there are too few to keep every CPU thread busy.");
+  desc.add_options()("parallel-reduction-min-entry-count",
+                     po::value<size_t>(&g_parallel_reduction_min_entry_count)
+                         ->default_value(g_parallel_reduction_min_entry_count),
+                     "Minimum total number of entries across the per-kernel results of "
+                     "a query step for them to be reduced with a parallel tree "
+                     "reduction rather than folded one at a time.");
+  desc.add_options()(
+      "enable-partitioned-baseline-reduction",
+      po::value<bool>(&g_enable_partitioned_baseline_reduction)
+          ->default_value(g_enable_partitioned_baseline_reduction)
+          ->implicit_value(true),
+      "Reduce the per-kernel results of high cardinality baseline hash group by "
+      "queries by partitioning their groups by hash range and reducing every partition "
+      "on its own thread.");
+  desc.add_options()(
+      "partitioned-baseline-reduction-min-entry-count",
+      po::value<size_t>(&g_partitioned_baseline_reduction_min_entry_count)
+          ->default_value(g_partitioned_baseline_reduction_min_entry_count),
+      "Minimum estimated number of groups of a baseline hash group by for its results to "
+      "be reduced by hash partition.");
   desc.add_options()(
       "cpu-threads",
       po::value<unsigned>(&g_cpu_threads_override)->default_value(g_cpu_threads_override),
@@ -1032,6 +1139,32 @@ void CommandLineOptions::fillDeveloperOptions() {
           ->default_value(g_fraction_code_cache_to_evict),
       "Percentage of the GPU code cache to evict if an out of memory error is "
       "encountered while attempting to place generated code on the GPU.");
+  desc.add_options()("enable-tiered-cpu-compilation",
+                     po::value<bool>(&g_enable_tiered_cpu_compilation)
+                         ->default_value(g_enable_tiered_cpu_compilation)
+                         ->implicit_value(true),
+                     "Compile CPU kernels with minimal optimization first and swap "
+                     "the fully optimized kernel into the code cache once it has been "
+                     "compiled in the background.");
+  desc.add_options()("enable-concurrent-cpu-codegen",
+                     po::value<bool>(&g_enable_concurrent_cpu_codegen)
+                         ->default_value(g_enable_concurrent_cpu_codegen)
+                         ->implicit_value(true),
+                     "Generate the machine code of independent CPU kernels (e.g. the "
+                     "kernels of concurrent subqueries) concurrently instead of one "
+                     "kernel at a time.");
+  desc.add_options()(
+      "disk-code-cache-dir",
+      po::value<std::string>(&g_disk_code_cache_dir)
+          ->default_value(g_disk_code_cache_dir),
+      "Directory to persist compiled CPU kernels in, so that they survive a restart of "
+      "the server. Entries of other builds are removed on first use. Empty disables "
+      "the disk code cache.");
+  desc.add_options()("disk-code-cache-max-size-in-bytes",
+                     po::value<size_t>(&g_disk_code_cache_max_size_in_bytes)
+                         ->default_value(g_disk_code_cache_max_size_in_bytes),
+                     "The maximum size of the disk code cache in bytes. The least "
+                     "recently used kernels are evicted first.");
 
   desc.add_options()("ssl-cert",
                      po::value<std::string>(&system_parameters.ssl_cert_file)
@@ -1123,6 +1256,21 @@ void CommandLineOptions::fillDeveloperOptions() {
       "size of the group by buffer (entry count in Query Memory Descriptor) and "
       "multiplying it by the number of count distinct expression and the size of bitmap "
       "required for each. For approx_count_distinct this is typically 8192 bytes.");
+  desc.add_options()("enable-partitioned-count-distinct",
+                     po::value<bool>(&g_enable_partitioned_count_distinct)
+                         ->default_value(g_enable_partitioned_count_distinct)
+                         ->implicit_value(true),
+                     "Compute exact COUNT(DISTINCT) as a group by on the group keys and "
+                     "the counted column followed by a COUNT, instead of keeping a set "
+                     "of values per group. Uses less memory with many groups.");
+  desc.add_options()(
+      "max-cpu-group-by-buffer-size",
+      po::value<size_t>(&g_max_cpu_group_by_buffer_size)
+          ->default_value(g_max_cpu_group_by_buffer_size),
+      "Limit in bytes for the group by buffer of a single CPU kernel, 0 for no limit. "
+      "Group by queries exceeding it are run in passes over hash partitions of their "
+      "groups if --enable-group-by-spill is set, and fail with an out of CPU memory "
+      "error otherwise.");
   desc.add_options()(
       "enable-filter-function",
       po::value<bool>(&g_enable_filter_function)
@@ -1130,6 +1278,20 @@ void CommandLineOptions::fillDeveloperOptions() {
           ->implicit_value(true),
       "Enable the filter function protection feature for the SQL JIT compiler. "
       "Normally should be on but techs might want to disable for troubleshooting.");
+  desc.add_options()(
+      "enable-predicated-aggregates",
+      po::value<bool>(&g_enable_predicated_aggregates)
+          ->default_value(g_enable_predicated_aggregates)
+          ->implicit_value(true),
+      "Update the aggregates of non-grouped CPU queries for every row, masking out the "
+      "rows which fail the filter instead of branching on it.");
+  desc.add_options()(
+      "predicated-aggregates-min-selectivity",
+      po::value<double>(&g_predicated_aggregates_min_selectivity)
+          ->default_value(g_predicated_aggregates_min_selectivity),
+      "Minimum expected fraction of rows passing the filter for which "
+      "--enable-predicated-aggregates applies. Filters without likelihood hints are "
+      "expected to pass half of the rows.");
   desc.add_options()(
       "enable-idp-temporary-users",
       po::value<bool>(&g_enable_idp_temporary_users)
@@ -1163,10 +1325,30 @@ void CommandLineOptions::fillDeveloperOptions() {
       po::value<size_t>(&g_parallel_top_max)->default_value(g_parallel_top_max),
       "For ResultSets requiring a heap sort, the maximum number of rows allowed by "
       "watchdog.");
+  desc.add_options()("enable-parallel-sort",
+                     po::value<bool>(&g_enable_parallel_sort)
+                         ->default_value(g_enable_parallel_sort)
+                         ->implicit_value(true),
+                     "Sort ResultSets ordered by numeric columns only, with no LIMIT, in "
+                     "parallel on normalized keys once they exceed parallel-top-min "
+                     "rows.");
+  desc.add_options()(
+      "parallel-sort-max-buffer-size",
+      po::value<size_t>(&g_parallel_sort_max_buffer_size)
+          ->default_value(g_parallel_sort_max_buffer_size),
+      "Limit in bytes for the sort keys and permutation buffers of a parallel sort. "
+      "Larger ResultSets are sorted without normalized keys.");
   desc.add_options()(
       "streaming-top-n-max",
       po::value<size_t>(&g_streaming_topn_max)->default_value(g_streaming_topn_max),
       "The maximum number of rows allowing streaming top-N sorting.");
+  desc.add_options()("enable-top-n-fragment-skipping",
+                     po::value<bool>(&g_enable_top_n_fragment_skipping)
+                         ->default_value(g_enable_top_n_fragment_skipping)
+                         ->implicit_value(true),
+                     "Skip the fragments of top-N projections whose metadata shows that "
+                     "none of their rows can beat the top-N rows found so far on the "
+                     "first ORDER BY key.");
   desc.add_options()("vacuum-min-selectivity",
                      po::value<float>(&g_vacuum_min_selectivity)
                          ->default_value(g_vacuum_min_selectivity),
@@ -1211,6 +1393,43 @@ void CommandLineOptions::fillDeveloperOptions() {
           ->default_value(g_columnar_large_projections_threshold),
       "Threshold (in minimum number of rows) to prefer columnar output for projections. "
       "Requires --columnar-large-projections to be set.");
+  desc.add_options()("columnar-intermediate-projections",
+                     po::value<bool>(&g_columnar_intermediate_projections)
+                         ->default_value(g_columnar_intermediate_projections)
+                         ->implicit_value(true),
+                     "Prefer columnar output for projection steps whose result is "
+                     "consumed by a later step of the same query and whose size is >= "
+                     "threshold set by --columnar-intermediate-projections-threshold.");
+  desc.add_options()(
+      "columnar-intermediate-projections-threshold",
+      po::value<size_t>(&g_columnar_intermediate_projections_threshold)
+          ->default_value(g_columnar_intermediate_projections_threshold),
+      "Threshold (in minimum number of rows) to prefer columnar output for intermediate "
+      "projections. Requires --columnar-intermediate-projections to be set.");
+  desc.add_options()("enable-concurrent-subqueries",
+                     po::value<bool>(&g_enable_concurrent_subqueries)
+                         ->default_value(g_enable_concurrent_subqueries)
+                         ->implicit_value(true),
+                     "Execute uncorrelated subqueries which do not depend on each other "
+                     "concurrently.");
+  desc.add_options()(
+      "max-concurrent-subqueries",
+      po::value<size_t>(&g_max_concurrent_subqueries)
+          ->default_value(g_max_concurrent_subqueries),
+      "Maximum number of subqueries of a query executed concurrently. Requires "
+      "--enable-concurrent-subqueries to be set.");
+
+  desc.add_options()(
+      "enable-group-by-spill",
+      po::value<bool>(&g_enable_group_by_spill)
+          ->default_value(g_enable_group_by_spill)
+          ->implicit_value(true),
+      "Retry group by queries which run out of CPU memory one set of hash partitions "
+      "of their groups at a time, keeping only the groups found by every pass.");
+  desc.add_options()("group-by-spill-partition-count",
+                     po::value<size_t>(&g_group_by_spill_partition_count)
+                         ->default_value(g_group_by_spill_partition_count),
+                     "Number of partitions a spilled group by query is split into.");
 
   desc.add_options()(
       "allow-memory-status-log",
@@ -1924,6 +2143,14 @@ boost::optional<int> CommandLineOptions::parse_command_line(
       BoundingBoxIntersectJoinHashTable::getHashTableCache()->setMaxCacheItemSize(
           CacheItemType::BBOX_INTERSECT_HT, g_max_cacheable_hashtable_size_bytes);
     }
+    if (g_use_string_dict_translation_map_cache) {
+      Executor::getStringDictTranslationMapCache()->setTotalCacheSize(
+          CacheItemType::STRING_DICT_TRANSLATION_MAP,
+          g_string_dict_translation_map_cache_total_bytes);
+      Executor::getStringDictTranslationMapCache()->setMaxCacheItemSize(
+          CacheItemType::STRING_DICT_TRANSLATION_MAP,
+          g_string_dict_translation_map_cache_total_bytes);
+    }
     g_optimize_cuda_block_and_grid_sizes = optimize_cuda_block_and_grid_sizes;
   } catch (po::error& e) {
     std::cerr << "Usage Error: " << e.what() << std::endl;
@@ -2086,6 +2313,13 @@ boost::optional<int> CommandLineOptions::parse_command_line(
       LOG(INFO) << " \t\t Per-hashtable size limit: "
                 << g_max_cacheable_hashtable_size_bytes / (1024 * 1024) << " MB.";
     }
+    LOG(INFO) << " \t Use string dictionary translation map cache: "
+              << (g_use_string_dict_translation_map_cache ? "enabled" : "disabled");
+    if (g_use_string_dict_translation_map_cache) {
+      LOG(INFO) << " \t\t Total amount of bytes that translation map cache keeps: "
+                << g_string_dict_translation_map_cache_total_bytes / (1024 * 1024)
+                << " MB.";
+    }
     LOG(INFO) << " \t Use query resultset cache: "
               << (g_use_query_resultset_cache ? "enabled" : "disabled");
     if (g_use_query_resultset_cache) {
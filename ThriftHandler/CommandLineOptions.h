@@ -204,6 +204,8 @@ extern bool g_executor_resource_mgr_allow_cpu_result_mem_oversubscription_concur
 extern double g_executor_resource_mgr_max_available_resource_use_ratio;
 
 extern bool g_inner_join_fragment_skipping;
+extern bool g_enable_runtime_join_filters;
+extern bool g_enable_loop_join_fragment_alignment;
 extern float g_filter_push_down_low_frac;
 extern float g_filter_push_down_high_frac;
 extern size_t g_filter_push_down_passing_row_ubound;
@@ -213,6 +215,9 @@ extern bool g_enable_bbox_intersect_hashjoin;
 extern size_t g_num_tuple_threshold_switch_to_baseline;
 extern size_t g_ratio_num_hash_entry_to_num_tuple_switch_to_baseline;
 extern bool g_enable_hashjoin_many_to_many;
+extern bool g_enable_radix_partitioned_hash_join_build;
+extern bool g_enable_incremental_join_hash_table_maintenance;
+extern size_t g_radix_partitioned_hash_join_build_threshold;
 extern bool g_enable_distance_rangejoin;
 extern size_t g_bbox_intersect_max_table_size_bytes;
 extern double g_bbox_intersect_target_entries_per_bin;
@@ -242,6 +247,7 @@ extern bool g_enable_smem_non_grouped_agg;
 extern bool g_enable_smem_grouped_non_count_agg;
 extern bool g_use_estimator_result_cache;
 extern bool g_enable_lazy_fetch;
+extern bool g_enable_left_join_lazy_fetch;
 
 extern int64_t g_omni_kafka_seek;
 extern size_t g_leaf_count;
@@ -263,8 +269,13 @@ extern bool g_enable_interop;
 extern bool g_enable_union;
 extern bool g_enable_cpu_sub_tasks;
 extern size_t g_cpu_sub_task_size;
+extern size_t g_parallel_reduction_min_entry_count;
+extern bool g_enable_partitioned_baseline_reduction;
+extern size_t g_partitioned_baseline_reduction_min_entry_count;
 extern unsigned g_cpu_threads_override;
 extern bool g_enable_filter_function;
+extern bool g_enable_predicated_aggregates;
+extern double g_predicated_aggregates_min_selectivity;
 extern size_t g_max_import_threads;
 extern bool g_enable_auto_metadata_update;
 extern bool g_allow_s3_server_privileges;
@@ -286,6 +297,8 @@ extern bool g_use_query_resultset_cache;
 extern size_t g_query_resultset_cache_total_bytes;
 extern size_t g_max_cacheable_query_resultset_size_bytes;
 extern bool g_use_chunk_metadata_cache;
+extern bool g_use_string_dict_translation_map_cache;
+extern size_t g_string_dict_translation_map_cache_total_bytes;
 extern bool g_allow_auto_resultset_caching;
 extern size_t g_auto_resultset_caching_threshold;
 extern bool g_allow_query_step_skipping;
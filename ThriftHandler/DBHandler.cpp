@@ -3207,6 +3207,14 @@ void log_cache_size(const Catalog_Namespace::Catalog& cat) {
                                          DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
   oss << "\"chunk_metadata\": " << chunk_metadata_cache_size << " bytes, ";
 
+  // 1.d String Dictionary Translation Map Recycler
+  auto string_dict_translation_map_cache_size =
+      Executor::getStringDictTranslationMapCache()->getCurrentCacheSizeForDevice(
+          CacheItemType::STRING_DICT_TRANSLATION_MAP,
+          STRING_DICT_TRANSLATION_MAP_CACHE_DEVICE_IDENTIFIER);
+  oss << "\"string_dict_translation_maps\": " << string_dict_translation_map_cache_size
+      << " bytes, ";
+
   // 2. Query Plan Dag
   auto query_plan_dag_cache_size =
       executor->getQueryPlanDagCache().getCurrentNodeMapSize();
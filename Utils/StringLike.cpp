@@ -23,6 +23,10 @@
 
 #include "StringLike.h"
 
+#ifndef __CUDACC__
+#include <cstring>
+#endif
+
 enum LikeStatus {
   kLIKE_TRUE,
   kLIKE_FALSE,
@@ -38,6 +42,51 @@ DEVICE static int inline lowercase(char c) {
   return c;
 }
 
+// On the CPU the byte scans below go through the C library, whose memchr and memcmp are
+// vectorized for the host (SSE2 / AVX2 on x86-64)
+DEVICE static inline int32_t find_byte(const char* str,
+                                       const int32_t str_len,
+                                       const char c) {
+#ifdef __CUDACC__
+  for (int32_t i = 0; i < str_len; ++i) {
+    if (str[i] == c) {
+      return i;
+    }
+  }
+  return -1;
+#else
+  const auto found = static_cast<const char*>(memchr(str, c, str_len));
+  return found ? found - str : -1;
+#endif
+}
+
+DEVICE static inline bool bytes_equal(const char* lhs,
+                                      const char* rhs,
+                                      const int32_t len) {
+#ifdef __CUDACC__
+  for (int32_t i = 0; i < len; ++i) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+#else
+  return memcmp(lhs, rhs, len) == 0;
+#endif
+}
+
+// pattern is assumed to be already converted to all lowercase
+DEVICE static inline bool bytes_equal_lowercase(const char* str,
+                                                const char* pattern,
+                                                const int32_t len) {
+  for (int32_t i = 0; i < len; ++i) {
+    if (lowercase(str[i]) != pattern[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // escape_char does nothing, it's a placeholder to fit # arguments for both
 // string_like and string_like_simple functions
 extern "C" RUNTIME_EXPORT DEVICE bool string_like_simple(const char* str,
@@ -45,14 +94,22 @@ extern "C" RUNTIME_EXPORT DEVICE bool string_like_simple(const char* str,
                                                          const char* pattern,
                                                          const int32_t pat_len,
                                                          char escape_char) {
-  int i, j;
-  int search_len = str_len - pat_len + 1;
-  for (i = 0; i < search_len; ++i) {
-    for (j = 0; j < pat_len && pattern[j] == str[j + i]; ++j) {
+  if (pat_len <= 0) {
+    return str_len >= 0;
+  }
+  // Jump between occurrences of the first pattern byte instead of trying every offset
+  const int32_t search_len = str_len - pat_len + 1;
+  int32_t i = 0;
+  while (i < search_len) {
+    const int32_t next = find_byte(str + i, search_len - i, pattern[0]);
+    if (next < 0) {
+      return false;
     }
-    if (j >= pat_len) {
+    i += next;
+    if (bytes_equal(str + i + 1, pattern + 1, pat_len - 1)) {
       return true;
     }
+    ++i;
   }
   return false;
 }
@@ -88,8 +145,66 @@ extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_simple(const char* str,
     return base_func(lhs, lhs_len, rhs, rhs_len, escape_char) ? 1 : 0;                   \
   }
 
+// Anchored patterns, i.e. 'abc%', '%abc' and 'abc', are matched by the codegen against
+// the pattern's literal text with the wildcards and escape characters removed, so
+// escape_char does nothing here either
+extern "C" RUNTIME_EXPORT DEVICE bool string_like_prefix(const char* str,
+                                                         const int32_t str_len,
+                                                         const char* pattern,
+                                                         const int32_t pat_len,
+                                                         char escape_char) {
+  return str_len >= pat_len && bytes_equal(str, pattern, pat_len);
+}
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_prefix(const char* str,
+                                                          const int32_t str_len,
+                                                          const char* pattern,
+                                                          const int32_t pat_len,
+                                                          char escape_char) {
+  return str_len >= pat_len && bytes_equal_lowercase(str, pattern, pat_len);
+}
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_like_suffix(const char* str,
+                                                         const int32_t str_len,
+                                                         const char* pattern,
+                                                         const int32_t pat_len,
+                                                         char escape_char) {
+  return str_len >= pat_len && bytes_equal(str + str_len - pat_len, pattern, pat_len);
+}
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_suffix(const char* str,
+                                                          const int32_t str_len,
+                                                          const char* pattern,
+                                                          const int32_t pat_len,
+                                                          char escape_char) {
+  return str_len >= pat_len &&
+         bytes_equal_lowercase(str + str_len - pat_len, pattern, pat_len);
+}
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_like_exact(const char* str,
+                                                        const int32_t str_len,
+                                                        const char* pattern,
+                                                        const int32_t pat_len,
+                                                        char escape_char) {
+  return str_len == pat_len && bytes_equal(str, pattern, pat_len);
+}
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_exact(const char* str,
+                                                         const int32_t str_len,
+                                                         const char* pattern,
+                                                         const int32_t pat_len,
+                                                         char escape_char) {
+  return str_len == pat_len && bytes_equal_lowercase(str, pattern, pat_len);
+}
+
 STR_LIKE_SIMPLE_NULLABLE(string_like_simple)
 STR_LIKE_SIMPLE_NULLABLE(string_ilike_simple)
+STR_LIKE_SIMPLE_NULLABLE(string_like_prefix)
+STR_LIKE_SIMPLE_NULLABLE(string_ilike_prefix)
+STR_LIKE_SIMPLE_NULLABLE(string_like_suffix)
+STR_LIKE_SIMPLE_NULLABLE(string_ilike_suffix)
+STR_LIKE_SIMPLE_NULLABLE(string_like_exact)
+STR_LIKE_SIMPLE_NULLABLE(string_ilike_exact)
 
 #undef STR_LIKE_SIMPLE_NULLABLE
 
@@ -337,6 +452,9 @@ extern "C" RUNTIME_EXPORT DEVICE bool string_eq(const char* lhs,
                                                 const int32_t lhs_len,
                                                 const char* rhs,
                                                 const int32_t rhs_len) {
+  if (lhs_len == rhs_len) {
+    return bytes_equal(lhs, rhs, lhs_len);
+  }
   return StringCompare(lhs, lhs_len, rhs, rhs_len) == 0;
 }
 
@@ -344,7 +462,7 @@ extern "C" RUNTIME_EXPORT DEVICE bool string_ne(const char* lhs,
                                                 const int32_t lhs_len,
                                                 const char* rhs,
                                                 const int32_t rhs_len) {
-  return StringCompare(lhs, lhs_len, rhs, rhs_len) != 0;
+  return !string_eq(lhs, lhs_len, rhs, rhs_len);
 }
 
 #define STR_CMP_NULLABLE(base_func)                                                      \
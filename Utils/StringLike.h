@@ -64,6 +64,42 @@ extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_simple(const char* str,
                                                           const int32_t pat_len,
                                                           char escape_char);
 
+extern "C" RUNTIME_EXPORT DEVICE bool string_like_prefix(const char* str,
+                                                         const int32_t str_len,
+                                                         const char* pattern,
+                                                         const int32_t pat_len,
+                                                         char escape_char);
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_prefix(const char* str,
+                                                          const int32_t str_len,
+                                                          const char* pattern,
+                                                          const int32_t pat_len,
+                                                          char escape_char);
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_like_suffix(const char* str,
+                                                         const int32_t str_len,
+                                                         const char* pattern,
+                                                         const int32_t pat_len,
+                                                         char escape_char);
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_suffix(const char* str,
+                                                          const int32_t str_len,
+                                                          const char* pattern,
+                                                          const int32_t pat_len,
+                                                          char escape_char);
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_like_exact(const char* str,
+                                                        const int32_t str_len,
+                                                        const char* pattern,
+                                                        const int32_t pat_len,
+                                                        char escape_char);
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_exact(const char* str,
+                                                         const int32_t str_len,
+                                                         const char* pattern,
+                                                         const int32_t pat_len,
+                                                         char escape_char);
+
 extern "C" RUNTIME_EXPORT DEVICE bool string_lt(const char* lhs,
                                                 const int32_t lhs_len,
                                                 const char* rhs,